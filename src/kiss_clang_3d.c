@@ -1,304 +1,337 @@
 #include "kiss_clang_3d.h"
 
+#include <assert.h>
+#include <string.h>
+
+#if defined(__F16C__)
+  #include <immintrin.h>
+#endif
+
+// the default of a switch that cannot be reached; checked in debug builds
+#if defined(__GNUC__) || defined(__clang__)
+  #define KISS_UNREACHABLE() do { assert(false); __builtin_unreachable(); } while (0)
+#elif defined(_MSC_VER)
+  #define KISS_UNREACHABLE() do { assert(false); __assume(0); } while (0)
+#else
+  #define KISS_UNREACHABLE() assert(false)
+#endif
+
 // for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
 
 // ------------------------------------------------------------
-// DEFINITIONS
+// PRECISION INDEPENDENT DEFINITIONS
 // ------------------------------------------------------------
 
-// ---------------------------------------------
-// Vec3 functions
-// ---------------------------------------------
-
-void vec3_setter(Vec3 * v, F_TYPE vi, F_TYPE vj, F_TYPE vk){
-    v->i = vi;
-    v->j = vj;
-    v->k = vk;
-}
-
-void vec3_copy(Vec3 const * v_in, Vec3 * v_out){
-    v_out->i = v_in->i;
-    v_out->j = v_in->j;
-    v_out->k = v_in->k;
-}
-
-bool vec3_is_null(Vec3 const * v1, F_TYPE tolerance){
+// the views only ever hold one of these component types, so that the switches on the
+// component type in the view accessors never reach their default
+static bool is_valid_component_type(char component_type){
     return(
-        F_TYPE_ABS(v1->i) <= tolerance &&
-        F_TYPE_ABS(v1->j) <= tolerance &&
-        F_TYPE_ABS(v1->k) <= tolerance
+        component_type == 'F' ||
+        component_type == 'D' ||
+        component_type == 'H' ||
+        component_type == 'B'
     );
 }
 
-bool vec3_equal(Vec3 const * v1, Vec3 const * v2, F_TYPE tolerance){
-    return(
-        F_TYPE_ABS(v1->i - v2->i) <= tolerance &&
-        F_TYPE_ABS(v1->j - v2->j) <= tolerance &&
-        F_TYPE_ABS(v1->k - v2->k) <= tolerance
-    );
-}
+bool vec3_view_setter(Vec3_View * view, void * base, size_t stride, size_t count, size_t offset_i, size_t offset_j, size_t offset_k, char component_type){
+    bool const valid = is_valid_component_type(component_type);
 
-F_TYPE vec3_norm_square(Vec3 const * v){
-    return (
-            (v->i * v->i) + (v->j * v->j) + (v->k * v->k)
-    );
-}
+    view->base = base;
+    view->stride = stride;
+    view->count = valid ? count : 0;
+    view->offset_i = offset_i;
+    view->offset_j = offset_j;
+    view->offset_k = offset_k;
+    view->component_type = valid ? component_type : 'F';
 
-F_TYPE vec3_norm(Vec3 const * v){
-    return (
-        F_TYPE_SQRT(
-                (v->i * v->i) + (v->j * v->j) + (v->k * v->k)
-        )
-    );
+    return valid;
 }
 
-void vec3_scale(Vec3 * v, F_TYPE scale){
-    v->i *= scale;
-    v->j *= scale;
-    v->k *= scale;
-}
+bool quat_view_setter(Quat_View * view, void * base, size_t stride, size_t count, size_t offset_r, size_t offset_i, size_t offset_j, size_t offset_k, char component_type){
+    bool const valid = is_valid_component_type(component_type);
 
-void vec3_add(Vec3 * v_acc, Vec3 const * v_add){
-    v_acc->i += v_add->i;
-    v_acc->j += v_add->j;
-    v_acc->k += v_add->k;
-}
+    view->base = base;
+    view->stride = stride;
+    view->count = valid ? count : 0;
+    view->offset_r = offset_r;
+    view->offset_i = offset_i;
+    view->offset_j = offset_j;
+    view->offset_k = offset_k;
+    view->component_type = valid ? component_type : 'F';
 
-void vec3_sub(Vec3 * v_acc, Vec3 const * v_sub){
-    v_acc->i -= v_sub->i;
-    v_acc->j -= v_sub->j;
-    v_acc->k -= v_sub->k;
+    return valid;
 }
 
-F_TYPE vec3_scalar(Vec3 const * v1, Vec3 const * v2){
-    return(
-        v1->i * v2->i +
-        v1->j * v2->j +
-        v1->k * v2->k
+void vec3_view_slice(Vec3_View const * view, size_t first, size_t count, Vec3_View * slice){
+    first = first < view->count ? first : view->count;
+    count = count < view->count - first ? count : view->count - first;
+    vec3_view_setter(
+        slice, KISS_CAST(unsigned char *, view->base) + first * view->stride, view->stride, count,
+        view->offset_i, view->offset_j, view->offset_k,
+        view->component_type
     );
 }
 
-void vec3_cross(Vec3 const * v1, Vec3 const * v2, Vec3 * v_res){
-    v_res->i =  v1->j * v2->k - v1->k * v2->j;
-    v_res->j = -v1->i * v2->k + v1->k * v2->i;
-    v_res->k =  v1->i * v2->j - v1->j * v2->i;
-}
-
-bool vec3_normalize(Vec3 * v){
-    if (vec3_is_null(v)){
-        return false;
-    }
-    else{
-        F_TYPE norm = vec3_norm(v);
-        vec3_scale(v, F_TYPE_1 / norm);
-        return true;
-    }
-}
-
-bool vec3_colinear(Vec3 const * v, Vec3 const * w, F_TYPE tolerance){
-    Vec3 result_cross_product;
-    vec3_cross(v, w, &result_cross_product);
-    return vec3_is_null(&result_cross_product, tolerance);
-}
-
-// ---------------------------------------------
-// Quat functions
-// ---------------------------------------------
-
-void quat_setter(Quat * q, F_TYPE qr, F_TYPE qi, F_TYPE qj, F_TYPE qk){
-    q->r = qr;
-    q->i = qi;
-    q->j = qj;
-    q->k = qk;
-}
-
-void quat_copy(Quat const * q_in, Quat * q_out){
-    q_out->r = q_in->r;
-    q_out->i = q_in->i;
-    q_out->j = q_in->j;
-    q_out->k = q_in->k;
-}
-
-F_TYPE quat_norm(Quat const * q){
-    return(
-        F_TYPE_SQRT(
-            q->r * q->r + q->i * q->i + q->j * q->j + q->k * q->k
-        )
+void quat_view_slice(Quat_View const * view, size_t first, size_t count, Quat_View * slice){
+    first = first < view->count ? first : view->count;
+    count = count < view->count - first ? count : view->count - first;
+    quat_view_setter(
+        slice, KISS_CAST(unsigned char *, view->base) + first * view->stride, view->stride, count,
+        view->offset_r, view->offset_i, view->offset_j, view->offset_k,
+        view->component_type
     );
 }
 
-F_TYPE quat_norm_square(Quat const * q){
-    return(
-        q->r * q->r + q->i * q->i + q->j * q->j + q->k * q->k
+void vec3_view_of_half_array(Vec3_View * view, Vec3_Half * array, size_t count){
+    vec3_view_setter(
+        view, array, sizeof(Vec3_Half), count,
+        offsetof(Vec3_Half, i), offsetof(Vec3_Half, j), offsetof(Vec3_Half, k),
+        'H'
     );
 }
 
-bool quat_equal(Quat const * q_1, Quat const * q_2, F_TYPE tolerance){
-    return(
-        F_TYPE_ABS(q_1->r - q_2->r) <= tolerance &&
-        F_TYPE_ABS(q_1->i - q_2->i) <= tolerance &&
-        F_TYPE_ABS(q_1->j - q_2->j) <= tolerance &&
-        F_TYPE_ABS(q_1->k - q_2->k) <= tolerance
+void vec3_view_of_bf16_array(Vec3_View * view, Vec3_BF16 * array, size_t count){
+    vec3_view_setter(
+        view, array, sizeof(Vec3_BF16), count,
+        offsetof(Vec3_BF16, i), offsetof(Vec3_BF16, j), offsetof(Vec3_BF16, k),
+        'B'
     );
 }
 
-void quat_conj(Quat * q){
-    q->i = -q->i;
-    q->j = -q->j;
-    q->k = -q->k;
+size_t vec3_oct_code_size(unsigned bits_per_component){
+    return (2 * bits_per_component + 7) / 8;
 }
 
-bool quat_is_unitary(Quat const * q, F_TYPE tolerance){
-    return(
-        F_TYPE_ABS(quat_norm_square(q) - F_TYPE_1) < tolerance
-    );
+static uint32_t float_bits(float value){
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(float));
+    return bits;
 }
 
-void quat_prod(Quat const * q_left, Quat const * q_right, Quat * q_result){
-    q_result->r = q_left->r * q_right->r  -  q_left->i * q_right->i  -  q_left->j * q_right->j  -  q_left->k * q_right->k;
-    q_result->i = q_left->r * q_right->i  +  q_left->i * q_right->r  +  q_left->j * q_right->k  -  q_left->k * q_right->j;
-    q_result->j = q_left->r * q_right->j  -  q_left->i * q_right->k  +  q_left->j * q_right->r  +  q_left->k * q_right->i;
-    q_result->k = q_left->r * q_right->k  +  q_left->i * q_right->j  -  q_left->j * q_right->i  +  q_left->k * q_right->r;
+static float float_from_bits(uint32_t bits){
+    float value;
+    memcpy(&value, &bits, sizeof(float));
+    return value;
 }
 
-void quat_add(Quat * q_acc, Quat const * q_add){
-    q_acc->r += q_add->r;
-    q_acc->i += q_add->i;
-    q_acc->j += q_add->j;
-    q_acc->k += q_add->k;
-}
+// see "float_to_half_fast3_rtne" and "half_to_float" by F. Giesen,
+// https://gist.github.com/rygorous/2156668
+uint16_t float_to_half(float value){
+    uint32_t const f32_infinity = 255u << 23;
+    uint32_t const f16_max = (127u + 16u) << 23;
+    uint32_t const denormal_magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
 
-void quat_sub(Quat * q_acc, Quat const * q_sub){
-    q_acc->r -= q_sub->r;
-    q_acc->i -= q_sub->i;
-    q_acc->j -= q_sub->j;
-    q_acc->k -= q_sub->k;
-}
+    uint32_t bits = float_bits(value);
+    uint32_t sign = bits & 0x80000000u;
+    uint32_t half;
 
-bool quat_inv(Quat * q, F_TYPE tolerance){
-    F_TYPE norm_square = quat_norm_square(q);
+    bits ^= sign;
 
-    if (norm_square < tolerance){
-        return false;
+    if (bits >= f16_max){
+        // overflow to infinity, or NaN (made quiet)
+        half = bits > f32_infinity ? 0x7E00u : 0x7C00u;
+    }
+    else if (bits < (113u << 23)){
+        // half subnormal or zero: the float addition of the magic value aligns the
+        // 10 bits of mantissa at the bottom, with round to nearest even
+        half = float_bits(float_from_bits(bits) + float_from_bits(denormal_magic)) - denormal_magic;
     }
     else{
-        q->r /= norm_square;
-        q->i = -q->i / norm_square;
-        q->j = -q->j / norm_square;
-        q->k = -q->k / norm_square;
-
-        return true;
+        // normal: rebias the exponent, and round to nearest even
+        uint32_t mantissa_odd = (bits >> 13) & 1u;
+        bits += ((15u - 127u) << 23) + 0xFFFu;
+        bits += mantissa_odd;
+        half = bits >> 13;
     }
+
+    return KISS_CAST(uint16_t, half | (sign >> 16));
 }
 
-// ---------------------------------------------
-// Quat and VECT functions
-// --------------------------------------------
+float half_to_float(uint16_t value){
+    uint32_t const magic = 113u << 23;
+    uint32_t const shifted_exponent = 0x7C00u << 13;
 
-bool quat_to_vec3(Quat const * q, Vec3 * v_out, F_TYPE tolerance){
-    v_out->i = q->i;
-    v_out->j = q->j;
-    v_out->k = q->k;
+    uint32_t bits = (value & 0x7FFFu) << 13;
+    uint32_t exponent = bits & shifted_exponent;
+    bits += (127u - 15u) << 23;
 
-    if (F_TYPE_ABS(q->r) > tolerance){
-        return false;
+    if (exponent == shifted_exponent){
+        // infinity or NaN
+        bits += (128u - 16u) << 23;
     }
-    else{
-        return true;
+    else if (exponent == 0){
+        // zero or subnormal: renormalize
+        bits += 1u << 23;
+        bits = float_bits(float_from_bits(bits) - float_from_bits(magic));
     }
-}
 
-void vec3_to_quat(Vec3 const * v, Quat * q_out){
-    q_out->r = F_TYPE_0;
-    q_out->i = v->i;
-    q_out->j = v->j;
-    q_out->k = v->k;
+    bits |= (value & 0x8000u) << 16;
+    return float_from_bits(bits);
 }
 
-bool rotation_to_quat(Quat * q, Vec3 const * rotation_axis, F_TYPE const rotation_angle_rad, F_TYPE tolerance){
-    if (vec3_is_null(rotation_axis)){
-        if (F_TYPE_ABS(rotation_angle_rad) <= tolerance){
-            q->r = F_TYPE_1;
-            q->i = F_TYPE_0;
-            q->j = F_TYPE_0;
-            q->k = F_TYPE_0;
+uint16_t float_to_bf16(float value){
+    uint32_t bits = float_bits(value);
 
-            return true;
-        }
-        else{
-            return false;
-        }
+    if ((bits & 0x7FFFFFFFu) > 0x7F800000u){
+        // NaN: keep it a (quiet) NaN, rounding could turn it into an infinity
+        return KISS_CAST(uint16_t, (bits >> 16) | 0x0040u);
     }
 
-    F_TYPE half_rotation_angle = rotation_angle_rad / F_TYPE_2;
-    F_TYPE cos_of_half = F_TYPE_COS(half_rotation_angle);
-    F_TYPE sin_of_half = F_TYPE_SIN(half_rotation_angle);
-    F_TYPE norm_of_axis = vec3_norm(rotation_axis);
-
-    q->r = cos_of_half;
-    q->i = rotation_axis->i / norm_of_axis * sin_of_half;
-    q->j = rotation_axis->j / norm_of_axis * sin_of_half;
-    q->k = rotation_axis->k / norm_of_axis * sin_of_half;
+    uint32_t rounding_bias = 0x7FFFu + ((bits >> 16) & 1u);
+    return KISS_CAST(uint16_t, (bits + rounding_bias) >> 16);
+}
 
-    return true;
+float bf16_to_float(uint16_t value){
+    return float_from_bits(KISS_CAST(uint32_t, value) << 16);
 }
 
-bool quat_to_rotation(Vec3 * rotation_axis, F_TYPE * rotation_angle_rad, Quat const * q_rotation, F_TYPE tolerance){
-    if (!quat_is_unitary(q_rotation, tolerance)){
-        return false;
+void float_array_to_half(float const * values_in, uint16_t * values_out, size_t count){
+    size_t n = 0;
+
+#if defined(__F16C__)
+    for (; n + 8 <= count; n += 8){
+        __m256 values_as_float = _mm256_loadu_ps(values_in + n);
+        __m128i values_as_half = _mm256_cvtps_ph(values_as_float, _MM_FROUND_TO_NEAREST_INT);
+        memcpy(values_out + n, &values_as_half, sizeof(values_as_half));
     }
-    else{
-        *rotation_angle_rad = F_TYPE_2 * F_TYPE_ACOS(q_rotation->r);
-        F_TYPE sin_half_angle = F_TYPE_SQRT(F_TYPE_1 - q_rotation->r * q_rotation->r);
-        rotation_axis->i = q_rotation->i / sin_half_angle;
-        rotation_axis->j = q_rotation->j / sin_half_angle;
-        rotation_axis->k = q_rotation->k / sin_half_angle;
+#endif
 
-        return true;
+    for (; n < count; n++){
+        values_out[n] = float_to_half(values_in[n]);
     }
 }
 
-// the naive way, applying the definition; this is quite inefficient though
-bool rotate_by_quat(Vec3 * v, Quat const * q, F_TYPE tolerance){
-    if (!quat_is_unitary(q)){
-        return false;
+void half_array_to_float(uint16_t const * values_in, float * values_out, size_t count){
+    size_t n = 0;
+
+#if defined(__F16C__)
+    for (; n + 8 <= count; n += 8){
+        __m128i values_as_half;
+        memcpy(&values_as_half, values_in + n, sizeof(values_as_half));
+        _mm256_storeu_ps(values_out + n, _mm256_cvtph_ps(values_as_half));
     }
+#endif
 
-    Quat q_1;
-    Quat q_2;
-    Quat q_3;
+    for (; n < count; n++){
+        values_out[n] = half_to_float(values_in[n]);
+    }
+}
 
-    // q_1 is the Quat out of v
-    vec3_to_quat(v, &q_1);
+void float_array_to_bf16(float const * values_in, uint16_t * values_out, size_t count){
+    for (size_t n = 0; n < count; n++){
+        values_out[n] = float_to_bf16(values_in[n]);
+    }
+}
 
-    // q_2 is the rotation Quat conjugate
-    quat_copy(q, &q_2);
-    quat_conj(&q_2);
+void bf16_array_to_float(uint16_t const * values_in, float * values_out, size_t count){
+    for (size_t n = 0; n < count; n++){
+        values_out[n] = bf16_to_float(values_in[n]);
+    }
+}
 
-    // q_3 contains the right part of the product
-    quat_prod(&q_1, &q_2, &q_3);
+// the rotations of the octahedral group: all the signed permutations of determinant +1
+static Octahedral_Rotation const octahedral_group[OCTAHEDRAL_GROUP_SIZE] {
+    {{0, 1, 2}, {false, false, false}},
+    {{0, 1, 2}, {true, true, false}},
+    {{0, 1, 2}, {true, false, true}},
+    {{0, 1, 2}, {false, true, true}},
+    {{0, 2, 1}, {true, false, false}},
+    {{0, 2, 1}, {false, true, false}},
+    {{0, 2, 1}, {false, false, true}},
+    {{0, 2, 1}, {true, true, true}},
+    {{1, 0, 2}, {true, false, false}},
+    {{1, 0, 2}, {false, true, false}},
+    {{1, 0, 2}, {false, false, true}},
+    {{1, 0, 2}, {true, true, true}},
+    {{1, 2, 0}, {false, false, false}},
+    {{1, 2, 0}, {true, true, false}},
+    {{1, 2, 0}, {true, false, true}},
+    {{1, 2, 0}, {false, true, true}},
+    {{2, 0, 1}, {false, false, false}},
+    {{2, 0, 1}, {true, true, false}},
+    {{2, 0, 1}, {true, false, true}},
+    {{2, 0, 1}, {false, true, true}},
+    {{2, 1, 0}, {true, false, false}},
+    {{2, 1, 0}, {false, true, false}},
+    {{2, 1, 0}, {false, false, true}},
+    {{2, 1, 0}, {true, true, true}}
+};
+
+bool octahedral_rotation_of_index(Octahedral_Rotation * rotation, unsigned index){
+    if (index >= OCTAHEDRAL_GROUP_SIZE){
+        return false;
+    }
 
-    // q_2 is the rotation quat
-    quat_conj(&q_2);
+    *rotation = octahedral_group[index];
+    return true;
+}
 
-    // q_1 contains the full quaternion
-    quat_prod(&q_2, &q_3, &q_1);
+static size_t min_count(size_t count_1, size_t count_2){
+    return count_1 < count_2 ? count_1 : count_2;
+}
 
-    // make the result available
-    quat_to_vec3(&q_1, v);
+// number of vectors converted at once by the packed half precision fast path
+#define HALF_BLOCK_SIZE 256
 
-    return true;
+// a view over a plain array of Vec3_Half, as vec3_view_of_half_array
+static bool is_packed_half_view(Vec3_View const * view){
+    return(
+        view->component_type == 'H' &&
+        view->stride == sizeof(Vec3_Half) &&
+        view->offset_i == offsetof(Vec3_Half, i) &&
+        view->offset_j == offsetof(Vec3_Half, j) &&
+        view->offset_k == offsetof(Vec3_Half, k)
+    );
 }
 
-void rotate_by_quat_R(Vec3 const * v, Quat const * q, Vec3 * Rv){
-    // reminder of the formula:
-    // q = [s, u]
-    // R(v) = 2.0 ( (u . v) u + (s * s - 0.5) v + s (u x v) )
+// rotate_by_quat_R_batch between packed half precision views: blocks of vectors go
+// through the flat conversions (F16C when available) instead of one component at a
+// time, and are rotated in float, so that each result is rounded once, to half
+static void rotate_packed_half_batch(Vec3_View const * v_in, Quat_f const * q, Vec3_View const * v_out, size_t count){
+    unsigned char const * bytes_in = KISS_CAST(unsigned char const *, v_in->base);
+    unsigned char * bytes_out = KISS_CAST(unsigned char *, v_out->base);
+    uint16_t halves[3 * HALF_BLOCK_SIZE];
+    float floats[3 * HALF_BLOCK_SIZE];
+
+    for (size_t first = 0; first < count; first += HALF_BLOCK_SIZE){
+        size_t block_size = min_count(count - first, HALF_BLOCK_SIZE);
+
+        // memcpy, as the base of a view has no alignment requirement
+        memcpy(halves, bytes_in + first * sizeof(Vec3_Half), block_size * sizeof(Vec3_Half));
+        half_array_to_float(halves, floats, 3 * block_size);
+
+        for (size_t n = 0; n < block_size; n++){
+            Vec3_f const crrt_in {floats[3 * n], floats[3 * n + 1], floats[3 * n + 2]};
+            Vec3_f crrt_out;
+            rotate_by_quat_R_f(&crrt_in, q, &crrt_out);
+            floats[3 * n] = crrt_out.i;
+            floats[3 * n + 1] = crrt_out.j;
+            floats[3 * n + 2] = crrt_out.k;
+        }
 
-    F_TYPE u_dot_v = q->i * v->i + q->j * v->j + q->k * v->k;
-    F_TYPE s2m05 = q->r * q->r - F_TYPE_05;
-    Rv->i = F_TYPE_2 * ( u_dot_v * q->i + s2m05 * v->i + q->r * ( q->j * v->k - q->k * v->j ) );
-    Rv->j = F_TYPE_2 * ( u_dot_v * q->j + s2m05 * v->j + q->r * ( q->k * v->i - q->i * v->k ) );
-    Rv->k = F_TYPE_2 * ( u_dot_v * q->k + s2m05 * v->k + q->r * ( q->i * v->j - q->j * v->i ) );
+        float_array_to_half(floats, halves, 3 * block_size);
+        memcpy(bytes_out + first * sizeof(Vec3_Half), halves, block_size * sizeof(Vec3_Half));
+    }
 }
 
+// ------------------------------------------------------------
+// PRECISION DEPENDENT DEFINITIONS
+// ------------------------------------------------------------
+
+// the internal helpers of kiss_clang_3d_generic_impl.h that depend on F_TYPE also need
+// one name per precision
+#define view_component_load KISS_NAME(view_component_load)
+#define view_component_store KISS_NAME(view_component_store)
+#define oct_sign KISS_NAME(oct_sign)
+#define twist_of KISS_NAME(twist_of)
+#define inverse_of_interval KISS_NAME(inverse_of_interval)
+#define angular_velocity_step KISS_NAME(angular_velocity_step)
+
+#undef KISS_PRECISION
+#define KISS_PRECISION _f
+#include "kiss_clang_3d_generic_impl.h"
+#undef KISS_PRECISION
+
+#define KISS_PRECISION _d
+#include "kiss_clang_3d_generic_impl.h"
+#undef KISS_PRECISION
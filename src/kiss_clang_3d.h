@@ -6,20 +6,14 @@
 // use <math> with C compiler, or <cmath> with C++ compiler
 #ifdef __cplusplus
   #include <cmath>
+  #include <cstddef>
+  #include <cstdint>
 #else
   #include <math>
+  #include <stddef.h>
+  #include <stdint.h>
 #endif
 
-// TODO
-// 1
-// rather than having an annoying (axis, angle) format for rotations,
-// define a custom struct for rotation definition
-// 2
-// add a function to determine if 2 rotations are identical but written
-// in different ways
-// 3 
-// add a function to reduce a rotation to a canonical form
-
 // ------------------------------------------------------------
 // MACROS
 // ------------------------------------------------------------
@@ -27,7 +21,14 @@
 #define XSTR(x) STR(x)
 #define STR(x) #x
 
-// what fundamental type do we want to use?
+// casts that are valid both in C and in C++ (where old style casts are not welcome)
+#ifdef __cplusplus
+  #define KISS_CAST(type, x) static_cast<type>(x)
+#else
+  #define KISS_CAST(type, x) ((type)(x))
+#endif
+
+// what fundamental type do we want to use by default?
 // if the F_TYPE_SWITCH is set (by defining the macro earlier, either before #includ-ing, or
 // by defining the compilation flag -DF_TYPE_SWITCH="'X'" where X is the type flag wanted),
 // use it, otherwise, use the value set under.
@@ -36,269 +37,380 @@
   #define F_TYPE_SWITCH 'D'
 #endif
 
-// we write in a C style, no overloading, we need to adapt a bit to what sort of fundamental type we want to use
-#if (F_TYPE_SWITCH == 'F')
-    #define F_TYPE float
-    #define F_CAST (float)
-
-    #define F_TYPE_2 (2.0f)
-    #define F_TYPE_1 (1.0f)
-    #define F_TYPE_0 (0.0f)
-    #define F_TYPE_05 (0.5f)
-    #define F_TYPE_PI (3.14159265358979323846f)
-    #define DEFAULT_TOL (1.0e-5f)
-
-    #define F_TYPE_ABS(x) fabsf(x)
-    #define F_TYPE_SQRT(x) sqrtf(x)
-    #define F_TYPE_COS(x) cosf(x)
-    #define F_TYPE_SIN(x) sinf(x)
-    #define F_TYPE_ACOS(x) acosf(x)
-
-#elif (F_TYPE_SWITCH == 'D')
-    #define F_TYPE double
-    #define F_CAST (double)
-
-    #define F_TYPE_2 (2.0)
-    #define F_TYPE_1 (1.0)
-    #define F_TYPE_0 (0.0)
-    #define F_TYPE_05 (0.5)
-    #define F_TYPE_PI (3.14159265358979323846)
-    #define DEFAULT_TOL (1.0e-6)
-
-    #define F_TYPE_ABS(x) fabs(x)
-    #define F_TYPE_SQRT(x) sqrt(x)
-    #define F_TYPE_COS(x) cos(x)
-    #define F_TYPE_SIN(x) sin(x)
-    #define F_TYPE_ACOS(x) acos(x)
-#else
-    #pragma message "The value of F_TYPE_SWITCH: " XSTR(F_TYPE_SWITCH)
-    #error "invalid F_TYPE_SWITCH admissible switches are F (float) and D (double)"
-#endif
+// ------------------------------------------------------------
+// PRECISIONS
+// ------------------------------------------------------------
 
+// Both the float and the double versions of the library are always available, as
+// two sets of symbols with the _f and _d suffixes (Vec3_f, vec3_norm_f, quat_prod_d,
+// F_TYPE_d, DEFAULT_TOL_d, etc), so that a single program can use float on some hot
+// paths and double on others. The unsuffixed names (Vec3, vec3_norm, F_TYPE, ...) are
+// aliases to the precision selected by F_TYPE_SWITCH.
+//
+// This works by writing the library once, in kiss_clang_3d_generic.h, in terms of the
+// unsuffixed names, which are macros that paste the current KISS_PRECISION suffix to
+// their own name. The generic file is included once per precision, and KISS_PRECISION
+// is finally set to the suffix of the F_TYPE_SWITCH precision.
+
+#define KISS_CAT_(a, b) a##b
+#define KISS_CAT(a, b) KISS_CAT_(a, b)
+#define KISS_NAME(name) KISS_CAT(name, KISS_PRECISION)
+
+// float
+#define F_TYPE_f float
+#define F_CAST_f (float)
+#define F_TYPE_TAG_f 'F'
+
+#define F_TYPE_2_f (2.0f)
+#define F_TYPE_1_f (1.0f)
+#define F_TYPE_0_f (0.0f)
+#define F_TYPE_05_f (0.5f)
+#define F_TYPE_PI_f (3.14159265358979323846f)
+#define DEFAULT_TOL_f (1.0e-5f)
+#define F_TYPE_EPS_f (1.1920928955078125e-7f)
+#define F_TYPE_MAX_f (3.40282346638528859812e+38f)
+#define F_TYPE_MIN_f (1.17549435082228750797e-38f)
+
+#define F_TYPE_ABS_f(x) fabsf(x)
+#define F_TYPE_SQRT_f(x) sqrtf(x)
+#define F_TYPE_COS_f(x) cosf(x)
+#define F_TYPE_SIN_f(x) sinf(x)
+#define F_TYPE_ACOS_f(x) acosf(x)
+#define F_TYPE_ATAN2_f(y, x) atan2f(y, x)
+#define F_TYPE_FLOOR_f(x) floorf(x)
+#define F_TYPE_FMAX_f(x, y) fmaxf(x, y)
+#define F_TYPE_COPYSIGN_f(x, y) copysignf(x, y)
+
+#define F_TYPE_FROM_FLOAT_f(x) (x)
+#define F_TYPE_FROM_DOUBLE_f(x) KISS_CAST(float, x)
+#define F_TYPE_TO_FLOAT_f(x) (x)
+#define F_TYPE_TO_DOUBLE_f(x) KISS_CAST(double, x)
+
+// double
+#define F_TYPE_d double
+#define F_CAST_d (double)
+#define F_TYPE_TAG_d 'D'
+
+#define F_TYPE_2_d (2.0)
+#define F_TYPE_1_d (1.0)
+#define F_TYPE_0_d (0.0)
+#define F_TYPE_05_d (0.5)
+#define F_TYPE_PI_d (3.14159265358979323846)
+#define DEFAULT_TOL_d (1.0e-6)
+#define F_TYPE_EPS_d (2.220446049250313e-16)
+#define F_TYPE_MAX_d (1.79769313486231570815e+308)
+#define F_TYPE_MIN_d (2.22507385850720138309e-308)
+
+#define F_TYPE_ABS_d(x) fabs(x)
+#define F_TYPE_SQRT_d(x) sqrt(x)
+#define F_TYPE_COS_d(x) cos(x)
+#define F_TYPE_SIN_d(x) sin(x)
+#define F_TYPE_ACOS_d(x) acos(x)
+#define F_TYPE_ATAN2_d(y, x) atan2(y, x)
+#define F_TYPE_FLOOR_d(x) floor(x)
+#define F_TYPE_FMAX_d(x, y) fmax(x, y)
+#define F_TYPE_COPYSIGN_d(x, y) copysign(x, y)
+
+#define F_TYPE_FROM_FLOAT_d(x) (x)
+#define F_TYPE_FROM_DOUBLE_d(x) (x)
+#define F_TYPE_TO_FLOAT_d(x) KISS_CAST(float, x)
+#define F_TYPE_TO_DOUBLE_d(x) (x)
+
+// the current precision; F_TYPE_TAG is the component_type of the views ('F' or 'D')
+#define F_TYPE KISS_NAME(F_TYPE)
+#define F_CAST KISS_NAME(F_CAST)
+#define F_TYPE_TAG KISS_NAME(F_TYPE_TAG)
+
+#define F_TYPE_2 KISS_NAME(F_TYPE_2)
+#define F_TYPE_1 KISS_NAME(F_TYPE_1)
+#define F_TYPE_0 KISS_NAME(F_TYPE_0)
+#define F_TYPE_05 KISS_NAME(F_TYPE_05)
+#define F_TYPE_PI KISS_NAME(F_TYPE_PI)
+#define DEFAULT_TOL KISS_NAME(DEFAULT_TOL)
+#define F_TYPE_EPS KISS_NAME(F_TYPE_EPS)
+#define F_TYPE_MAX KISS_NAME(F_TYPE_MAX)
+#define F_TYPE_MIN KISS_NAME(F_TYPE_MIN)
+
+#define F_TYPE_ABS(x) KISS_NAME(F_TYPE_ABS)(x)
+#define F_TYPE_SQRT(x) KISS_NAME(F_TYPE_SQRT)(x)
+#define F_TYPE_COS(x) KISS_NAME(F_TYPE_COS)(x)
+#define F_TYPE_SIN(x) KISS_NAME(F_TYPE_SIN)(x)
+#define F_TYPE_ACOS(x) KISS_NAME(F_TYPE_ACOS)(x)
+#define F_TYPE_ATAN2(y, x) KISS_NAME(F_TYPE_ATAN2)(y, x)
+#define F_TYPE_FLOOR(x) KISS_NAME(F_TYPE_FLOOR)(x)
+#define F_TYPE_FMAX(x, y) KISS_NAME(F_TYPE_FMAX)(x, y)
+#define F_TYPE_COPYSIGN(x, y) KISS_NAME(F_TYPE_COPYSIGN)(x, y)
+
+#define F_TYPE_FROM_FLOAT(x) KISS_NAME(F_TYPE_FROM_FLOAT)(x)
+#define F_TYPE_FROM_DOUBLE(x) KISS_NAME(F_TYPE_FROM_DOUBLE)(x)
+#define F_TYPE_TO_FLOAT(x) KISS_NAME(F_TYPE_TO_FLOAT)(x)
+#define F_TYPE_TO_DOUBLE(x) KISS_NAME(F_TYPE_TO_DOUBLE)(x)
+
+// all the F_TYPE dependent structs and functions of kiss_clang_3d_generic.h; any new
+// struct or function added there must also be listed here.
+#define Vec3 KISS_NAME(Vec3)
+#define Quat KISS_NAME(Quat)
+#define VA_Rot KISS_NAME(VA_Rot)
+#define Joint_Limits KISS_NAME(Joint_Limits)
+
+#define vec3_setter KISS_NAME(vec3_setter)
+#define vec3_copy KISS_NAME(vec3_copy)
+#define vec3_is_null KISS_NAME(vec3_is_null)
+#define vec3_equal KISS_NAME(vec3_equal)
+#define vec3_norm_square KISS_NAME(vec3_norm_square)
+#define vec3_norm KISS_NAME(vec3_norm)
+#define vec3_scale KISS_NAME(vec3_scale)
+#define vec3_add KISS_NAME(vec3_add)
+#define vec3_sub KISS_NAME(vec3_sub)
+#define vec3_scalar KISS_NAME(vec3_scalar)
+#define vec3_cross KISS_NAME(vec3_cross)
+#define vec3_normalize KISS_NAME(vec3_normalize)
+#define vec3_colinear KISS_NAME(vec3_colinear)
+
+#define quat_setter KISS_NAME(quat_setter)
+#define quat_copy KISS_NAME(quat_copy)
+#define quat_norm KISS_NAME(quat_norm)
+#define quat_norm_square KISS_NAME(quat_norm_square)
+#define quat_scalar KISS_NAME(quat_scalar)
+#define quat_angle KISS_NAME(quat_angle)
+#define quat_equal KISS_NAME(quat_equal)
+#define quat_conj KISS_NAME(quat_conj)
+#define quat_is_unitary KISS_NAME(quat_is_unitary)
+#define quat_prod KISS_NAME(quat_prod)
+#define quat_add KISS_NAME(quat_add)
+#define quat_sub KISS_NAME(quat_sub)
+#define quat_inv KISS_NAME(quat_inv)
+#define quat_canonicalize KISS_NAME(quat_canonicalize)
+
+#define quat_to_vec3 KISS_NAME(quat_to_vec3)
+#define vec3_to_quat KISS_NAME(vec3_to_quat)
+#define rotation_to_quat KISS_NAME(rotation_to_quat)
+#define quat_to_rotation KISS_NAME(quat_to_rotation)
+#define rotate_by_quat KISS_NAME(rotate_by_quat)
+#define rotate_by_quat_R KISS_NAME(rotate_by_quat_R)
+#define quat_from_two_vectors KISS_NAME(quat_from_two_vectors)
+
+#define va_rot_setter KISS_NAME(va_rot_setter)
+#define va_rot_copy KISS_NAME(va_rot_copy)
+#define va_rot_canonicalize KISS_NAME(va_rot_canonicalize)
+#define va_rot_equal KISS_NAME(va_rot_equal)
+#define va_rot_is_identity KISS_NAME(va_rot_is_identity)
+#define va_rot_to_quat KISS_NAME(va_rot_to_quat)
+#define va_rot_from_quat KISS_NAME(va_rot_from_quat)
+#define va_rot_to_quat_batch KISS_NAME(va_rot_to_quat_batch)
+#define va_rot_from_quat_batch KISS_NAME(va_rot_from_quat_batch)
+
+#define vec3_view_of_array KISS_NAME(vec3_view_of_array)
+#define vec3_view_get KISS_NAME(vec3_view_get)
+#define vec3_view_set KISS_NAME(vec3_view_set)
+#define quat_view_of_array KISS_NAME(quat_view_of_array)
+#define quat_view_get KISS_NAME(quat_view_get)
+#define quat_view_set KISS_NAME(quat_view_set)
+
+#define vec3_copy_batch KISS_NAME(vec3_copy_batch)
+#define rotate_by_quat_R_batch KISS_NAME(rotate_by_quat_R_batch)
+#define vec3_normalize_batch KISS_NAME(vec3_normalize_batch)
+#define vec3_scale_batch KISS_NAME(vec3_scale_batch)
+#define vec3_add_batch KISS_NAME(vec3_add_batch)
+#define quat_prod_batch KISS_NAME(quat_prod_batch)
+#define quat_from_two_vectors_batch KISS_NAME(quat_from_two_vectors_batch)
+#define quat_abs_scalar_batch KISS_NAME(quat_abs_scalar_batch)
+#define quat_nearest_batch KISS_NAME(quat_nearest_batch)
+
+#define vec3_angle KISS_NAME(vec3_angle)
+#define vec3_oct_encode KISS_NAME(vec3_oct_encode)
+#define vec3_oct_decode KISS_NAME(vec3_oct_decode)
+#define vec3_oct_encode_batch KISS_NAME(vec3_oct_encode_batch)
+#define vec3_oct_decode_batch KISS_NAME(vec3_oct_decode_batch)
+
+#define quat_to_octahedral_rotation KISS_NAME(quat_to_octahedral_rotation)
+#define octahedral_rotation_to_quat KISS_NAME(octahedral_rotation_to_quat)
+#define rotate_by_octahedral_rotation KISS_NAME(rotate_by_octahedral_rotation)
+#define rotate_by_octahedral_rotation_batch KISS_NAME(rotate_by_octahedral_rotation_batch)
+
+#define quat_exp KISS_NAME(quat_exp)
+#define quat_log KISS_NAME(quat_log)
+#define quat_boxplus KISS_NAME(quat_boxplus)
+#define quat_boxminus KISS_NAME(quat_boxminus)
+#define quat_exp_batch KISS_NAME(quat_exp_batch)
+#define quat_log_batch KISS_NAME(quat_log_batch)
+#define quat_boxplus_batch KISS_NAME(quat_boxplus_batch)
+#define quat_boxminus_batch KISS_NAME(quat_boxminus_batch)
+#define quat_angular_velocity KISS_NAME(quat_angular_velocity)
+#define quat_angular_velocity_batch KISS_NAME(quat_angular_velocity_batch)
+#define quat_angular_velocity_times_batch KISS_NAME(quat_angular_velocity_times_batch)
+
+#define quat_swing_twist KISS_NAME(quat_swing_twist)
+#define quat_swing_twist_batch KISS_NAME(quat_swing_twist_batch)
+#define joint_limits_setter KISS_NAME(joint_limits_setter)
+#define quat_clamp_to_limits KISS_NAME(quat_clamp_to_limits)
+#define quat_clamp_to_limits_batch KISS_NAME(quat_clamp_to_limits_batch)
+
+#define Cloud_Stats KISS_NAME(Cloud_Stats)
+#define cloud_stats_clear KISS_NAME(cloud_stats_clear)
+#define cloud_stats_merge KISS_NAME(cloud_stats_merge)
+#define cloud_stats_covariance KISS_NAME(cloud_stats_covariance)
+#define cloud_transform_reduce_batch KISS_NAME(cloud_transform_reduce_batch)
 
 // ------------------------------------------------------------
-// STRUCTS
+// PRECISION INDEPENDENT STRUCTS
 // ------------------------------------------------------------
 
 // --------------------------------------------------
-// 3D vector, components i, j, k
-struct Vec3 {
-    F_TYPE i;
-    F_TYPE j;
-    F_TYPE k;
+// strided, non owning view over a foreign buffer of 3d vectors, for example the
+// positions or normals inside an interleaved vertex buffer. Element n has its
+// components i, j, k at the addresses base + n * stride + offset_(i,j,k). The
+// components are stored as float ('F'), double ('D'), IEEE half precision ('H')
+// or bfloat16 ('B'), independently of the F_TYPE the library is built with; set
+// views up with the setters, which reject any other component type.
+struct Vec3_View {
+    void * base;
+    size_t stride;
+    size_t count;
+    size_t offset_i;
+    size_t offset_j;
+    size_t offset_k;
+    char component_type;
 };
 
 // --------------------------------------------------
-// quaternion, with real part (r), and components (i, i, k)
-struct Quat {
-    F_TYPE r;
-    F_TYPE i;
-    F_TYPE j;
-    F_TYPE k;
+// strided, non owning view over a foreign buffer of quaternions, same conventions
+// as the Vec3_View
+struct Quat_View {
+    void * base;
+    size_t stride;
+    size_t count;
+    size_t offset_r;
+    size_t offset_i;
+    size_t offset_j;
+    size_t offset_k;
+    char component_type;
 };
 
 // --------------------------------------------------
-// vector angle rotation varot, provided as a vector (v_i,j,k) and an angle in rads (a)
-struct VA_Rot {
-    Vec3 axis;
-    F_TYPE angle_rad;
+// 3D vectors packed on 16 bits per component, as IEEE half precision (binary16)
+// or as bfloat16 (the upper half of a float); this halves the memory and bandwidth
+// compared to float, which is plenty for normals and unit direction vectors.
+struct Vec3_Half {
+    uint16_t i;
+    uint16_t j;
+    uint16_t k;
 };
 
-// TODO: implement and add tests for the VA_Rot
-// setter
-// copy
-// reduce to canonical: vector norm 1, positive angle
-// equal
-// is_identity
-// to_quat
-// from_quat
-// TODO: depreciate functions that use vector, angle (deprecate only if do not ignore deprecated
-
-// ------------------------------------------------------------
-// FUNCTIONS DECLARATIONS
-// ------------------------------------------------------------
-
-// ---------------------------------------------
-// Vec3 functions
-// ---------------------------------------------
-
-/*
-Setter, in the right order
-*/
-void vec3_setter(Vec3 * v, F_TYPE vi, F_TYPE vj, F_TYPE vk);
-
-/*
-Copy, 'deep'.
-*/
-void vec3_copy(Vec3 const * v_in, Vec3 * v_out);
-
-/*
-Check if a vector is the null vector, up to a tolerance
-*/
-bool vec3_is_null(Vec3 const * v1, F_TYPE tolerance=DEFAULT_TOL);
-
-/*
-Check if 2 vectors are equal, at a tolerance precision
-*/
-bool vec3_equal(Vec3 const * v1, Vec3 const * v2, F_TYPE tolerance=DEFAULT_TOL);
-
-/*
-Compute the square norm of a vector
-*/
-F_TYPE vec3_norm_square(Vec3 const * v);
-
-/*
-Compute the norm of a vector
-*/
-F_TYPE vec3_norm(Vec3 const * v);
-
-/*
-Scale a vector in place
-*/
-void vec3_scale(Vec3 * v, F_TYPE scale);
-
-/*
-Add a vector v_add to an already existing vector v_acc
-*/
-void vec3_add(Vec3 * v_acc, Vec3 const * v_add);
-
-/*
-Subtract a vector v_subs to an already existing vector v_acc
-*/
-void vec3_sub(Vec3 * v_acc, Vec3 const * v_sub);
-
-/*
-Take the scalar product of 2 vectors
-*/
-F_TYPE vec3_scalar(Vec3 const * v1, Vec3 const * v2);
-
-/*
-Take the cross product of 2 vectors v1 and v2 and put the result in v_res
-*/
-void vec3_cross(Vec3 const * v1, Vec3 const * v2, Vec3 * v_res);
-
-/*
-Normalize a vector in place; of course this does not work for the null vector, so also
-return a bool if was able to normalize or not
-*/
-bool vec3_normalize(Vec3 * v);
-
-/*
-Return wether 2 vectors are colinear
-*/
-bool vec3_colinear(Vec3 const * v, Vec3 const * w, F_TYPE tolerance=DEFAULT_TOL);
-
-// ---------------------------------------------
-// Quat functions
-// ---------------------------------------------
+struct Vec3_BF16 {
+    uint16_t i;
+    uint16_t j;
+    uint16_t k;
+};
 
-/*
-Setter for quaternion
-*/
-void quat_setter(Quat * q, F_TYPE qr, F_TYPE qi, F_TYPE qj, F_TYPE qk);
+// --------------------------------------------------
+// one of the 24 rotations of the octahedral group, i.e. the rotations that map the
+// axes i, j, k onto (plus or minus) the axes i, j, k: multiples of 90 degrees around
+// the axes, and their compositions. These are exact permutations and sign flips of the
+// components: component c of the rotated vector is component source[c] (0 for i, 1 for
+// j, 2 for k) of the vector, negated if negate[c].
+struct Octahedral_Rotation {
+    unsigned char source[3];
+    bool negate[3];
+};
 
-/*
-Copy, deep
-*/
-void quat_copy(Quat const * q_in, Quat * q_out);
+#define OCTAHEDRAL_GROUP_SIZE 24
 
-/*
-Norm of a quaternion
-*/
-F_TYPE quat_norm(Quat const * q);
+// ------------------------------------------------------------
+// PRECISION INDEPENDENT FUNCTIONS DECLARATIONS
+// ------------------------------------------------------------
 
 /*
-Square norm of a quaternion
+Setter for a Vec3_View over a foreign buffer; stride and offsets are in bytes,
+component_type is 'F' (float), 'D' (double), 'H' (half) or 'B' (bfloat16). Return
+false, and set an empty view (count 0), for any other component_type.
 */
-
-F_TYPE quat_norm_square(Quat const * q);
+bool vec3_view_setter(Vec3_View * view, void * base, size_t stride, size_t count, size_t offset_i, size_t offset_j, size_t offset_k, char component_type);
 
 /*
-Whether or not 2 quaternions are equal up to tolerance
+Setter for a Quat_View over a foreign buffer; stride and offsets are in bytes,
+component_type is 'F' (float), 'D' (double), 'H' (half) or 'B' (bfloat16). Return
+false, and set an empty view (count 0), for any other component_type.
 */
-bool quat_equal(Quat const * q_1, Quat const * q_2, F_TYPE tolerance=DEFAULT_TOL);
+bool quat_view_setter(Quat_View * view, void * base, size_t stride, size_t count, size_t offset_r, size_t offset_i, size_t offset_j, size_t offset_k, char component_type);
 
 /*
-Conjugate of a quaternion, in-place
+View over the elements [first, first + count) of a view (clamped to its count), for
+example to split a batch between threads.
 */
-void quat_conj(Quat * q);
+void vec3_view_slice(Vec3_View const * view, size_t first, size_t count, Vec3_View * slice);
+void quat_view_slice(Quat_View const * view, size_t first, size_t count, Quat_View * slice);
 
 /*
-Whether a quaternion is unitary, i.e. has norm 1
+Setters for Vec3_View over plain, contiguous arrays of packed vectors; all the batch
+functions then convert on load and on store, so that for example rotate_by_quat_R_batch
+rotates half precision normals in place, moving half the bytes of float.
+Most batch functions convert one component at a time (in double precision, through
+float, when F_TYPE is double). rotate_by_quat_R_batch between two views set up with
+vec3_view_of_half_array instead converts blocks of vectors with half_array_to_float and
+float_array_to_half (so with F16C when available), and rotates them in float, whatever
+F_TYPE is: each component of the result is rounded once, from float to half.
 */
-bool quat_is_unitary(Quat const * q, F_TYPE tolerance=DEFAULT_TOL);
+void vec3_view_of_half_array(Vec3_View * view, Vec3_Half * array, size_t count);
+void vec3_view_of_bf16_array(Vec3_View * view, Vec3_BF16 * array, size_t count);
 
 /*
-Multiply 2 quaternions, and write the result in a third one
+Number of bytes used by one octahedral code with bits_per_component bits per
+component (see vec3_oct_encode), in the batch encoded streams.
 */
-void quat_prod(Quat const * q_left, Quat const * q_right, Quat * q_result);
+size_t vec3_oct_code_size(unsigned bits_per_component);
 
 /*
-Add one quaternion to another, in place, inside an accumulator
+Conversions between float and IEEE half precision, with round to nearest even;
+overflows give infinities, and infinities and NaNs are preserved.
 */
-void quat_add(Quat * q_acc, Quat const * q_add);
+uint16_t float_to_half(float value);
+float half_to_float(uint16_t value);
 
 /*
-Subtract one quaternion to another, in place, inside an accumulator
+Conversions between float and bfloat16, with round to nearest even; NaNs are preserved.
 */
-void quat_sub(Quat * q_acc, Quat const * q_sub);
+uint16_t float_to_bf16(float value);
+float bf16_to_float(uint16_t value);
 
 /*
-Inverse of a quaternion, in place. This works only for non zero quat,
-so return a boolean flag (true if success).
+Batch versions of the conversions, over flat arrays of count values (use 3 * count to
+convert an array of count vectors). When compiled with F16C support (for example
+-mf16c or -march=native on recent x86), the half precision conversions use the
+hardware instructions, 8 values at a time; among the batch functions over views, only
+rotate_by_quat_R_batch between packed half precision arrays benefits from this.
 */
-bool quat_inv(Quat * q, F_TYPE tolerance=DEFAULT_TOL);
-
-// ---------------------------------------------
-// Quat and VECT functions
-// --------------------------------------------
+void float_array_to_half(float const * values_in, uint16_t * values_out, size_t count);
+void half_array_to_float(uint16_t const * values_in, float * values_out, size_t count);
+void float_array_to_bf16(float const * values_in, uint16_t * values_out, size_t count);
+void bf16_array_to_float(uint16_t const * values_in, float * values_out, size_t count);
 
 /*
-Get a vector from a quaternion. This makes sense only if the quaternion is a "pure vector",
-return a bool indicating if this is the case.
+Rotation number index (from 0 to OCTAHEDRAL_GROUP_SIZE - 1) of the octahedral group;
+index 0 is the identity. Return false if index is out of range.
 */
-bool quat_to_vec3(Quat const * q, Vec3 * v_out, F_TYPE tolerance=DEFAULT_TOL);
+bool octahedral_rotation_of_index(Octahedral_Rotation * rotation, unsigned index);
 
-/*
-Write the vector part into a pure vector quaternion
-*/
-void vec3_to_quat(Vec3 const * v, Quat * q_out);
+// ------------------------------------------------------------
+// PRECISION DEPENDENT STRUCTS AND FUNCTIONS
+// ------------------------------------------------------------
 
-/*
-Write a "rotation quaternion" given the rotation axis and angle in rad.
-This works only for non null axis vector, except if the transformation is
-the identity.
-*/
-bool rotation_to_quat(Quat * q, Vec3 const * rotation_axis, F_TYPE const rotation_angle_rad, F_TYPE tolerance=DEFAULT_TOL);
+#define KISS_PRECISION _f
+#include "kiss_clang_3d_generic.h"
+#undef KISS_PRECISION
 
-/*
-Extract the rotation axis and angle from a unit quaternion; this works
-only for unit quaternions, so return bool if is unit. We are polite and we
-return a rotation axis that has unit norm.
-*/
-bool quat_to_rotation(Vec3 * rotation_axis, F_TYPE * rotation_angle_rad, Quat const * q_rotation, F_TYPE tolerance=DEFAULT_TOL);
+#define KISS_PRECISION _d
+#include "kiss_clang_3d_generic.h"
+#undef KISS_PRECISION
 
-/*
-Rotate a vector by a given quaternion, using the direct method:
-[0, R(v)] = q x [0, v] x q*
-This is the simplest method, but quite slow.
-Only unit quaternions are pure rotations; provide a bool flag indicating if this is valid.
-*/
-#ifdef KISS_CLANG_3D_IGNORE_DEPRECATED
-  bool rotate_by_quat(Vec3 * v, Quat const * q, F_TYPE tolerance=DEFAULT_TOL);
+// the default precision, used by the unsuffixed names
+#if (F_TYPE_SWITCH == 'F')
+    #define KISS_PRECISION _f
+#elif (F_TYPE_SWITCH == 'D')
+    #define KISS_PRECISION _d
 #else
-  bool rotate_by_quat(Vec3 * v, Quat const * q, F_TYPE tolerance=DEFAULT_TOL) __attribute__((deprecated("prefer using rotate_by_quat_R with is faster")));
+    #pragma message "The value of F_TYPE_SWITCH: " XSTR(F_TYPE_SWITCH)
+    #error "invalid F_TYPE_SWITCH admissible switches are F (float) and D (double)"
 #endif
 
-/*
-Rotate a vector by a unit quaternion, using the "Rodriguez" formula:
-https://gamedev.stackexchange.com/questions/28395/rotating-vector3-by-a-quaternion
-q = [s, u], s the scalar part, u the vector part
-R(v) = 2.0 ( (u . v) u + (s * s - 0.5) v + s (u x v) )
-This is quite a bit faster. This assumes that a unit quaternion is provided
-(but not checked, for speed; providing a unit quaternion is the caller's
-responsibility).
-*/
-void rotate_by_quat_R(Vec3 const * v, Quat const * q, Vec3 * Rv);
-
 #endif
@@ -0,0 +1,153 @@
+#ifndef KISS_CLANG_3D_AXES_H
+#define KISS_CLANG_3D_AXES_H
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// Optional, header only, C++ specializations for the rotations around the axes i, j, k,
+// in the default precision (F_TYPE):
+//
+//     Quat q = kiss3d::rotate_about<kiss3d::Axis::K>(angle);         // no axis normalization
+//     Vec3 Rv = kiss3d::rotate_about<kiss3d::Axis::K>(angle, v);     // a 2D rotation, 4 multiplications
+//     Vec3 Rv = kiss3d::rotate_quarter_turns<kiss3d::Axis::K, 1>(v); // 90 degrees, no multiplication
+//
+// The multiples of 90 degrees are elements of the octahedral group (see
+// Octahedral_Rotation in kiss_clang_3d.h), built at compile time.
+
+#include "./kiss_clang_3d.h"
+
+namespace kiss3d {
+
+enum class Axis { I, J, K };
+
+// ------------------------------------------------------------
+// ROTATIONS OF ANY ANGLE
+// ------------------------------------------------------------
+
+/*
+Unit quaternion of the rotation of angle_rad around the axis, as rotation_to_quat.
+*/
+template <Axis axis>
+Quat rotate_about(F_TYPE angle_rad);
+
+template <>
+inline Quat rotate_about<Axis::I>(F_TYPE angle_rad){
+    F_TYPE half_rotation_angle = angle_rad / F_TYPE_2;
+    return Quat {F_TYPE_COS(half_rotation_angle), F_TYPE_SIN(half_rotation_angle), F_TYPE_0, F_TYPE_0};
+}
+
+template <>
+inline Quat rotate_about<Axis::J>(F_TYPE angle_rad){
+    F_TYPE half_rotation_angle = angle_rad / F_TYPE_2;
+    return Quat {F_TYPE_COS(half_rotation_angle), F_TYPE_0, F_TYPE_SIN(half_rotation_angle), F_TYPE_0};
+}
+
+template <>
+inline Quat rotate_about<Axis::K>(F_TYPE angle_rad){
+    F_TYPE half_rotation_angle = angle_rad / F_TYPE_2;
+    return Quat {F_TYPE_COS(half_rotation_angle), F_TYPE_0, F_TYPE_0, F_TYPE_SIN(half_rotation_angle)};
+}
+
+/*
+Rotation of v by angle_rad around the axis; the component along the axis is untouched,
+the 2 others are rotated in their plane.
+*/
+template <Axis axis>
+Vec3 rotate_about(F_TYPE angle_rad, Vec3 const & v);
+
+template <>
+inline Vec3 rotate_about<Axis::I>(F_TYPE angle_rad, Vec3 const & v){
+    F_TYPE cos_of_angle = F_TYPE_COS(angle_rad);
+    F_TYPE sin_of_angle = F_TYPE_SIN(angle_rad);
+    return Vec3 {v.i, cos_of_angle * v.j - sin_of_angle * v.k, sin_of_angle * v.j + cos_of_angle * v.k};
+}
+
+template <>
+inline Vec3 rotate_about<Axis::J>(F_TYPE angle_rad, Vec3 const & v){
+    F_TYPE cos_of_angle = F_TYPE_COS(angle_rad);
+    F_TYPE sin_of_angle = F_TYPE_SIN(angle_rad);
+    return Vec3 {cos_of_angle * v.i + sin_of_angle * v.k, v.j, cos_of_angle * v.k - sin_of_angle * v.i};
+}
+
+template <>
+inline Vec3 rotate_about<Axis::K>(F_TYPE angle_rad, Vec3 const & v){
+    F_TYPE cos_of_angle = F_TYPE_COS(angle_rad);
+    F_TYPE sin_of_angle = F_TYPE_SIN(angle_rad);
+    return Vec3 {cos_of_angle * v.i - sin_of_angle * v.j, sin_of_angle * v.i + cos_of_angle * v.j, v.k};
+}
+
+// ------------------------------------------------------------
+// QUARTER TURNS
+// ------------------------------------------------------------
+
+/*
+The rotation left after the rotation right.
+*/
+constexpr Octahedral_Rotation octahedral_compose(Octahedral_Rotation const & left, Octahedral_Rotation const & right){
+    Octahedral_Rotation result {{0, 1, 2}, {false, false, false}};
+    for (unsigned c = 0; c < 3; c++){
+        result.source[c] = right.source[left.source[c]];
+        result.negate[c] = left.negate[c] != right.negate[left.source[c]];
+    }
+    return result;
+}
+
+/*
+Rotation of 90 degrees around the axis.
+*/
+template <Axis axis>
+constexpr Octahedral_Rotation octahedral_quarter_turn();
+
+template <>
+constexpr Octahedral_Rotation octahedral_quarter_turn<Axis::I>(){
+    // (i, j, k) -> (i, -k, j)
+    return Octahedral_Rotation {{0, 2, 1}, {false, true, false}};
+}
+
+template <>
+constexpr Octahedral_Rotation octahedral_quarter_turn<Axis::J>(){
+    // (i, j, k) -> (k, j, -i)
+    return Octahedral_Rotation {{2, 1, 0}, {false, false, true}};
+}
+
+template <>
+constexpr Octahedral_Rotation octahedral_quarter_turn<Axis::K>(){
+    // (i, j, k) -> (-j, i, k)
+    return Octahedral_Rotation {{1, 0, 2}, {true, false, false}};
+}
+
+/*
+Rotation of quarter_turns times 90 degrees around the axis; quarter_turns may be negative.
+*/
+template <Axis axis, int quarter_turns>
+constexpr Octahedral_Rotation octahedral_quarter_turns(){
+    Octahedral_Rotation result {{0, 1, 2}, {false, false, false}};
+    for (int n = 0; n < ((quarter_turns % 4) + 4) % 4; n++){
+        result = octahedral_compose(octahedral_quarter_turn<axis>(), result);
+    }
+    return result;
+}
+
+/*
+Rotation of v by an octahedral rotation, as rotate_by_octahedral_rotation.
+*/
+constexpr Vec3 rotate_octahedral(Octahedral_Rotation const & rotation, Vec3 const & v){
+    F_TYPE const components[3] {v.i, v.j, v.k};
+    F_TYPE const vi = components[rotation.source[0]];
+    F_TYPE const vj = components[rotation.source[1]];
+    F_TYPE const vk = components[rotation.source[2]];
+    return Vec3 {rotation.negate[0] ? -vi : vi, rotation.negate[1] ? -vj : vj, rotation.negate[2] ? -vk : vk};
+}
+
+/*
+Rotation of v by quarter_turns times 90 degrees around the axis; the rotation is known
+at compile time, so that this is only a few moves and sign flips.
+*/
+template <Axis axis, int quarter_turns>
+constexpr Vec3 rotate_quarter_turns(Vec3 const & v){
+    constexpr Octahedral_Rotation rotation = octahedral_quarter_turns<axis, quarter_turns>();
+    return rotate_octahedral(rotation, v);
+}
+
+}  // namespace kiss3d
+
+#endif
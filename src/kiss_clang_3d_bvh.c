@@ -0,0 +1,470 @@
+#include "kiss_clang_3d_bvh.h"
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// ------------------------------------------------------------
+// INTERNALS
+// ------------------------------------------------------------
+
+// SAH binning
+#define NBR_BINS 12
+// above this size, a node is split even if the SAH does not find it worth it
+#define MAX_LEAF_SIZE 8
+
+static F_TYPE component(Vec3 const * v, int axis){
+    switch (axis){
+        case 0:
+            return v->i;
+        case 1:
+            return v->j;
+        default:
+            return v->k;
+    }
+}
+
+static void box_empty(Vec3 * box_min, Vec3 * box_max){
+    vec3_setter(box_min, F_TYPE_MAX, F_TYPE_MAX, F_TYPE_MAX);
+    vec3_setter(box_max, -F_TYPE_MAX, -F_TYPE_MAX, -F_TYPE_MAX);
+}
+
+static void box_grow_point(Vec3 * box_min, Vec3 * box_max, Vec3 const * point){
+    box_min->i = point->i < box_min->i ? point->i : box_min->i;
+    box_min->j = point->j < box_min->j ? point->j : box_min->j;
+    box_min->k = point->k < box_min->k ? point->k : box_min->k;
+    box_max->i = point->i > box_max->i ? point->i : box_max->i;
+    box_max->j = point->j > box_max->j ? point->j : box_max->j;
+    box_max->k = point->k > box_max->k ? point->k : box_max->k;
+}
+
+static void box_grow_box(Vec3 * box_min, Vec3 * box_max, Vec3 const * other_min, Vec3 const * other_max){
+    // an empty box (as the one of an empty bin) does not grow anything
+    if (other_min->i > other_max->i){
+        return;
+    }
+    box_grow_point(box_min, box_max, other_min);
+    box_grow_point(box_min, box_max, other_max);
+}
+
+// half the area of the box, 0 for an empty box
+static F_TYPE box_half_area(Vec3 const * box_min, Vec3 const * box_max){
+    if (box_min->i > box_max->i){
+        return F_TYPE_0;
+    }
+    F_TYPE di = box_max->i - box_min->i;
+    F_TYPE dj = box_max->j - box_min->j;
+    F_TYPE dk = box_max->k - box_min->k;
+    return di * dj + dj * dk + dk * di;
+}
+
+static void triangle_box(BVH const * bvh, size_t triangle, Vec3 * box_min, Vec3 * box_max){
+    box_empty(box_min, box_max);
+    for (size_t n = 0; n < 3; n++){
+        box_grow_point(box_min, box_max, &bvh->vertices[3 * triangle + n]);
+    }
+}
+
+static F_TYPE triangle_centroid(BVH const * bvh, size_t triangle, int axis){
+    return (
+        component(&bvh->vertices[3 * triangle], axis) +
+        component(&bvh->vertices[3 * triangle + 1], axis) +
+        component(&bvh->vertices[3 * triangle + 2], axis)
+    ) / KISS_CAST(F_TYPE, 3);
+}
+
+struct SAH_Bin {
+    Vec3 box_min;
+    Vec3 box_max;
+    size_t count;
+};
+
+static size_t bin_of(F_TYPE centroid, F_TYPE centroid_min, F_TYPE bin_scale){
+    size_t bin = KISS_CAST(size_t, (centroid - centroid_min) * bin_scale);
+    return bin < NBR_BINS ? bin : NBR_BINS - 1;
+}
+
+static void build_node(BVH * bvh, size_t node_index, size_t first, size_t count, size_t depth){
+    BVH_Node * node = &bvh->nodes[node_index];
+    Vec3 centroid_min;
+    Vec3 centroid_max;
+    Vec3 triangle_min;
+    Vec3 triangle_max;
+
+    box_empty(&node->box_min, &node->box_max);
+    box_empty(&centroid_min, &centroid_max);
+    for (size_t n = first; n < first + count; n++){
+        size_t triangle = bvh->triangle_indexes[n];
+        triangle_box(bvh, triangle, &triangle_min, &triangle_max);
+        box_grow_box(&node->box_min, &node->box_max, &triangle_min, &triangle_max);
+        Vec3 centroid {triangle_centroid(bvh, triangle, 0), triangle_centroid(bvh, triangle, 1), triangle_centroid(bvh, triangle, 2)};
+        box_grow_point(&centroid_min, &centroid_max, &centroid);
+    }
+
+    node->first = first;
+    node->count = count;
+
+    // split along the largest extent of the centroids
+    int axis = 0;
+    for (int crrt_axis = 1; crrt_axis < 3; crrt_axis++){
+        if (component(&centroid_max, crrt_axis) - component(&centroid_min, crrt_axis) > component(&centroid_max, axis) - component(&centroid_min, axis)){
+            axis = crrt_axis;
+        }
+    }
+    F_TYPE axis_min = component(&centroid_min, axis);
+    F_TYPE extent = component(&centroid_max, axis) - axis_min;
+
+    if (count <= 1 || depth >= BVH_MAX_DEPTH || !(extent > F_TYPE_0)){
+        return;
+    }
+
+    SAH_Bin bins[NBR_BINS];
+    F_TYPE bin_scale = KISS_CAST(F_TYPE, NBR_BINS) / extent;
+    for (size_t b = 0; b < NBR_BINS; b++){
+        box_empty(&bins[b].box_min, &bins[b].box_max);
+        bins[b].count = 0;
+    }
+    for (size_t n = first; n < first + count; n++){
+        size_t triangle = bvh->triangle_indexes[n];
+        SAH_Bin * bin = &bins[bin_of(triangle_centroid(bvh, triangle, axis), axis_min, bin_scale)];
+        triangle_box(bvh, triangle, &triangle_min, &triangle_max);
+        box_grow_box(&bin->box_min, &bin->box_max, &triangle_min, &triangle_max);
+        bin->count++;
+    }
+
+    // cost of splitting after bin b, up to the factor 1 / area of the node; the
+    // right sides are swept first
+    F_TYPE right_costs[NBR_BINS];
+    Vec3 sweep_min;
+    Vec3 sweep_max;
+    size_t sweep_count = 0;
+    box_empty(&sweep_min, &sweep_max);
+    for (size_t b = NBR_BINS - 1; b > 0; b--){
+        box_grow_box(&sweep_min, &sweep_max, &bins[b].box_min, &bins[b].box_max);
+        sweep_count += bins[b].count;
+        right_costs[b - 1] = box_half_area(&sweep_min, &sweep_max) * KISS_CAST(F_TYPE, sweep_count);
+    }
+
+    size_t best_split = NBR_BINS;
+    F_TYPE best_cost = F_TYPE_MAX;
+    box_empty(&sweep_min, &sweep_max);
+    sweep_count = 0;
+    for (size_t b = 0; b + 1 < NBR_BINS; b++){
+        box_grow_box(&sweep_min, &sweep_max, &bins[b].box_min, &bins[b].box_max);
+        sweep_count += bins[b].count;
+        if (sweep_count == 0 || sweep_count == count){
+            continue;
+        }
+        F_TYPE cost = box_half_area(&sweep_min, &sweep_max) * KISS_CAST(F_TYPE, sweep_count) + right_costs[b];
+        if (cost < best_cost){
+            best_cost = cost;
+            best_split = b;
+        }
+    }
+
+    // the extent is not 0, so the first and last bins are used, and there should be a
+    // split; a traversal step costs about as much as a triangle test
+    F_TYPE node_area = box_half_area(&node->box_min, &node->box_max);
+    if (best_split == NBR_BINS || (count <= MAX_LEAF_SIZE && best_cost + node_area >= node_area * KISS_CAST(F_TYPE, count))){
+        return;
+    }
+
+    size_t middle = first;
+    for (size_t n = first; n < first + count; n++){
+        size_t triangle = bvh->triangle_indexes[n];
+        if (bin_of(triangle_centroid(bvh, triangle, axis), axis_min, bin_scale) <= best_split){
+            bvh->triangle_indexes[n] = bvh->triangle_indexes[middle];
+            bvh->triangle_indexes[middle] = triangle;
+            middle++;
+        }
+    }
+
+    size_t children = bvh->nbr_nodes;
+    bvh->nbr_nodes += 2;
+    node->first = children;
+    node->count = 0;
+
+    build_node(bvh, children, first, middle - first, depth + 1);
+    build_node(bvh, children + 1, middle, first + count - middle, depth + 1);
+}
+
+// the rays of a packet, as arrays of components
+struct Ray_Packet {
+    size_t nbr_rays;
+    F_TYPE origin_i[BVH_PACKET_SIZE];
+    F_TYPE origin_j[BVH_PACKET_SIZE];
+    F_TYPE origin_k[BVH_PACKET_SIZE];
+    F_TYPE direction_i[BVH_PACKET_SIZE];
+    F_TYPE direction_j[BVH_PACKET_SIZE];
+    F_TYPE direction_k[BVH_PACKET_SIZE];
+    F_TYPE inv_direction_i[BVH_PACKET_SIZE];
+    F_TYPE inv_direction_j[BVH_PACKET_SIZE];
+    F_TYPE inv_direction_k[BVH_PACKET_SIZE];
+};
+
+static void packet_set_ray(Ray_Packet * packet, size_t n, Vec3 const * origin, Vec3 const * direction){
+    packet->origin_i[n] = origin->i;
+    packet->origin_j[n] = origin->j;
+    packet->origin_k[n] = origin->k;
+    packet->direction_i[n] = direction->i;
+    packet->direction_j[n] = direction->j;
+    packet->direction_k[n] = direction->k;
+    // infinite for a 0 component, see slab_restrict
+    packet->inv_direction_i[n] = F_TYPE_1 / direction->i;
+    packet->inv_direction_j[n] = F_TYPE_1 / direction->j;
+    packet->inv_direction_k[n] = F_TYPE_1 / direction->k;
+}
+
+// restrict [t_near, t_far] to the slab [box_min, box_max] along one axis; a ray
+// parallel to the slab gets infinite bounds, and NaN ones (0 * inf) if its origin is
+// on a face: it is then in the slab for all t, and nothing is restricted
+static void slab_restrict(F_TYPE box_min, F_TYPE box_max, F_TYPE origin, F_TYPE inv_direction, F_TYPE * t_near, F_TYPE * t_far){
+    F_TYPE t_1 = (box_min - origin) * inv_direction;
+    F_TYPE t_2 = (box_max - origin) * inv_direction;
+
+    if (t_1 != t_1 || t_2 != t_2){
+        return;
+    }
+
+    F_TYPE t_entry = t_1 < t_2 ? t_1 : t_2;
+    F_TYPE t_exit = t_1 < t_2 ? t_2 : t_1;
+    *t_near = t_entry > *t_near ? t_entry : *t_near;
+    *t_far = t_exit < *t_far ? t_exit : *t_far;
+}
+
+// slab test of all the rays against the box, up to their closest hit so far
+static bool packet_hits_box(Ray_Packet const * packet, Ray_Hit const * hits, Vec3 const * box_min, Vec3 const * box_max){
+    size_t nbr_hits = 0;
+
+    for (size_t n = 0; n < packet->nbr_rays; n++){
+        F_TYPE t_near = F_TYPE_0;
+        F_TYPE t_far = hits[n].distance;
+
+        slab_restrict(box_min->i, box_max->i, packet->origin_i[n], packet->inv_direction_i[n], &t_near, &t_far);
+        slab_restrict(box_min->j, box_max->j, packet->origin_j[n], packet->inv_direction_j[n], &t_near, &t_far);
+        slab_restrict(box_min->k, box_max->k, packet->origin_k[n], packet->inv_direction_k[n], &t_near, &t_far);
+
+        nbr_hits += t_near <= t_far ? 1 : 0;
+    }
+
+    return nbr_hits > 0;
+}
+
+// Moller-Trumbore of all the rays against one triangle, the edges being computed once
+static void packet_intersect_triangle(BVH const * bvh, Ray_Packet const * packet, size_t triangle, Ray_Hit * hits){
+    Vec3 const * v_0 = &bvh->vertices[3 * triangle];
+    Vec3 const * v_1 = &bvh->vertices[3 * triangle + 1];
+    Vec3 const * v_2 = &bvh->vertices[3 * triangle + 2];
+    F_TYPE edge_1_i = v_1->i - v_0->i;
+    F_TYPE edge_1_j = v_1->j - v_0->j;
+    F_TYPE edge_1_k = v_1->k - v_0->k;
+    F_TYPE edge_2_i = v_2->i - v_0->i;
+    F_TYPE edge_2_j = v_2->j - v_0->j;
+    F_TYPE edge_2_k = v_2->k - v_0->k;
+
+    for (size_t n = 0; n < packet->nbr_rays; n++){
+        // p = direction x edge_2
+        F_TYPE p_i = packet->direction_j[n] * edge_2_k - packet->direction_k[n] * edge_2_j;
+        F_TYPE p_j = packet->direction_k[n] * edge_2_i - packet->direction_i[n] * edge_2_k;
+        F_TYPE p_k = packet->direction_i[n] * edge_2_j - packet->direction_j[n] * edge_2_i;
+        F_TYPE det = edge_1_i * p_i + edge_1_j * p_j + edge_1_k * p_k;
+        if (det == F_TYPE_0){
+            continue;
+        }
+        F_TYPE inv_det = F_TYPE_1 / det;
+
+        F_TYPE s_i = packet->origin_i[n] - v_0->i;
+        F_TYPE s_j = packet->origin_j[n] - v_0->j;
+        F_TYPE s_k = packet->origin_k[n] - v_0->k;
+        F_TYPE u = (s_i * p_i + s_j * p_j + s_k * p_k) * inv_det;
+
+        // q = s x edge_1
+        F_TYPE q_i = s_j * edge_1_k - s_k * edge_1_j;
+        F_TYPE q_j = s_k * edge_1_i - s_i * edge_1_k;
+        F_TYPE q_k = s_i * edge_1_j - s_j * edge_1_i;
+        F_TYPE v = (packet->direction_i[n] * q_i + packet->direction_j[n] * q_j + packet->direction_k[n] * q_k) * inv_det;
+        F_TYPE t = (edge_2_i * q_i + edge_2_j * q_j + edge_2_k * q_k) * inv_det;
+
+        if (u >= F_TYPE_0 && v >= F_TYPE_0 && u + v <= F_TYPE_1 && t >= F_TYPE_0 && t <= hits[n].distance){
+            hits[n].distance = t;
+            hits[n].u = u;
+            hits[n].v = v;
+            hits[n].triangle = triangle;
+        }
+    }
+}
+
+// distance of the first ray to the center of the box, to visit the closest child first
+static F_TYPE packet_box_order(Ray_Packet const * packet, BVH_Node const * node){
+    return (
+        ((node->box_min.i + node->box_max.i) / F_TYPE_2 - packet->origin_i[0]) * packet->direction_i[0] +
+        ((node->box_min.j + node->box_max.j) / F_TYPE_2 - packet->origin_j[0]) * packet->direction_j[0] +
+        ((node->box_min.k + node->box_max.k) / F_TYPE_2 - packet->origin_k[0]) * packet->direction_k[0]
+    );
+}
+
+static void intersect_packet(BVH const * bvh, Ray_Packet const * packet, F_TYPE max_distance, Ray_Hit * hits){
+    for (size_t n = 0; n < packet->nbr_rays; n++){
+        hits[n].distance = max_distance;
+        hits[n].u = F_TYPE_0;
+        hits[n].v = F_TYPE_0;
+        hits[n].triangle = BVH_NO_HIT;
+    }
+
+    if (bvh->nbr_nodes == 0){
+        return;
+    }
+
+    // the depth is at most BVH_MAX_DEPTH, and each level leaves at most 1 node behind
+    size_t stack[BVH_MAX_DEPTH + 2];
+    size_t stack_size = 0;
+    stack[stack_size++] = 0;
+
+    while (stack_size > 0){
+        BVH_Node const * node = &bvh->nodes[stack[--stack_size]];
+
+        if (!packet_hits_box(packet, hits, &node->box_min, &node->box_max)){
+            continue;
+        }
+
+        if (node->count > 0){
+            for (size_t n = node->first; n < node->first + node->count; n++){
+                packet_intersect_triangle(bvh, packet, bvh->triangle_indexes[n], hits);
+            }
+        }
+        else{
+            bool left_first = packet_box_order(packet, &bvh->nodes[node->first]) <= packet_box_order(packet, &bvh->nodes[node->first + 1]);
+            stack[stack_size++] = left_first ? node->first + 1 : node->first;
+            stack[stack_size++] = left_first ? node->first : node->first + 1;
+        }
+    }
+}
+
+static size_t count_hits(Ray_Hit const * hits, size_t count){
+    size_t nbr_hits = 0;
+    for (size_t n = 0; n < count; n++){
+        if (hits[n].triangle != BVH_NO_HIT){
+            nbr_hits++;
+        }
+    }
+    return nbr_hits;
+}
+
+// ------------------------------------------------------------
+// FUNCTIONS DEFINITIONS
+// ------------------------------------------------------------
+
+bool bvh_build(BVH * bvh, Vec3 const * vertices, size_t nbr_triangles, size_t * triangle_indexes, BVH_Node * nodes, size_t max_nodes){
+    if (vertices == NULL || triangle_indexes == NULL || nodes == NULL || max_nodes < BVH_MAX_NODES(nbr_triangles)){
+        return false;
+    }
+
+    bvh->vertices = vertices;
+    bvh->nbr_triangles = nbr_triangles;
+    bvh->triangle_indexes = triangle_indexes;
+    bvh->nodes = nodes;
+    bvh->nbr_nodes = 0;
+
+    if (nbr_triangles == 0){
+        return true;
+    }
+
+    for (size_t n = 0; n < nbr_triangles; n++){
+        triangle_indexes[n] = n;
+    }
+
+    bvh->nbr_nodes = 1;
+    build_node(bvh, 0, 0, nbr_triangles, 0);
+
+    return true;
+}
+
+bool ray_triangle_intersect(Vec3 const * origin, Vec3 const * direction, Vec3 const * v_0, Vec3 const * v_1, Vec3 const * v_2, F_TYPE max_distance, Ray_Hit * hit){
+    Vec3 edge_1;
+    Vec3 edge_2;
+    Vec3 p;
+    Vec3 s;
+    Vec3 q;
+
+    vec3_copy(v_1, &edge_1);
+    vec3_sub(&edge_1, v_0);
+    vec3_copy(v_2, &edge_2);
+    vec3_sub(&edge_2, v_0);
+
+    vec3_cross(direction, &edge_2, &p);
+    F_TYPE det = vec3_scalar(&edge_1, &p);
+    if (det == F_TYPE_0){
+        return false;
+    }
+    F_TYPE inv_det = F_TYPE_1 / det;
+
+    vec3_copy(origin, &s);
+    vec3_sub(&s, v_0);
+    F_TYPE u = vec3_scalar(&s, &p) * inv_det;
+    if (u < F_TYPE_0 || u > F_TYPE_1){
+        return false;
+    }
+
+    vec3_cross(&s, &edge_1, &q);
+    F_TYPE v = vec3_scalar(direction, &q) * inv_det;
+    if (v < F_TYPE_0 || u + v > F_TYPE_1){
+        return false;
+    }
+
+    F_TYPE t = vec3_scalar(&edge_2, &q) * inv_det;
+    if (t < F_TYPE_0 || t > max_distance){
+        return false;
+    }
+
+    hit->distance = t;
+    hit->u = u;
+    hit->v = v;
+
+    return true;
+}
+
+bool bvh_intersect(BVH const * bvh, Vec3 const * origin, Vec3 const * direction, F_TYPE max_distance, Ray_Hit * hit){
+    Ray_Packet packet;
+    packet.nbr_rays = 1;
+    packet_set_ray(&packet, 0, origin, direction);
+
+    intersect_packet(bvh, &packet, max_distance, hit);
+
+    return hit->triangle != BVH_NO_HIT;
+}
+
+size_t bvh_intersect_batch(BVH const * bvh, Vec3_View const * origins, Vec3_View const * directions, F_TYPE max_distance, Ray_Hit * hits){
+    size_t count = origins->count < directions->count ? origins->count : directions->count;
+    Ray_Packet packet;
+    Vec3 crrt_origin;
+    Vec3 crrt_direction;
+
+    for (size_t first = 0; first < count; first += BVH_PACKET_SIZE){
+        packet.nbr_rays = count - first < BVH_PACKET_SIZE ? count - first : BVH_PACKET_SIZE;
+        for (size_t n = 0; n < packet.nbr_rays; n++){
+            vec3_view_get(origins, first + n, &crrt_origin);
+            vec3_view_get(directions, first + n, &crrt_direction);
+            packet_set_ray(&packet, n, &crrt_origin, &crrt_direction);
+        }
+        intersect_packet(bvh, &packet, max_distance, &hits[first]);
+    }
+
+    return count_hits(hits, count);
+}
+
+size_t bvh_intersect_from_frame(BVH const * bvh, Vec3 const * frame_origin, Quat const * frame_rotation, Vec3_View const * directions, F_TYPE max_distance, Ray_Hit * hits){
+    size_t count = directions->count;
+    Ray_Packet packet;
+    Vec3 crrt_direction;
+    Vec3 rotated_direction;
+
+    for (size_t first = 0; first < count; first += BVH_PACKET_SIZE){
+        packet.nbr_rays = count - first < BVH_PACKET_SIZE ? count - first : BVH_PACKET_SIZE;
+        for (size_t n = 0; n < packet.nbr_rays; n++){
+            vec3_view_get(directions, first + n, &crrt_direction);
+            rotate_by_quat_R(&crrt_direction, frame_rotation, &rotated_direction);
+            packet_set_ray(&packet, n, frame_origin, &rotated_direction);
+        }
+        intersect_packet(bvh, &packet, max_distance, &hits[first]);
+    }
+
+    return count_hits(hits, count);
+}
@@ -0,0 +1,106 @@
+#ifndef KISS_CLANG_3D_BVH_H
+#define KISS_CLANG_3D_BVH_H
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// Bounding volume hierarchy over a triangle mesh, in the default precision (F_TYPE),
+// to cast many rays against it (range sensors, visibility, ...).
+// The tree is built with the surface area heuristic (SAH) on binned centroids, and is
+// flattened in a single array of nodes, the 2 children of a node being next to each
+// other. The rays are traced in packets of BVH_PACKET_SIZE rays: the boxes and the
+// triangles are tested against all the rays of a packet in plain loops over arrays,
+// which the compilers vectorize, and a node is skipped as soon as no ray of the
+// packet hits its box. The ray / triangle intersections use the Moller-Trumbore
+// algorithm, and are 2 sided.
+// All the memory is provided by the caller; nothing is allocated.
+
+#include "./kiss_clang_3d.h"
+
+// ------------------------------------------------------------
+// STRUCTS
+// ------------------------------------------------------------
+
+// --------------------------------------------------
+// a node of the tree: a leaf if count > 0, with the triangles at triangle_indexes[first
+// .. first + count - 1]; otherwise, its children are the nodes first and first + 1
+struct BVH_Node {
+    Vec3 box_min;
+    Vec3 box_max;
+    size_t first;
+    size_t count;
+};
+
+// --------------------------------------------------
+// the tree; use bvh_build to set it up, and only read the members. The triangle n
+// has the vertices vertices[3 n], vertices[3 n + 1], vertices[3 n + 2].
+struct BVH {
+    Vec3 const * vertices;
+    size_t nbr_triangles;
+    size_t * triangle_indexes;
+    BVH_Node * nodes;
+    size_t nbr_nodes;
+};
+
+// --------------------------------------------------
+// the closest hit of a ray: the distance along the ray (in units of the length of the
+// direction), the barycentric coordinates (u, v) of the hit on the triangle, i.e. hit
+// = (1 - u - v) v_0 + u v_1 + v v_2, and the index of the triangle (BVH_NO_HIT if the
+// ray does not hit anything)
+struct Ray_Hit {
+    F_TYPE distance;
+    F_TYPE u;
+    F_TYPE v;
+    size_t triangle;
+};
+
+#define BVH_NO_HIT SIZE_MAX
+
+// number of nodes the caller must provide for a mesh of nbr_triangles triangles
+#define BVH_MAX_NODES(nbr_triangles) (2 * (nbr_triangles))
+
+// number of rays traced together
+#define BVH_PACKET_SIZE 8
+
+// the depth of the tree is limited (the deeper nodes become leaves), so that the
+// traversal works with a fixed size stack
+#define BVH_MAX_DEPTH 64
+
+// ------------------------------------------------------------
+// FUNCTIONS DECLARATIONS
+// ------------------------------------------------------------
+
+/*
+Build the tree over the nbr_triangles triangles of vertices; the vertices are not
+copied, and must outlive the tree. triangle_indexes must have nbr_triangles elements,
+and nodes max_nodes elements, at least BVH_MAX_NODES(nbr_triangles). Return false if
+the memory is not valid.
+*/
+bool bvh_build(BVH * bvh, Vec3 const * vertices, size_t nbr_triangles, size_t * triangle_indexes, BVH_Node * nodes, size_t max_nodes);
+
+/*
+Moller-Trumbore intersection of the ray origin + t direction, t in [0, max_distance],
+with the triangle (v_0, v_1, v_2). Return true if they intersect, and then fill the
+distance and barycentric coordinates of hit (the triangle is not changed).
+*/
+bool ray_triangle_intersect(Vec3 const * origin, Vec3 const * direction, Vec3 const * v_0, Vec3 const * v_1, Vec3 const * v_2, F_TYPE max_distance, Ray_Hit * hit);
+
+/*
+Closest hit of a single ray, with t in [0, max_distance]. Return true if there is one.
+*/
+bool bvh_intersect(BVH const * bvh, Vec3 const * origin, Vec3 const * direction, F_TYPE max_distance, Ray_Hit * hit);
+
+/*
+Closest hits of the rays (origins[n], directions[n]), traced in packets; hits has
+one element per ray. Return the number of rays that hit something.
+*/
+size_t bvh_intersect_batch(BVH const * bvh, Vec3_View const * origins, Vec3_View const * directions, F_TYPE max_distance, Ray_Hit * hits);
+
+/*
+Same as bvh_intersect_batch, for rays all starting from the origin of a sensor frame,
+with directions expressed in the sensor frame: the directions are rotated by
+frame_rotation (as rotate_by_quat_R) packet by packet, so that a scan pattern can be
+cast from any pose without transforming it first.
+*/
+size_t bvh_intersect_from_frame(BVH const * bvh, Vec3 const * frame_origin, Quat const * frame_rotation, Vec3_View const * directions, F_TYPE max_distance, Ray_Hit * hits);
+
+#endif
@@ -0,0 +1,236 @@
+#ifndef KISS_CLANG_3D_CONSTEXPR_H
+#define KISS_CLANG_3D_CONSTEXPR_H
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// Optional, header only, C++17 layer to build Vec3 and Quat of the default precision
+// (F_TYPE) at compile time, for example tables of fixed rotations:
+//
+//     constexpr Quat mountings[] {
+//         kiss3d::cx::from_axis_angle(Vec3 {0.0, 0.0, 1.0}, F_TYPE_PI / 2.0),
+//         kiss3d::cx::prod(kiss3d::cx::from_axis_angle(Vec3 {1.0, 0.0, 0.0}, F_TYPE_PI), ...),
+//     };
+//
+// these are then folded by the compiler into read only data, with no call to cos / sin /
+// sqrt at startup. The functions can also be called at runtime, but are slower than the
+// ones from the C API there: only use them for constants.
+//
+// The trigonometric functions and the square root are computed in double (range reduction,
+// Taylor series, Newton iterations) and are accurate to a few ulps of a double, so that the
+// results match the runtime functions up to the precision of F_TYPE. The only floating
+// point literal used is F_TYPE_PI_d, so that the header also compiles cleanly with
+// -fsingle-precision-constant (pi is then only accurate to a float).
+
+#include "./kiss_clang_3d.h"
+
+namespace kiss3d {
+namespace cx {
+
+// ------------------------------------------------------------
+// MATHS
+// ------------------------------------------------------------
+
+/*
+Square root, by Newton iterations. Starting above the root, the iterates decrease strictly
+until they reach it; stop as soon as they do not decrease any more.
+Returns 0 for x <= 0.
+*/
+constexpr double sqrt(double x){
+    if (!(x > 0)){
+        return 0;
+    }
+
+    double crrt = (x > 1) ? x : 1;
+    while (true){
+        double next = (crrt + x / crrt) / 2;
+        if (!(next < crrt)){
+            return crrt;
+        }
+        crrt = next;
+    }
+}
+
+namespace detail {
+
+// sin and cos of x in [-pi/4, pi/4], by their Taylor series; the terms are built by
+// recurrence and added until they do not change the sum any more
+constexpr double sin_reduced(double x){
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 20; n++){
+        term *= -x * x / static_cast<double>((2 * n) * (2 * n + 1));
+        double next = sum + term;
+        if (next == sum){
+            break;
+        }
+        sum = next;
+    }
+    return sum;
+}
+
+constexpr double cos_reduced(double x){
+    double term = 1;
+    double sum = 1;
+    for (int n = 1; n < 20; n++){
+        term *= -x * x / static_cast<double>((2 * n - 1) * (2 * n));
+        double next = sum + term;
+        if (next == sum){
+            break;
+        }
+        sum = next;
+    }
+    return sum;
+}
+
+// x = quadrant * pi / 2 + reduced, with reduced in [-pi/4, pi/4]
+constexpr long long quadrant_of(double x){
+    double half_pi = F_TYPE_PI_d;
+    half_pi /= 2;
+
+    double x_o_half_pi = x / half_pi;
+    long long quadrant = static_cast<long long>(x_o_half_pi);
+    double remainder = x_o_half_pi - static_cast<double>(quadrant);
+    if (2 * remainder > 1){
+        quadrant++;
+    }
+    else if (2 * remainder < -1){
+        quadrant--;
+    }
+    return quadrant;
+}
+
+constexpr double reduced_of(double x, long long quadrant){
+    double half_pi = F_TYPE_PI_d;
+    half_pi /= 2;
+    return x - static_cast<double>(quadrant) * half_pi;
+}
+
+}  // namespace detail
+
+/*
+Sine of x (in radians).
+*/
+constexpr double sin(double x){
+    long long quadrant = detail::quadrant_of(x);
+    double reduced = detail::reduced_of(x, quadrant);
+
+    switch (quadrant & 3){
+        case 0:
+            return detail::sin_reduced(reduced);
+        case 1:
+            return detail::cos_reduced(reduced);
+        case 2:
+            return -detail::sin_reduced(reduced);
+        default:
+            return -detail::cos_reduced(reduced);
+    }
+}
+
+/*
+Cosine of x (in radians).
+*/
+constexpr double cos(double x){
+    long long quadrant = detail::quadrant_of(x);
+    double reduced = detail::reduced_of(x, quadrant);
+
+    switch (quadrant & 3){
+        case 0:
+            return detail::cos_reduced(reduced);
+        case 1:
+            return -detail::sin_reduced(reduced);
+        case 2:
+            return -detail::cos_reduced(reduced);
+        default:
+            return detail::sin_reduced(reduced);
+    }
+}
+
+// ------------------------------------------------------------
+// VEC3 AND QUAT
+// ------------------------------------------------------------
+
+/*
+Norm of the vector.
+*/
+constexpr F_TYPE norm(Vec3 const & v){
+    double vi = F_TYPE_TO_DOUBLE(v.i);
+    double vj = F_TYPE_TO_DOUBLE(v.j);
+    double vk = F_TYPE_TO_DOUBLE(v.k);
+    return F_TYPE_FROM_DOUBLE(sqrt(vi * vi + vj * vj + vk * vk));
+}
+
+/*
+Normalized copy of the vector; the null vector is returned unchanged.
+*/
+constexpr Vec3 normalize(Vec3 const & v){
+    F_TYPE v_norm = norm(v);
+    if (v_norm == F_TYPE_0){
+        return v;
+    }
+    return Vec3 {v.i / v_norm, v.j / v_norm, v.k / v_norm};
+}
+
+/*
+Unit quaternion of the rotation of angle rotation_angle_rad around rotation_axis, as
+rotation_to_quat. The axis does not need to be normalized. A null axis gives the identity
+(while rotation_to_quat reports an error if the angle is not 0 too).
+*/
+constexpr Quat from_axis_angle(Vec3 const & rotation_axis, F_TYPE rotation_angle_rad){
+    double ai = F_TYPE_TO_DOUBLE(rotation_axis.i);
+    double aj = F_TYPE_TO_DOUBLE(rotation_axis.j);
+    double ak = F_TYPE_TO_DOUBLE(rotation_axis.k);
+    double norm_of_axis = sqrt(ai * ai + aj * aj + ak * ak);
+
+    if (norm_of_axis == 0){
+        return Quat {F_TYPE_1, F_TYPE_0, F_TYPE_0, F_TYPE_0};
+    }
+
+    double half_rotation_angle = F_TYPE_TO_DOUBLE(rotation_angle_rad) / 2;
+    double cos_of_half = cos(half_rotation_angle);
+    double sin_of_half = sin(half_rotation_angle);
+
+    return Quat {
+        F_TYPE_FROM_DOUBLE(cos_of_half),
+        F_TYPE_FROM_DOUBLE(ai / norm_of_axis * sin_of_half),
+        F_TYPE_FROM_DOUBLE(aj / norm_of_axis * sin_of_half),
+        F_TYPE_FROM_DOUBLE(ak / norm_of_axis * sin_of_half)
+    };
+}
+
+/*
+Quaternion product q_left * q_right, as quat_prod; composing rotations: the rotation
+q_right is applied first.
+*/
+constexpr Quat prod(Quat const & q_left, Quat const & q_right){
+    return Quat {
+        q_left.r * q_right.r  -  q_left.i * q_right.i  -  q_left.j * q_right.j  -  q_left.k * q_right.k,
+        q_left.r * q_right.i  +  q_left.i * q_right.r  +  q_left.j * q_right.k  -  q_left.k * q_right.j,
+        q_left.r * q_right.j  -  q_left.i * q_right.k  +  q_left.j * q_right.r  +  q_left.k * q_right.i,
+        q_left.r * q_right.k  +  q_left.i * q_right.j  -  q_left.j * q_right.i  +  q_left.k * q_right.r
+    };
+}
+
+/*
+Conjugate of the quaternion, i.e. the inverse rotation for a unit quaternion.
+*/
+constexpr Quat conj(Quat const & q){
+    return Quat {q.r, -q.i, -q.j, -q.k};
+}
+
+/*
+Rotation of v by the unit quaternion q, as rotate_by_quat_R.
+*/
+constexpr Vec3 rotate(Quat const & q, Vec3 const & v){
+    F_TYPE u_dot_v = q.i * v.i + q.j * v.j + q.k * v.k;
+    F_TYPE s2m05 = q.r * q.r - F_TYPE_05;
+    return Vec3 {
+        F_TYPE_2 * ( u_dot_v * q.i + s2m05 * v.i + q.r * ( q.j * v.k - q.k * v.j ) ),
+        F_TYPE_2 * ( u_dot_v * q.j + s2m05 * v.j + q.r * ( q.k * v.i - q.i * v.k ) ),
+        F_TYPE_2 * ( u_dot_v * q.k + s2m05 * v.k + q.r * ( q.i * v.j - q.j * v.i ) )
+    };
+}
+
+}  // namespace cx
+}  // namespace kiss3d
+
+#endif
@@ -0,0 +1,194 @@
+#ifndef KISS_CLANG_3D_EULER_H
+#define KISS_CLANG_3D_EULER_H
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// Optional, header only, C++ conversions between Euler angles and Quat, in the default
+// precision (F_TYPE), for the 12 axis sequences: the 6 Tait-Bryan ones (3 different
+// axes, e.g. K, J, I for yaw, pitch, roll) and the 6 proper Euler ones (first and third
+// axes equal, e.g. K, I, K). The sequence is a template parameter, so that each sequence
+// gets its own straight line code, without any switch at runtime:
+//
+//     Vec3 const yaw_pitch_roll {yaw, pitch, roll};
+//     Quat q = kiss3d::euler_to_quat<kiss3d::Axis::K, kiss3d::Axis::J, kiss3d::Axis::I>(yaw_pitch_roll);
+//
+// The 3 angles (in rad) are stored in a Vec3, in the order of the sequence (i: first, j:
+// second, k: third). The rotations are intrinsic, i.e. around the axes moved by the
+// previous rotations: q = q_first * q_second * q_third. An extrinsic sequence (around the
+// fixed axes) a, b, c with angles x, y, z is the intrinsic sequence c, b, a with angles
+// z, y, x.
+
+#include "./kiss_clang_3d.h"
+#include "./kiss_clang_3d_axes.h"
+
+namespace kiss3d {
+
+namespace detail {
+
+constexpr int axis_index(Axis axis){
+    return axis == Axis::I ? 0 : (axis == Axis::J ? 1 : 2);
+}
+
+constexpr F_TYPE quat_component(Quat const & q, int index){
+    return index == 0 ? q.i : (index == 1 ? q.j : q.k);
+}
+
+// q * [cos_half, sin_half * axis], without the products by the 0 components
+template <Axis axis>
+Quat prod_by_axis_rotation(Quat const & q, F_TYPE cos_half, F_TYPE sin_half);
+
+template <>
+inline Quat prod_by_axis_rotation<Axis::I>(Quat const & q, F_TYPE cos_half, F_TYPE sin_half){
+    return Quat {q.r * cos_half - q.i * sin_half, q.r * sin_half + q.i * cos_half, q.j * cos_half + q.k * sin_half, q.k * cos_half - q.j * sin_half};
+}
+
+template <>
+inline Quat prod_by_axis_rotation<Axis::J>(Quat const & q, F_TYPE cos_half, F_TYPE sin_half){
+    return Quat {q.r * cos_half - q.j * sin_half, q.i * cos_half - q.k * sin_half, q.r * sin_half + q.j * cos_half, q.i * sin_half + q.k * cos_half};
+}
+
+template <>
+inline Quat prod_by_axis_rotation<Axis::K>(Quat const & q, F_TYPE cos_half, F_TYPE sin_half){
+    return Quat {q.r * cos_half - q.k * sin_half, q.i * cos_half + q.j * sin_half, q.j * cos_half - q.i * sin_half, q.r * sin_half + q.k * cos_half};
+}
+
+inline F_TYPE wrap_angle(F_TYPE angle){
+    if (angle < -F_TYPE_PI){
+        return angle + F_TYPE_2 * F_TYPE_PI;
+    }
+    if (angle > F_TYPE_PI){
+        return angle - F_TYPE_2 * F_TYPE_PI;
+    }
+    return angle;
+}
+
+}  // namespace detail
+
+/*
+Unit quaternion of the intrinsic rotations of angles (first, second, third) around the
+axes of the sequence.
+*/
+template <Axis first, Axis second, Axis third>
+Quat euler_to_quat(Vec3 const & angles){
+    static_assert(first != second && second != third, "consecutive axes of an Euler sequence must be different");
+
+    Quat const q_first = rotate_about<first>(angles.i);
+    Quat const q_first_second = detail::prod_by_axis_rotation<second>(q_first, F_TYPE_COS(angles.j / F_TYPE_2), F_TYPE_SIN(angles.j / F_TYPE_2));
+    return detail::prod_by_axis_rotation<third>(q_first_second, F_TYPE_COS(angles.k / F_TYPE_2), F_TYPE_SIN(angles.k / F_TYPE_2));
+}
+
+/*
+Euler angles of the unit quaternion q, for the sequence, using the direct method of
+"Quaternion to Euler angles conversion: A direct, general and computationally efficient
+method", Bernardes and Viollet, 2022. The first and third angles are in [-pi, pi]; the
+second angle is in [-pi / 2, pi / 2] for Tait-Bryan sequences, and in [0, pi] for proper
+Euler sequences.
+At the gimbal lock (the second angle is, up to tolerance, at one of the bounds of its
+range), only the sum or difference of the first and third angles is defined: the first
+angle is then set to 0, and the third one carries the rotation. If gimbal_lock is not
+null, it tells if this is the case.
+*/
+template <Axis first, Axis second, Axis third>
+Vec3 quat_to_euler(Quat const & q, bool * gimbal_lock=nullptr, F_TYPE tolerance=DEFAULT_TOL){
+    static_assert(first != second && second != third, "consecutive axes of an Euler sequence must be different");
+
+    // the method is written for extrinsic sequences: use the reversed sequence
+    constexpr int i = detail::axis_index(third);
+    constexpr int j = detail::axis_index(second);
+    constexpr bool proper_euler = (first == third);
+    constexpr int k = proper_euler ? 3 - i - j : detail::axis_index(first);
+    // +1 for an even permutation of the axes, -1 for an odd one
+    constexpr int permutation_sign = (i - j) * (j - k) * (k - i) / 2;
+    F_TYPE const sign = permutation_sign > 0 ? F_TYPE_1 : -F_TYPE_1;
+
+    F_TYPE const q_i = detail::quat_component(q, i);
+    F_TYPE const q_j = detail::quat_component(q, j);
+    F_TYPE const q_k = detail::quat_component(q, k) * sign;
+
+    F_TYPE a = q.r;
+    F_TYPE b = q_i;
+    F_TYPE c = q_j;
+    F_TYPE d = q_k;
+    if (!proper_euler){
+        a = q.r - q_j;
+        b = q_i + q_k;
+        c = q_j + q.r;
+        d = q_k - q_i;
+    }
+
+    F_TYPE angle_first;
+    F_TYPE angle_second = F_TYPE_2 * F_TYPE_ATAN2(F_TYPE_SQRT(c * c + d * d), F_TYPE_SQRT(a * a + b * b));
+    F_TYPE angle_third;
+
+    bool const lock_at_0 = F_TYPE_ABS(angle_second) <= tolerance;
+    bool const lock_at_pi = F_TYPE_ABS(angle_second - F_TYPE_PI) <= tolerance;
+
+    F_TYPE const half_sum = F_TYPE_ATAN2(b, a);
+    F_TYPE const half_diff = F_TYPE_ATAN2(d, c);
+
+    // at the gimbal locks, half_diff (resp. half_sum) is not defined; choose the
+    // angle_third = 0 solution (i.e. the first angle of the intrinsic sequence)
+    if (lock_at_0){
+        angle_first = F_TYPE_2 * half_sum;
+        angle_third = F_TYPE_0;
+    }
+    else if (lock_at_pi){
+        angle_first = -F_TYPE_2 * half_diff;
+        angle_third = F_TYPE_0;
+    }
+    else{
+        angle_first = half_sum - half_diff;
+        angle_third = half_sum + half_diff;
+    }
+
+    if (!proper_euler){
+        angle_third *= sign;
+        angle_second -= F_TYPE_PI / F_TYPE_2;
+    }
+
+    if (gimbal_lock != nullptr){
+        *gimbal_lock = lock_at_0 || lock_at_pi;
+    }
+
+    // back to the intrinsic sequence
+    return Vec3 {detail::wrap_angle(angle_third), detail::wrap_angle(angle_second), detail::wrap_angle(angle_first)};
+}
+
+/*
+Batch versions, over views, with the same conventions as the other batch functions.
+quat_to_euler_batch returns the number of quaternions at the gimbal lock.
+*/
+template <Axis first, Axis second, Axis third>
+void euler_to_quat_batch(Vec3_View const * angles_in, Quat_View const * q_out){
+    size_t count = angles_in->count < q_out->count ? angles_in->count : q_out->count;
+    Vec3 crrt_in;
+
+    for (size_t n = 0; n < count; n++){
+        vec3_view_get(angles_in, n, &crrt_in);
+        Quat const crrt_out = euler_to_quat<first, second, third>(crrt_in);
+        quat_view_set(q_out, n, &crrt_out);
+    }
+}
+
+template <Axis first, Axis second, Axis third>
+size_t quat_to_euler_batch(Quat_View const * q_in, Vec3_View const * angles_out, F_TYPE tolerance=DEFAULT_TOL){
+    size_t count = q_in->count < angles_out->count ? q_in->count : angles_out->count;
+    size_t nbr_gimbal_locks = 0;
+    Quat crrt_in;
+    bool gimbal_lock;
+
+    for (size_t n = 0; n < count; n++){
+        quat_view_get(q_in, n, &crrt_in);
+        Vec3 const crrt_out = quat_to_euler<first, second, third>(crrt_in, &gimbal_lock, tolerance);
+        if (gimbal_lock){
+            nbr_gimbal_locks++;
+        }
+        vec3_view_set(angles_out, n, &crrt_out);
+    }
+
+    return nbr_gimbal_locks;
+}
+
+}  // namespace kiss3d
+
+#endif
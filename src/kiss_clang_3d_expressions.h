@@ -0,0 +1,495 @@
+#ifndef KISS_CLANG_3D_EXPRESSIONS_H
+#define KISS_CLANG_3D_EXPRESSIONS_H
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// Optional, header only, C++ layer over the Vec3 and Quat of the default precision
+// (F_TYPE), with the usual operators. The operators do not compute anything: they
+// build expression templates, that are evaluated only when assigned, component by
+// component, without any temporary. The same expressions work on single vectors /
+// quaternions (vec3, quat) and on arrays of them (vec3_array, quat_array); the
+// assignment to an array evaluates the whole expression in a single loop, for example:
+//
+//     kiss3d::vec3_array out(out_ptr, count), a(a_ptr, count), b(b_ptr, count), c(c_ptr, count);
+//     kiss3d::vec3 const d {1.0, 2.0, 3.0};
+//     out = a * s + kiss3d::cross(b, c) - d;
+//
+// Single vectors and scalars are broadcast over the arrays. The arrays are non owning
+// views over the caller memory, and all the arrays of an expression must have at least
+// the size of the array assigned to.
+//
+// Each node of an expression is evaluated once per element, into a local Vec3 / Quat,
+// so that for example rotate(qa * qb, v) computes the product once per vector, as the
+// hand written loop would.
+//
+// The expressions keep references to their terminals (vectors, quaternions, arrays):
+// assign them in the statement that builds them. An expression stored in an auto
+// variable dangles if any of its terminals was a temporary, for example
+// auto e = a + kiss3d::vec3(1.0, 2.0, 3.0);
+
+#include "./kiss_clang_3d.h"
+
+namespace kiss3d {
+
+// ------------------------------------------------------------
+// EXPRESSIONS BASES
+// ------------------------------------------------------------
+
+// every expression E provides its value for the element number n, all the components
+// at once; the bases are only used to select the operators (CRTP).
+
+// E provides: F_TYPE value(size_t n) const
+template <typename E>
+struct scalar_expr {
+    E const & self() const { return static_cast<E const &>(*this); }
+};
+
+// E provides: Vec3 at(size_t n) const
+template <typename E>
+struct vec3_expr {
+    E const & self() const { return static_cast<E const &>(*this); }
+};
+
+// E provides: Quat at(size_t n) const
+template <typename E>
+struct quat_expr {
+    E const & self() const { return static_cast<E const &>(*this); }
+};
+
+// the intermediate nodes are kept by value in the expressions (they are temporaries),
+// while the terminals (vectors, quaternions, arrays) are kept by reference, so that
+// they must outlive the expression.
+template <typename E>
+struct stored {
+    typedef E const type;
+};
+
+// ------------------------------------------------------------
+// TERMINALS
+// ------------------------------------------------------------
+
+// --------------------------------------------------
+// a scalar constant, broadcast over all the elements
+struct scalar : scalar_expr<scalar> {
+    F_TYPE value_;
+
+    explicit scalar(F_TYPE value_in) : value_(value_in) {}
+    F_TYPE value(size_t) const { return value_; }
+};
+
+// --------------------------------------------------
+// a single 3D vector, broadcast over all the elements
+struct vec3 : vec3_expr<vec3> {
+    Vec3 data;
+
+    vec3() : data {F_TYPE_0, F_TYPE_0, F_TYPE_0} {}
+    vec3(F_TYPE vi, F_TYPE vj, F_TYPE vk) : data {vi, vj, vk} {}
+    vec3(Vec3 const & v) : data (v) {}
+
+    template <typename E>
+    vec3(vec3_expr<E> const & e) : data {F_TYPE_0, F_TYPE_0, F_TYPE_0} { *this = e; }
+
+    // evaluate all the components before writing, so that the expression may use *this
+    template <typename E>
+    vec3 & operator=(vec3_expr<E> const & e){
+        data = e.self().at(0);
+        return *this;
+    }
+
+    Vec3 at(size_t) const { return data; }
+};
+
+template <>
+struct stored<vec3> {
+    typedef vec3 const & type;
+};
+
+// --------------------------------------------------
+// a single quaternion, broadcast over all the elements
+struct quat : quat_expr<quat> {
+    Quat data;
+
+    quat() : data {F_TYPE_1, F_TYPE_0, F_TYPE_0, F_TYPE_0} {}
+    quat(F_TYPE qr, F_TYPE qi, F_TYPE qj, F_TYPE qk) : data {qr, qi, qj, qk} {}
+    quat(Quat const & q) : data (q) {}
+
+    template <typename E>
+    quat(quat_expr<E> const & e) : data {F_TYPE_1, F_TYPE_0, F_TYPE_0, F_TYPE_0} { *this = e; }
+
+    template <typename E>
+    quat & operator=(quat_expr<E> const & e){
+        data = e.self().at(0);
+        return *this;
+    }
+
+    Quat at(size_t) const { return data; }
+};
+
+template <>
+struct stored<quat> {
+    typedef quat const & type;
+};
+
+// --------------------------------------------------
+// non owning view over a contiguous array of Vec3
+struct vec3_array : vec3_expr<vec3_array> {
+    Vec3 * data;
+    size_t count;
+
+    vec3_array(Vec3 * data_in, size_t count_in) : data(data_in), count(count_in) {}
+
+    // assignments copy the elements, not the view
+    vec3_array & operator=(vec3_array const & other){
+        return *this = static_cast<vec3_expr<vec3_array> const &>(other);
+    }
+
+    // the whole expression is evaluated in one pass over the elements
+    template <typename E>
+    vec3_array & operator=(vec3_expr<E> const & e){
+        E const & expression = e.self();
+        for (size_t n = 0; n < count; n++){
+            data[n] = expression.at(n);
+        }
+        return *this;
+    }
+
+    Vec3 at(size_t n) const { return data[n]; }
+};
+
+template <>
+struct stored<vec3_array> {
+    typedef vec3_array const & type;
+};
+
+// --------------------------------------------------
+// non owning view over a contiguous array of Quat
+struct quat_array : quat_expr<quat_array> {
+    Quat * data;
+    size_t count;
+
+    quat_array(Quat * data_in, size_t count_in) : data(data_in), count(count_in) {}
+
+    quat_array & operator=(quat_array const & other){
+        return *this = static_cast<quat_expr<quat_array> const &>(other);
+    }
+
+    template <typename E>
+    quat_array & operator=(quat_expr<E> const & e){
+        E const & expression = e.self();
+        for (size_t n = 0; n < count; n++){
+            data[n] = expression.at(n);
+        }
+        return *this;
+    }
+
+    Quat at(size_t n) const { return data[n]; }
+};
+
+template <>
+struct stored<quat_array> {
+    typedef quat_array const & type;
+};
+
+// ------------------------------------------------------------
+// VEC3 NODES
+// ------------------------------------------------------------
+
+template <typename L, typename R>
+struct vec3_sum : vec3_expr<vec3_sum<L, R>> {
+    typename stored<L>::type left;
+    typename stored<R>::type right;
+
+    vec3_sum(L const & left_in, R const & right_in) : left(left_in), right(right_in) {}
+
+    Vec3 at(size_t n) const {
+        Vec3 const l = left.at(n);
+        Vec3 const r = right.at(n);
+        return Vec3 {l.i + r.i, l.j + r.j, l.k + r.k};
+    }
+};
+
+template <typename L, typename R>
+struct vec3_difference : vec3_expr<vec3_difference<L, R>> {
+    typename stored<L>::type left;
+    typename stored<R>::type right;
+
+    vec3_difference(L const & left_in, R const & right_in) : left(left_in), right(right_in) {}
+
+    Vec3 at(size_t n) const {
+        Vec3 const l = left.at(n);
+        Vec3 const r = right.at(n);
+        return Vec3 {l.i - r.i, l.j - r.j, l.k - r.k};
+    }
+};
+
+template <typename E>
+struct vec3_negation : vec3_expr<vec3_negation<E>> {
+    typename stored<E>::type operand;
+
+    explicit vec3_negation(E const & operand_in) : operand(operand_in) {}
+
+    Vec3 at(size_t n) const {
+        Vec3 const v = operand.at(n);
+        return Vec3 {-v.i, -v.j, -v.k};
+    }
+};
+
+template <typename S, typename E>
+struct vec3_scaling : vec3_expr<vec3_scaling<S, E>> {
+    typename stored<S>::type scale;
+    typename stored<E>::type operand;
+
+    vec3_scaling(S const & scale_in, E const & operand_in) : scale(scale_in), operand(operand_in) {}
+
+    Vec3 at(size_t n) const {
+        F_TYPE const s = scale.value(n);
+        Vec3 const v = operand.at(n);
+        return Vec3 {s * v.i, s * v.j, s * v.k};
+    }
+};
+
+template <typename L, typename R>
+struct vec3_cross_product : vec3_expr<vec3_cross_product<L, R>> {
+    typename stored<L>::type left;
+    typename stored<R>::type right;
+
+    vec3_cross_product(L const & left_in, R const & right_in) : left(left_in), right(right_in) {}
+
+    // same formula as vec3_cross
+    Vec3 at(size_t n) const {
+        Vec3 const l = left.at(n);
+        Vec3 const r = right.at(n);
+        return Vec3 {
+             l.j * r.k - l.k * r.j,
+            -l.i * r.k + l.k * r.i,
+             l.i * r.j - l.j * r.i
+        };
+    }
+};
+
+template <typename L, typename R>
+struct vec3_scalar_product : scalar_expr<vec3_scalar_product<L, R>> {
+    typename stored<L>::type left;
+    typename stored<R>::type right;
+
+    vec3_scalar_product(L const & left_in, R const & right_in) : left(left_in), right(right_in) {}
+
+    F_TYPE value(size_t n) const {
+        Vec3 const l = left.at(n);
+        Vec3 const r = right.at(n);
+        return l.i * r.i + l.j * r.j + l.k * r.k;
+    }
+};
+
+// rotation of a vector by a unit quaternion, same formula as rotate_by_quat_R
+template <typename Q, typename V>
+struct vec3_rotation : vec3_expr<vec3_rotation<Q, V>> {
+    typename stored<Q>::type q;
+    typename stored<V>::type v;
+
+    vec3_rotation(Q const & q_in, V const & v_in) : q(q_in), v(v_in) {}
+
+    Vec3 at(size_t n) const {
+        Quat const qn = q.at(n);
+        Vec3 const vn = v.at(n);
+        F_TYPE const u_dot_v = qn.i * vn.i + qn.j * vn.j + qn.k * vn.k;
+        F_TYPE const s2m05 = qn.r * qn.r - F_TYPE_05;
+        return Vec3 {
+            F_TYPE_2 * ( u_dot_v * qn.i + s2m05 * vn.i + qn.r * ( qn.j * vn.k - qn.k * vn.j ) ),
+            F_TYPE_2 * ( u_dot_v * qn.j + s2m05 * vn.j + qn.r * ( qn.k * vn.i - qn.i * vn.k ) ),
+            F_TYPE_2 * ( u_dot_v * qn.k + s2m05 * vn.k + qn.r * ( qn.i * vn.j - qn.j * vn.i ) )
+        };
+    }
+};
+
+// ------------------------------------------------------------
+// QUAT NODES
+// ------------------------------------------------------------
+
+template <typename L, typename R>
+struct quat_sum : quat_expr<quat_sum<L, R>> {
+    typename stored<L>::type left;
+    typename stored<R>::type right;
+
+    quat_sum(L const & left_in, R const & right_in) : left(left_in), right(right_in) {}
+
+    Quat at(size_t n) const {
+        Quat const l = left.at(n);
+        Quat const r = right.at(n);
+        return Quat {l.r + r.r, l.i + r.i, l.j + r.j, l.k + r.k};
+    }
+};
+
+template <typename L, typename R>
+struct quat_difference : quat_expr<quat_difference<L, R>> {
+    typename stored<L>::type left;
+    typename stored<R>::type right;
+
+    quat_difference(L const & left_in, R const & right_in) : left(left_in), right(right_in) {}
+
+    Quat at(size_t n) const {
+        Quat const l = left.at(n);
+        Quat const r = right.at(n);
+        return Quat {l.r - r.r, l.i - r.i, l.j - r.j, l.k - r.k};
+    }
+};
+
+template <typename S, typename E>
+struct quat_scaling : quat_expr<quat_scaling<S, E>> {
+    typename stored<S>::type scale;
+    typename stored<E>::type operand;
+
+    quat_scaling(S const & scale_in, E const & operand_in) : scale(scale_in), operand(operand_in) {}
+
+    Quat at(size_t n) const {
+        F_TYPE const s = scale.value(n);
+        Quat const q = operand.at(n);
+        return Quat {s * q.r, s * q.i, s * q.j, s * q.k};
+    }
+};
+
+template <typename E>
+struct quat_conjugate : quat_expr<quat_conjugate<E>> {
+    typename stored<E>::type operand;
+
+    explicit quat_conjugate(E const & operand_in) : operand(operand_in) {}
+
+    Quat at(size_t n) const {
+        Quat const q = operand.at(n);
+        return Quat {q.r, -q.i, -q.j, -q.k};
+    }
+};
+
+// same formula as quat_prod
+template <typename L, typename R>
+struct quat_product : quat_expr<quat_product<L, R>> {
+    typename stored<L>::type left;
+    typename stored<R>::type right;
+
+    quat_product(L const & left_in, R const & right_in) : left(left_in), right(right_in) {}
+
+    Quat at(size_t n) const {
+        Quat const l = left.at(n);
+        Quat const r = right.at(n);
+        return Quat {
+            l.r * r.r  -  l.i * r.i  -  l.j * r.j  -  l.k * r.k,
+            l.r * r.i  +  l.i * r.r  +  l.j * r.k  -  l.k * r.j,
+            l.r * r.j  -  l.i * r.k  +  l.j * r.r  +  l.k * r.i,
+            l.r * r.k  +  l.i * r.j  -  l.j * r.i  +  l.k * r.r
+        };
+    }
+};
+
+// ------------------------------------------------------------
+// OPERATORS AND FUNCTIONS
+// ------------------------------------------------------------
+
+// --------------------------------------------------
+// vectors
+
+template <typename L, typename R>
+vec3_sum<L, R> operator+(vec3_expr<L> const & left, vec3_expr<R> const & right){
+    return vec3_sum<L, R>(left.self(), right.self());
+}
+
+template <typename L, typename R>
+vec3_difference<L, R> operator-(vec3_expr<L> const & left, vec3_expr<R> const & right){
+    return vec3_difference<L, R>(left.self(), right.self());
+}
+
+template <typename E>
+vec3_negation<E> operator-(vec3_expr<E> const & operand){
+    return vec3_negation<E>(operand.self());
+}
+
+template <typename S, typename E>
+vec3_scaling<S, E> operator*(scalar_expr<S> const & scale, vec3_expr<E> const & operand){
+    return vec3_scaling<S, E>(scale.self(), operand.self());
+}
+
+template <typename S, typename E>
+vec3_scaling<S, E> operator*(vec3_expr<E> const & operand, scalar_expr<S> const & scale){
+    return vec3_scaling<S, E>(scale.self(), operand.self());
+}
+
+template <typename E>
+vec3_scaling<scalar, E> operator*(F_TYPE scale, vec3_expr<E> const & operand){
+    return vec3_scaling<scalar, E>(scalar(scale), operand.self());
+}
+
+template <typename E>
+vec3_scaling<scalar, E> operator*(vec3_expr<E> const & operand, F_TYPE scale){
+    return vec3_scaling<scalar, E>(scalar(scale), operand.self());
+}
+
+template <typename E>
+vec3_scaling<scalar, E> operator/(vec3_expr<E> const & operand, F_TYPE scale){
+    return vec3_scaling<scalar, E>(scalar(F_TYPE_1 / scale), operand.self());
+}
+
+template <typename L, typename R>
+vec3_cross_product<L, R> cross(vec3_expr<L> const & left, vec3_expr<R> const & right){
+    return vec3_cross_product<L, R>(left.self(), right.self());
+}
+
+/*
+Scalar product; this is itself a (scalar) expression, that can be used for example to
+scale vectors element wise. Use value(0) to get the number for single vectors.
+*/
+template <typename L, typename R>
+vec3_scalar_product<L, R> dot(vec3_expr<L> const & left, vec3_expr<R> const & right){
+    return vec3_scalar_product<L, R>(left.self(), right.self());
+}
+
+/*
+Rotate vectors by unit quaternions (see rotate_by_quat_R)
+*/
+template <typename Q, typename V>
+vec3_rotation<Q, V> rotate(quat_expr<Q> const & q, vec3_expr<V> const & v){
+    return vec3_rotation<Q, V>(q.self(), v.self());
+}
+
+// --------------------------------------------------
+// quaternions
+
+template <typename L, typename R>
+quat_sum<L, R> operator+(quat_expr<L> const & left, quat_expr<R> const & right){
+    return quat_sum<L, R>(left.self(), right.self());
+}
+
+template <typename L, typename R>
+quat_difference<L, R> operator-(quat_expr<L> const & left, quat_expr<R> const & right){
+    return quat_difference<L, R>(left.self(), right.self());
+}
+
+template <typename S, typename E>
+quat_scaling<S, E> operator*(scalar_expr<S> const & scale, quat_expr<E> const & operand){
+    return quat_scaling<S, E>(scale.self(), operand.self());
+}
+
+template <typename E>
+quat_scaling<scalar, E> operator*(F_TYPE scale, quat_expr<E> const & operand){
+    return quat_scaling<scalar, E>(scalar(scale), operand.self());
+}
+
+template <typename E>
+quat_scaling<scalar, E> operator*(quat_expr<E> const & operand, F_TYPE scale){
+    return quat_scaling<scalar, E>(scalar(scale), operand.self());
+}
+
+/*
+Hamilton product (see quat_prod)
+*/
+template <typename L, typename R>
+quat_product<L, R> operator*(quat_expr<L> const & left, quat_expr<R> const & right){
+    return quat_product<L, R>(left.self(), right.self());
+}
+
+template <typename E>
+quat_conjugate<E> conj(quat_expr<E> const & operand){
+    return quat_conjugate<E>(operand.self());
+}
+
+}  // namespace kiss3d
+
+#endif
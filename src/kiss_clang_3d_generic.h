@@ -0,0 +1,635 @@
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// This file is written once, in terms of F_TYPE, Vec3, Quat, etc, and is included
+// by kiss_clang_3d.h once per precision (see the PRECISIONS section there), with the
+// names mapped to their _f (float) or _d (double) suffixed version. It is not meant
+// to be included directly, and has on purpose no include guard.
+
+// ------------------------------------------------------------
+// STRUCTS
+// ------------------------------------------------------------
+
+// --------------------------------------------------
+// 3D vector, components i, j, k
+struct Vec3 {
+    F_TYPE i;
+    F_TYPE j;
+    F_TYPE k;
+};
+
+// --------------------------------------------------
+// quaternion, with real part (r), and components (i, i, k)
+struct Quat {
+    F_TYPE r;
+    F_TYPE i;
+    F_TYPE j;
+    F_TYPE k;
+};
+
+// --------------------------------------------------
+// vector angle rotation varot, provided as a vector (v_i,j,k) and an angle in rads (a)
+struct VA_Rot {
+    Vec3 axis;
+    F_TYPE angle_rad;
+};
+
+// --------------------------------------------------
+// limits of a joint, for quat_clamp_to_limits: the rotation is decomposed into a twist
+// around the (unit) twist axis, and a swing that moves the twist axis; the swing angle
+// must be at most the swing max (a cone around the twist axis), and the twist angle
+// must be between the twist min and max. The cos and sin of the half limit angles are
+// computed once by joint_limits_setter, so that the clamping needs no trigonometry.
+struct Joint_Limits {
+    Vec3 twist_axis;
+    F_TYPE cos_half_swing_max;
+    F_TYPE sin_half_swing_max;
+    F_TYPE cos_half_twist_min;
+    F_TYPE sin_half_twist_min;
+    F_TYPE cos_half_twist_max;
+    F_TYPE sin_half_twist_max;
+};
+
+// --------------------------------------------------
+// reductions over a point cloud, see cloud_transform_reduce_batch: the number of
+// points, their axis aligned bounding box, their mean, and the sums of the products
+// of their deviations to the mean (ii, ij, ik, jj, jk, kk), from which the covariance
+// follows. Partial stats (for example of the slices of a cloud processed by different
+// threads) are combined exactly with cloud_stats_merge.
+struct Cloud_Stats {
+    size_t count;
+    Vec3 box_min;
+    Vec3 box_max;
+    Vec3 mean;
+    F_TYPE comoments[6];
+};
+
+// TODO: depreciate functions that use vector, angle (deprecate only if do not ignore deprecated
+
+// ------------------------------------------------------------
+// FUNCTIONS DECLARATIONS
+// ------------------------------------------------------------
+
+// ---------------------------------------------
+// Vec3 functions
+// ---------------------------------------------
+
+/*
+Setter, in the right order
+*/
+void vec3_setter(Vec3 * v, F_TYPE vi, F_TYPE vj, F_TYPE vk);
+
+/*
+Copy, 'deep'.
+*/
+void vec3_copy(Vec3 const * v_in, Vec3 * v_out);
+
+/*
+Check if a vector is the null vector, up to a tolerance
+*/
+bool vec3_is_null(Vec3 const * v1, F_TYPE tolerance=DEFAULT_TOL);
+
+/*
+Check if 2 vectors are equal, at a tolerance precision
+*/
+bool vec3_equal(Vec3 const * v1, Vec3 const * v2, F_TYPE tolerance=DEFAULT_TOL);
+
+/*
+Compute the square norm of a vector
+*/
+F_TYPE vec3_norm_square(Vec3 const * v);
+
+/*
+Compute the norm of a vector
+*/
+F_TYPE vec3_norm(Vec3 const * v);
+
+/*
+Scale a vector in place
+*/
+void vec3_scale(Vec3 * v, F_TYPE scale);
+
+/*
+Add a vector v_add to an already existing vector v_acc
+*/
+void vec3_add(Vec3 * v_acc, Vec3 const * v_add);
+
+/*
+Subtract a vector v_subs to an already existing vector v_acc
+*/
+void vec3_sub(Vec3 * v_acc, Vec3 const * v_sub);
+
+/*
+Take the scalar product of 2 vectors
+*/
+F_TYPE vec3_scalar(Vec3 const * v1, Vec3 const * v2);
+
+/*
+Take the cross product of 2 vectors v1 and v2 and put the result in v_res
+*/
+void vec3_cross(Vec3 const * v1, Vec3 const * v2, Vec3 * v_res);
+
+/*
+Normalize a vector in place; of course this does not work for the null vector, so also
+return a bool if was able to normalize or not
+*/
+bool vec3_normalize(Vec3 * v);
+
+/*
+Return wether 2 vectors are colinear
+*/
+bool vec3_colinear(Vec3 const * v, Vec3 const * w, F_TYPE tolerance=DEFAULT_TOL);
+
+// ---------------------------------------------
+// Quat functions
+// ---------------------------------------------
+
+/*
+Setter for quaternion
+*/
+void quat_setter(Quat * q, F_TYPE qr, F_TYPE qi, F_TYPE qj, F_TYPE qk);
+
+/*
+Copy, deep
+*/
+void quat_copy(Quat const * q_in, Quat * q_out);
+
+/*
+Norm of a quaternion
+*/
+F_TYPE quat_norm(Quat const * q);
+
+/*
+Square norm of a quaternion
+*/
+
+F_TYPE quat_norm_square(Quat const * q);
+
+/*
+Scalar product of 2 quaternions, as 4D vectors. For unit quaternions, |scalar| is the
+cos of half the angle of the rotation between them (q and -q are the same rotation),
+so comparing |scalar| orders rotations by distance without any trigonometry.
+*/
+F_TYPE quat_scalar(Quat const * q_1, Quat const * q_2);
+
+/*
+Angle in rad, in [0, pi], of the rotation between the rotations of the unit quaternions
+q_1 and q_2, i.e. the geodesic distance on SO(3). This uses atan2 of the norms of the
+difference and the sum, which is accurate also for very small angles.
+*/
+F_TYPE quat_angle(Quat const * q_1, Quat const * q_2);
+
+/*
+Whether or not 2 quaternions are equal up to tolerance
+*/
+bool quat_equal(Quat const * q_1, Quat const * q_2, F_TYPE tolerance=DEFAULT_TOL);
+
+/*
+Conjugate of a quaternion, in-place
+*/
+void quat_conj(Quat * q);
+
+/*
+Whether a quaternion is unitary, i.e. has norm 1
+*/
+bool quat_is_unitary(Quat const * q, F_TYPE tolerance=DEFAULT_TOL);
+
+/*
+Multiply 2 quaternions, and write the result in a third one
+*/
+void quat_prod(Quat const * q_left, Quat const * q_right, Quat * q_result);
+
+/*
+Add one quaternion to another, in place, inside an accumulator
+*/
+void quat_add(Quat * q_acc, Quat const * q_add);
+
+/*
+Subtract one quaternion to another, in place, inside an accumulator
+*/
+void quat_sub(Quat * q_acc, Quat const * q_sub);
+
+/*
+Inverse of a quaternion, in place. This works only for non zero quat,
+so return a boolean flag (true if success).
+*/
+bool quat_inv(Quat * q, F_TYPE tolerance=DEFAULT_TOL);
+
+/*
+Canonical sign of a quaternion, in place: q and -q are the same rotation, use the one
+with r >= 0 (and, if r is 0, with the first non zero component of i, j, k positive),
+so that 2 quaternions of the same rotation become equal.
+*/
+void quat_canonicalize(Quat * q);
+
+// ---------------------------------------------
+// Quat and VECT functions
+// --------------------------------------------
+
+/*
+Get a vector from a quaternion. This makes sense only if the quaternion is a "pure vector",
+return a bool indicating if this is the case.
+*/
+bool quat_to_vec3(Quat const * q, Vec3 * v_out, F_TYPE tolerance=DEFAULT_TOL);
+
+/*
+Write the vector part into a pure vector quaternion
+*/
+void vec3_to_quat(Vec3 const * v, Quat * q_out);
+
+/*
+Write a "rotation quaternion" given the rotation axis and angle in rad.
+This works only for non null axis vector, except if the transformation is
+the identity.
+*/
+bool rotation_to_quat(Quat * q, Vec3 const * rotation_axis, F_TYPE const rotation_angle_rad, F_TYPE tolerance=DEFAULT_TOL);
+
+/*
+Extract the rotation axis and angle from a unit quaternion; this works
+only for unit quaternions, so return bool if is unit. We are polite and we
+return a rotation axis that has unit norm.
+*/
+bool quat_to_rotation(Vec3 * rotation_axis, F_TYPE * rotation_angle_rad, Quat const * q_rotation, F_TYPE tolerance=DEFAULT_TOL);
+
+/*
+Rotate a vector by a given quaternion, using the direct method:
+[0, R(v)] = q x [0, v] x q*
+This is the simplest method, but quite slow.
+Only unit quaternions are pure rotations; provide a bool flag indicating if this is valid.
+*/
+#ifdef KISS_CLANG_3D_IGNORE_DEPRECATED
+  bool rotate_by_quat(Vec3 * v, Quat const * q, F_TYPE tolerance=DEFAULT_TOL);
+#else
+  bool rotate_by_quat(Vec3 * v, Quat const * q, F_TYPE tolerance=DEFAULT_TOL) __attribute__((deprecated("prefer using rotate_by_quat_R with is faster")));
+#endif
+
+/*
+Rotate a vector by a unit quaternion, using the "Rodriguez" formula:
+https://gamedev.stackexchange.com/questions/28395/rotating-vector3-by-a-quaternion
+q = [s, u], s the scalar part, u the vector part
+R(v) = 2.0 ( (u . v) u + (s * s - 0.5) v + s (u x v) )
+This is quite a bit faster. This assumes that a unit quaternion is provided
+(but not checked, for speed; providing a unit quaternion is the caller's
+responsibility).
+*/
+void rotate_by_quat_R(Vec3 const * v, Quat const * q, Vec3 * Rv);
+
+/*
+Unit quaternion of the shortest rotation that brings the direction of v_from onto the
+direction of v_to. This uses the half vector: q = [|v_from| |v_to| + v_from . v_to,
+v_from x v_to], normalized, i.e. no trigonometry. For obtuse angles, where the real
+part cancels, it is computed as |v_from x v_to|^2 / (|v_from| |v_to| - v_from . v_to).
+For opposite vectors (a cross product within rounding errors of 0), the rotation of pi
+around an axis orthogonal to v_from is used. Both vectors must be non null;
+return a bool flag indicating if this is the case.
+*/
+bool quat_from_two_vectors(Vec3 const * v_from, Vec3 const * v_to, Quat * q_out, F_TYPE tolerance=DEFAULT_TOL);
+
+// ---------------------------------------------
+// VA_Rot functions
+// ---------------------------------------------
+
+/*
+Setter, from the rotation axis (that does not need to be normalized) and angle in rad
+*/
+void va_rot_setter(VA_Rot * va, Vec3 const * axis, F_TYPE angle_rad);
+
+/*
+Copy, 'deep'.
+*/
+void va_rot_copy(VA_Rot const * va_in, VA_Rot * va_out);
+
+/*
+Reduce to the canonical form, in place: unit axis, and angle in [0, pi] (the angle is
+brought in [-pi, pi] modulo 2 pi, and a negative angle is turned into a positive one
+around the opposite axis). For an angle of exactly pi, the first non zero component of
+the axis is made positive. A null axis is only valid for the identity (angle 0 modulo
+2 pi, up to tolerance), which is then given the axis i; return a bool flag indicating
+if the VA_Rot is valid.
+*/
+bool va_rot_canonicalize(VA_Rot * va, F_TYPE tolerance=DEFAULT_TOL);
+
+/*
+Whether 2 VA_Rot are the same rotation, whatever their axis norms and angles modulo 2 pi
+are; this compares their unit quaternions, up to the sign (q and -q are the same rotation).
+*/
+bool va_rot_equal(VA_Rot const * va_1, VA_Rot const * va_2, F_TYPE tolerance=DEFAULT_TOL);
+
+/*
+Whether a VA_Rot is the identity, i.e. its angle is 0 modulo 2 pi (up to tolerance).
+*/
+bool va_rot_is_identity(VA_Rot const * va, F_TYPE tolerance=DEFAULT_TOL);
+
+/*
+Unit quaternion of a VA_Rot, as rotation_to_quat; return false for a null axis, except
+if the rotation is the identity.
+*/
+bool va_rot_to_quat(VA_Rot const * va, Quat * q_out, F_TYPE tolerance=DEFAULT_TOL);
+
+/*
+VA_Rot of a unit quaternion, directly in the canonical form (see va_rot_canonicalize);
+this uses atan2 rather than acos, and is accurate also close to the identity. Only works
+for unit quaternions, so return a bool flag indicating if this is the case.
+*/
+bool va_rot_from_quat(Quat const * q, VA_Rot * va_out, F_TYPE tolerance=DEFAULT_TOL);
+
+/*
+Batch versions, between arrays of count VA_Rot and quaternion views (the conversions
+stop at the end of the shortest). va_rot_to_quat_batch writes the identity for the
+invalid VA_Rot, and va_rot_from_quat_batch the identity for the non unit quaternions;
+both return the number of valid conversions.
+*/
+size_t va_rot_to_quat_batch(VA_Rot const * va_in, size_t count, Quat_View const * q_out, F_TYPE tolerance=DEFAULT_TOL);
+size_t va_rot_from_quat_batch(Quat_View const * q_in, VA_Rot * va_out, size_t count, F_TYPE tolerance=DEFAULT_TOL);
+
+// ---------------------------------------------
+// Views functions
+// ---------------------------------------------
+
+/*
+Setter for a Vec3_View over a plain, contiguous array of Vec3
+*/
+void vec3_view_of_array(Vec3_View * view, Vec3 * array, size_t count);
+
+/*
+Read (resp. write) the element number n of a Vec3_View
+*/
+void vec3_view_get(Vec3_View const * view, size_t n, Vec3 * v_out);
+void vec3_view_set(Vec3_View const * view, size_t n, Vec3 const * v_in);
+
+/*
+Setter for a Quat_View over a plain, contiguous array of Quat
+*/
+void quat_view_of_array(Quat_View * view, Quat * array, size_t count);
+
+/*
+Read (resp. write) the element number n of a Quat_View
+*/
+void quat_view_get(Quat_View const * view, size_t n, Quat * q_out);
+void quat_view_set(Quat_View const * view, size_t n, Quat const * q_in);
+
+// ---------------------------------------------
+// Batch functions
+// ---------------------------------------------
+
+// The batch functions work on views, so that they can run directly on the
+// memory layout of the caller, without intermediate copies. Unless stated
+// otherwise, the output view may be the same as the input view (in place
+// operation), and only min(input count, output count) elements are processed.
+
+/*
+Copy all vectors of v_in into v_out, converting between the component types of the
+views; for example, to pack an array of Vec3 into an array of Vec3_Half.
+*/
+void vec3_copy_batch(Vec3_View const * v_in, Vec3_View const * v_out);
+
+/*
+Rotate all vectors of v_in by the unit quaternion q, using the Rodriguez formula
+(see rotate_by_quat_R), and write the results in v_out. If q is one of the octahedral
+rotations (multiples of 90 degrees around the axes, see quat_to_octahedral_rotation), up
+to a few rounding errors, the vectors are rotated by exact permutations and sign flips
+instead.
+*/
+void rotate_by_quat_R_batch(Vec3_View const * v_in, Quat const * q, Vec3_View const * v_out);
+
+/*
+Normalize in place all the vectors of a view; null vectors are left untouched.
+Return the number of vectors that could be normalized.
+*/
+size_t vec3_normalize_batch(Vec3_View const * v);
+
+/*
+Scale in place all the vectors of a view
+*/
+void vec3_scale_batch(Vec3_View const * v, F_TYPE scale);
+
+/*
+Add the vector v_add to all the vectors of a view, in place (i.e., a translation)
+*/
+void vec3_add_batch(Vec3_View const * v_acc, Vec3 const * v_add);
+
+/*
+Left multiply all the quaternions of q_in by q_left, and write the results in q_out;
+for unit quaternions, this composes the rotation q_left after each rotation of q_in.
+*/
+void quat_prod_batch(Quat const * q_left, Quat_View const * q_in, Quat_View const * q_out);
+
+/*
+Batch version of quat_from_two_vectors, over pairs of vectors (v_from[n], v_to[n]); the
+identity is written for the pairs with a null vector. Return the number of valid pairs.
+*/
+size_t quat_from_two_vectors_batch(Vec3_View const * v_from, Vec3_View const * v_to, Quat_View const * q_out, F_TYPE tolerance=DEFAULT_TOL);
+
+/*
+|quat_scalar(q, q_in[n])| for all the quaternions of q_in, written to abs_scalars (one
+element per quaternion): the closer to 1, the closer the rotations.
+*/
+void quat_abs_scalar_batch(Quat const * q, Quat_View const * q_in, F_TYPE * abs_scalars);
+
+/*
+The k rotations of q_refs nearest to the rotation of q, by increasing angle: their
+indexes in q_refs and their angles (as quat_angle) are written in the arrays of k
+elements. The search compares |quat_scalar|, and only the k final angles use
+trigonometry. Return the number of rotations found, min(k, count of q_refs).
+For large sets of reference rotations, see also kiss_clang_3d_rotation_index.h.
+*/
+size_t quat_nearest_batch(Quat const * q, Quat_View const * q_refs, size_t k, size_t * indexes, F_TYPE * angles);
+
+// ---------------------------------------------
+// Unit vectors encoding
+// ---------------------------------------------
+
+/*
+Angle in rad, in [0, pi], between 2 non null vectors; this uses atan2 of the norm of the
+cross product and the scalar product, which is accurate also for very small angles.
+*/
+F_TYPE vec3_angle(Vec3 const * v1, Vec3 const * v2);
+
+/*
+Octahedral encoding of a unit vector (see "A Survey of Efficient Representations for
+Independent Unit Vectors", Cigolle et al., 2014): the vector is projected on the
+octahedron |i| + |j| + |k| = 1, the lower half is folded over the upper half, and the
+2 resulting coordinates are quantized on bits_per_component bits each (from 1 to 16),
+i.e. codes of 16, 24 or 32 bits for 8, 12 or 16 bits per component. The vector does
+not need to be exactly normalized, but must not be null.
+*/
+uint32_t vec3_oct_encode(Vec3 const * v, unsigned bits_per_component);
+
+/*
+Decode an octahedral code into a unit vector
+*/
+void vec3_oct_decode(uint32_t code, unsigned bits_per_component, Vec3 * v_out);
+
+/*
+Encode all the vectors of a view into a packed stream of codes, using vec3_oct_code_size
+bytes per vector (little endian). If max_angular_error is not null, the vectors are also
+decoded back, and the maximum angular error (in rad) over the batch is written there.
+*/
+void vec3_oct_encode_batch(Vec3_View const * v_in, unsigned bits_per_component, unsigned char * codes, F_TYPE * max_angular_error);
+
+/*
+Decode a packed stream of codes (see vec3_oct_encode_batch) into the vectors of a view
+*/
+void vec3_oct_decode_batch(unsigned char const * codes, unsigned bits_per_component, Vec3_View const * v_out);
+
+// ---------------------------------------------
+// Octahedral rotations
+// ---------------------------------------------
+
+/*
+Classify a quaternion: if it is (up to tolerance on the entries of its rotation matrix)
+one of the 24 rotations of the octahedral group, write it to rotation and return true.
+A non unit quaternion is never classified as such.
+*/
+bool quat_to_octahedral_rotation(Quat const * q, Octahedral_Rotation * rotation, F_TYPE tolerance=DEFAULT_TOL);
+
+/*
+Unit quaternion of an octahedral rotation, with a non negative real part.
+*/
+void octahedral_rotation_to_quat(Octahedral_Rotation const * rotation, Quat * q);
+
+/*
+Rotate v by an octahedral rotation; this only moves and negates components, without
+any multiplication, and is exact.
+*/
+void rotate_by_octahedral_rotation(Vec3 const * v, Octahedral_Rotation const * rotation, Vec3 * Rv);
+
+/*
+Batch version of rotate_by_octahedral_rotation, same conventions as rotate_by_quat_R_batch.
+Note that rotate_by_quat_R_batch already dispatches to this function when its quaternion
+is an octahedral rotation (up to a few rounding errors).
+*/
+void rotate_by_octahedral_rotation_batch(Vec3_View const * v_in, Octahedral_Rotation const * rotation, Vec3_View const * v_out);
+
+// ---------------------------------------------
+// Tangent space: exponential and logarithm maps
+// ---------------------------------------------
+
+// the tangent space of the rotations is described by rotation vectors, i.e. the rotation
+// axis times the rotation angle in rad; these functions go between rotation vectors and
+// unit quaternions without building the normalized axis, and without acos.
+
+/*
+Exponential map: unit quaternion of the rotation vector v, i.e. the exponential of the
+pure quaternion [0, v / 2]. A Taylor expansion is used close to the null vector.
+*/
+void quat_exp(Vec3 const * v, Quat * q_out);
+
+/*
+Logarithm map: rotation vector of the unit quaternion q (not checked), with an angle in
+[0, pi], i.e. q and -q give the same rotation vector. A Taylor expansion is used close
+to the identity.
+*/
+void quat_log(Quat const * q, Vec3 * v_out);
+
+/*
+Perturbation of a unit quaternion by a rotation vector delta, expressed in the local
+frame of q: q_out = q * quat_exp(delta).
+*/
+void quat_boxplus(Quat const * q, Vec3 const * delta, Quat * q_out);
+
+/*
+Difference of 2 unit quaternions, as a rotation vector in the local frame of q_2:
+delta = quat_log(conj(q_2) * q_1), so that quat_boxplus(q_2, delta) is q_1.
+*/
+void quat_boxminus(Quat const * q_1, Quat const * q_2, Vec3 * delta_out);
+
+/*
+Batch versions, element by element, over views; the outputs may alias the inputs of
+the same kind (for example q_out and q_in in quat_boxplus_batch).
+*/
+void quat_exp_batch(Vec3_View const * v_in, Quat_View const * q_out);
+void quat_log_batch(Quat_View const * q_in, Vec3_View const * v_out);
+void quat_boxplus_batch(Quat_View const * q_in, Vec3_View const * deltas, Quat_View const * q_out);
+void quat_boxminus_batch(Quat_View const * q_1, Quat_View const * q_2, Vec3_View const * deltas_out);
+
+/*
+Body angular velocity (rad/s) turning the attitude q_1 into q_2 in dt seconds:
+quat_boxminus(q_2, q_1) / dt, i.e. the constant velocity over the interval, which
+mixed_quat_integrate turns back into q_2. The logarithm is computed without branches
+(unlike quat_log), and keeps the precision of small rotations between close samples.
+A dt that is not > 0 gives a null velocity.
+*/
+void quat_angular_velocity(Quat const * q_1, Quat const * q_2, F_TYPE dt, Vec3 * w_out);
+
+/*
+Angular velocities of a sequence of attitudes, in a single pass over q_in: w_out[n] is
+the velocity from q_in[n] to q_in[n + 1], i.e. the one at the middle of the interval.
+quat_angular_velocity_batch is for samples every dt seconds; quat_angular_velocity_times_batch
+takes the time of each sample (one per quaternion of q_in). As for quat_angular_velocity,
+the velocity is null for the intervals (dt, or between 2 times) that are not > 0. Return the number of velocities written, one less
+than the count of q_in (less if w_out is too small).
+*/
+size_t quat_angular_velocity_batch(Quat_View const * q_in, F_TYPE dt, Vec3_View const * w_out);
+size_t quat_angular_velocity_times_batch(Quat_View const * q_in, F_TYPE const * times, Vec3_View const * w_out);
+
+// ---------------------------------------------
+// Swing twist decomposition and joint limits
+// ---------------------------------------------
+
+/*
+Decompose the unit quaternion q into q = swing * twist, where twist is a rotation around
+twist_axis (which does not need to be normalized), and swing a rotation around an axis
+orthogonal to twist_axis. This uses only a projection and a normalization, no
+trigonometry. The twist has a non negative real part. For a rotation of pi around an
+axis orthogonal to twist_axis, the twist is the identity. Only works for a non null
+twist_axis, so return a bool flag.
+*/
+bool quat_swing_twist(Quat const * q, Vec3 const * twist_axis, Quat * swing, Quat * twist, F_TYPE tolerance=DEFAULT_TOL);
+
+/*
+Batch version of quat_swing_twist, around the same axis for all the quaternions.
+*/
+bool quat_swing_twist_batch(Quat_View const * q_in, Vec3 const * twist_axis, Quat_View const * swings, Quat_View const * twists, F_TYPE tolerance=DEFAULT_TOL);
+
+/*
+Setter for the limits of a joint, with angles in rad: swing_max in [0, pi], and
+-pi <= twist_min <= twist_max <= pi. Return false if the limits are not valid, or the
+twist axis is null.
+*/
+bool joint_limits_setter(Joint_Limits * limits, Vec3 const * twist_axis, F_TYPE swing_max_rad, F_TYPE twist_min_rad, F_TYPE twist_max_rad, F_TYPE tolerance=DEFAULT_TOL);
+
+/*
+Clamp the rotation of the unit quaternion q to the limits: the swing is brought back
+on the cone, and the twist in its range, independently. Return true if q had to be
+clamped; otherwise, q_out is a copy of q.
+*/
+bool quat_clamp_to_limits(Quat const * q, Joint_Limits const * limits, Quat * q_out);
+
+/*
+Batch version of quat_clamp_to_limits, with the same limits for all the quaternions;
+q_out may be q_in. Return the number of quaternions that had to be clamped.
+*/
+size_t quat_clamp_to_limits_batch(Quat_View const * q_in, Joint_Limits const * limits, Quat_View const * q_out);
+
+// ---------------------------------------------
+// Point clouds
+// ---------------------------------------------
+
+/*
+Empty stats: count 0, null mean and comoments, and an empty box (box_min larger than
+box_max).
+*/
+void cloud_stats_clear(Cloud_Stats * stats);
+
+/*
+Add the stats stats_add to stats_acc, as if all their points had been reduced together
+(pairwise update of the mean and comoments, union of the boxes).
+*/
+void cloud_stats_merge(Cloud_Stats * stats_acc, Cloud_Stats const * stats_add);
+
+/*
+Covariance of the points (comoments / count), in the order ii, ij, ik, jj, jk, kk.
+Return false if there is no point.
+*/
+bool cloud_stats_covariance(Cloud_Stats const * stats, F_TYPE covariance[6]);
+
+/*
+Apply the rigid transform v -> q v + translation (rotation as rotate_by_quat_R) to all
+the points of v_in, write them to v_out, and accumulate their stats into stats, all in
+a single pass over the memory. q, translation and v_out can be null, to skip the
+rotation, the translation, or the writing of the points (e.g. for the stats only).
+The stats are accumulated by blocks of points, relative to the first point of the
+block, which keeps them accurate in float. To split a large cloud between threads,
+reduce slices of the views (vec3_view_slice) into separate stats, and merge them.
+*/
+void cloud_transform_reduce_batch(Vec3_View const * v_in, Quat const * q, Vec3 const * translation, Vec3_View const * v_out, Cloud_Stats * stats);
@@ -0,0 +1,1499 @@
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// Definitions of the functions declared in kiss_clang_3d_generic.h; this is included
+// by kiss_clang_3d.c once per precision, and has on purpose no include guard.
+
+// ------------------------------------------------------------
+// DEFINITIONS
+// ------------------------------------------------------------
+
+// ---------------------------------------------
+// Vec3 functions
+// ---------------------------------------------
+
+void vec3_setter(Vec3 * v, F_TYPE vi, F_TYPE vj, F_TYPE vk){
+    v->i = vi;
+    v->j = vj;
+    v->k = vk;
+}
+
+void vec3_copy(Vec3 const * v_in, Vec3 * v_out){
+    v_out->i = v_in->i;
+    v_out->j = v_in->j;
+    v_out->k = v_in->k;
+}
+
+bool vec3_is_null(Vec3 const * v1, F_TYPE tolerance){
+    return(
+        F_TYPE_ABS(v1->i) <= tolerance &&
+        F_TYPE_ABS(v1->j) <= tolerance &&
+        F_TYPE_ABS(v1->k) <= tolerance
+    );
+}
+
+bool vec3_equal(Vec3 const * v1, Vec3 const * v2, F_TYPE tolerance){
+    return(
+        F_TYPE_ABS(v1->i - v2->i) <= tolerance &&
+        F_TYPE_ABS(v1->j - v2->j) <= tolerance &&
+        F_TYPE_ABS(v1->k - v2->k) <= tolerance
+    );
+}
+
+F_TYPE vec3_norm_square(Vec3 const * v){
+    return (
+            (v->i * v->i) + (v->j * v->j) + (v->k * v->k)
+    );
+}
+
+F_TYPE vec3_norm(Vec3 const * v){
+    return (
+        F_TYPE_SQRT(
+                (v->i * v->i) + (v->j * v->j) + (v->k * v->k)
+        )
+    );
+}
+
+void vec3_scale(Vec3 * v, F_TYPE scale){
+    v->i *= scale;
+    v->j *= scale;
+    v->k *= scale;
+}
+
+void vec3_add(Vec3 * v_acc, Vec3 const * v_add){
+    v_acc->i += v_add->i;
+    v_acc->j += v_add->j;
+    v_acc->k += v_add->k;
+}
+
+void vec3_sub(Vec3 * v_acc, Vec3 const * v_sub){
+    v_acc->i -= v_sub->i;
+    v_acc->j -= v_sub->j;
+    v_acc->k -= v_sub->k;
+}
+
+F_TYPE vec3_scalar(Vec3 const * v1, Vec3 const * v2){
+    return(
+        v1->i * v2->i +
+        v1->j * v2->j +
+        v1->k * v2->k
+    );
+}
+
+void vec3_cross(Vec3 const * v1, Vec3 const * v2, Vec3 * v_res){
+    v_res->i =  v1->j * v2->k - v1->k * v2->j;
+    v_res->j = -v1->i * v2->k + v1->k * v2->i;
+    v_res->k =  v1->i * v2->j - v1->j * v2->i;
+}
+
+bool vec3_normalize(Vec3 * v){
+    if (vec3_is_null(v)){
+        return false;
+    }
+    else{
+        F_TYPE norm = vec3_norm(v);
+        vec3_scale(v, F_TYPE_1 / norm);
+        return true;
+    }
+}
+
+bool vec3_colinear(Vec3 const * v, Vec3 const * w, F_TYPE tolerance){
+    Vec3 result_cross_product;
+    vec3_cross(v, w, &result_cross_product);
+    return vec3_is_null(&result_cross_product, tolerance);
+}
+
+// ---------------------------------------------
+// Quat functions
+// ---------------------------------------------
+
+void quat_setter(Quat * q, F_TYPE qr, F_TYPE qi, F_TYPE qj, F_TYPE qk){
+    q->r = qr;
+    q->i = qi;
+    q->j = qj;
+    q->k = qk;
+}
+
+void quat_copy(Quat const * q_in, Quat * q_out){
+    q_out->r = q_in->r;
+    q_out->i = q_in->i;
+    q_out->j = q_in->j;
+    q_out->k = q_in->k;
+}
+
+F_TYPE quat_norm(Quat const * q){
+    return(
+        F_TYPE_SQRT(
+            q->r * q->r + q->i * q->i + q->j * q->j + q->k * q->k
+        )
+    );
+}
+
+F_TYPE quat_norm_square(Quat const * q){
+    return(
+        q->r * q->r + q->i * q->i + q->j * q->j + q->k * q->k
+    );
+}
+
+F_TYPE quat_scalar(Quat const * q_1, Quat const * q_2){
+    return(
+        q_1->r * q_2->r + q_1->i * q_2->i + q_1->j * q_2->j + q_1->k * q_2->k
+    );
+}
+
+F_TYPE quat_angle(Quat const * q_1, Quat const * q_2){
+    // the 4D angle between q_1 and the one of q_2, -q_2 in the same half space is half
+    // the rotation angle, and is 2 atan2(|q_1 - q_2|, |q_1 + q_2|)
+    F_TYPE sign = quat_scalar(q_1, q_2) < F_TYPE_0 ? -F_TYPE_1 : F_TYPE_1;
+    Quat diff {q_1->r - sign * q_2->r, q_1->i - sign * q_2->i, q_1->j - sign * q_2->j, q_1->k - sign * q_2->k};
+    Quat sum {q_1->r + sign * q_2->r, q_1->i + sign * q_2->i, q_1->j + sign * q_2->j, q_1->k + sign * q_2->k};
+
+    return F_TYPE_2 * F_TYPE_2 * F_TYPE_ATAN2(quat_norm(&diff), quat_norm(&sum));
+}
+
+bool quat_equal(Quat const * q_1, Quat const * q_2, F_TYPE tolerance){
+    return(
+        F_TYPE_ABS(q_1->r - q_2->r) <= tolerance &&
+        F_TYPE_ABS(q_1->i - q_2->i) <= tolerance &&
+        F_TYPE_ABS(q_1->j - q_2->j) <= tolerance &&
+        F_TYPE_ABS(q_1->k - q_2->k) <= tolerance
+    );
+}
+
+void quat_conj(Quat * q){
+    q->i = -q->i;
+    q->j = -q->j;
+    q->k = -q->k;
+}
+
+bool quat_is_unitary(Quat const * q, F_TYPE tolerance){
+    return(
+        F_TYPE_ABS(quat_norm_square(q) - F_TYPE_1) < tolerance
+    );
+}
+
+void quat_prod(Quat const * q_left, Quat const * q_right, Quat * q_result){
+    q_result->r = q_left->r * q_right->r  -  q_left->i * q_right->i  -  q_left->j * q_right->j  -  q_left->k * q_right->k;
+    q_result->i = q_left->r * q_right->i  +  q_left->i * q_right->r  +  q_left->j * q_right->k  -  q_left->k * q_right->j;
+    q_result->j = q_left->r * q_right->j  -  q_left->i * q_right->k  +  q_left->j * q_right->r  +  q_left->k * q_right->i;
+    q_result->k = q_left->r * q_right->k  +  q_left->i * q_right->j  -  q_left->j * q_right->i  +  q_left->k * q_right->r;
+}
+
+void quat_add(Quat * q_acc, Quat const * q_add){
+    q_acc->r += q_add->r;
+    q_acc->i += q_add->i;
+    q_acc->j += q_add->j;
+    q_acc->k += q_add->k;
+}
+
+void quat_sub(Quat * q_acc, Quat const * q_sub){
+    q_acc->r -= q_sub->r;
+    q_acc->i -= q_sub->i;
+    q_acc->j -= q_sub->j;
+    q_acc->k -= q_sub->k;
+}
+
+bool quat_inv(Quat * q, F_TYPE tolerance){
+    F_TYPE norm_square = quat_norm_square(q);
+
+    if (norm_square < tolerance){
+        return false;
+    }
+    else{
+        q->r /= norm_square;
+        q->i = -q->i / norm_square;
+        q->j = -q->j / norm_square;
+        q->k = -q->k / norm_square;
+
+        return true;
+    }
+}
+
+void quat_canonicalize(Quat * q){
+    bool negative;
+
+    if (q->r != F_TYPE_0){
+        negative = q->r < F_TYPE_0;
+    }
+    else if (q->i != F_TYPE_0){
+        negative = q->i < F_TYPE_0;
+    }
+    else if (q->j != F_TYPE_0){
+        negative = q->j < F_TYPE_0;
+    }
+    else{
+        negative = q->k < F_TYPE_0;
+    }
+
+    if (negative){
+        quat_setter(q, -q->r, -q->i, -q->j, -q->k);
+    }
+}
+
+// ---------------------------------------------
+// Quat and VECT functions
+// --------------------------------------------
+
+bool quat_to_vec3(Quat const * q, Vec3 * v_out, F_TYPE tolerance){
+    v_out->i = q->i;
+    v_out->j = q->j;
+    v_out->k = q->k;
+
+    if (F_TYPE_ABS(q->r) > tolerance){
+        return false;
+    }
+    else{
+        return true;
+    }
+}
+
+void vec3_to_quat(Vec3 const * v, Quat * q_out){
+    q_out->r = F_TYPE_0;
+    q_out->i = v->i;
+    q_out->j = v->j;
+    q_out->k = v->k;
+}
+
+bool rotation_to_quat(Quat * q, Vec3 const * rotation_axis, F_TYPE const rotation_angle_rad, F_TYPE tolerance){
+    if (vec3_is_null(rotation_axis)){
+        if (F_TYPE_ABS(rotation_angle_rad) <= tolerance){
+            q->r = F_TYPE_1;
+            q->i = F_TYPE_0;
+            q->j = F_TYPE_0;
+            q->k = F_TYPE_0;
+
+            return true;
+        }
+        else{
+            return false;
+        }
+    }
+
+    F_TYPE half_rotation_angle = rotation_angle_rad / F_TYPE_2;
+    F_TYPE cos_of_half = F_TYPE_COS(half_rotation_angle);
+    F_TYPE sin_of_half = F_TYPE_SIN(half_rotation_angle);
+    F_TYPE norm_of_axis = vec3_norm(rotation_axis);
+
+    q->r = cos_of_half;
+    q->i = rotation_axis->i / norm_of_axis * sin_of_half;
+    q->j = rotation_axis->j / norm_of_axis * sin_of_half;
+    q->k = rotation_axis->k / norm_of_axis * sin_of_half;
+
+    return true;
+}
+
+bool quat_to_rotation(Vec3 * rotation_axis, F_TYPE * rotation_angle_rad, Quat const * q_rotation, F_TYPE tolerance){
+    if (!quat_is_unitary(q_rotation, tolerance)){
+        return false;
+    }
+    else{
+        *rotation_angle_rad = F_TYPE_2 * F_TYPE_ACOS(q_rotation->r);
+        F_TYPE sin_half_angle = F_TYPE_SQRT(F_TYPE_1 - q_rotation->r * q_rotation->r);
+        rotation_axis->i = q_rotation->i / sin_half_angle;
+        rotation_axis->j = q_rotation->j / sin_half_angle;
+        rotation_axis->k = q_rotation->k / sin_half_angle;
+
+        return true;
+    }
+}
+
+// the naive way, applying the definition; this is quite inefficient though
+bool rotate_by_quat(Vec3 * v, Quat const * q, F_TYPE tolerance){
+    if (!quat_is_unitary(q)){
+        return false;
+    }
+
+    Quat q_1;
+    Quat q_2;
+    Quat q_3;
+
+    // q_1 is the Quat out of v
+    vec3_to_quat(v, &q_1);
+
+    // q_2 is the rotation Quat conjugate
+    quat_copy(q, &q_2);
+    quat_conj(&q_2);
+
+    // q_3 contains the right part of the product
+    quat_prod(&q_1, &q_2, &q_3);
+
+    // q_2 is the rotation quat
+    quat_conj(&q_2);
+
+    // q_1 contains the full quaternion
+    quat_prod(&q_2, &q_3, &q_1);
+
+    // make the result available
+    quat_to_vec3(&q_1, v);
+
+    return true;
+}
+
+void rotate_by_quat_R(Vec3 const * v, Quat const * q, Vec3 * Rv){
+    // reminder of the formula:
+    // q = [s, u]
+    // R(v) = 2.0 ( (u . v) u + (s * s - 0.5) v + s (u x v) )
+
+    F_TYPE u_dot_v = q->i * v->i + q->j * v->j + q->k * v->k;
+    F_TYPE s2m05 = q->r * q->r - F_TYPE_05;
+    Rv->i = F_TYPE_2 * ( u_dot_v * q->i + s2m05 * v->i + q->r * ( q->j * v->k - q->k * v->j ) );
+    Rv->j = F_TYPE_2 * ( u_dot_v * q->j + s2m05 * v->j + q->r * ( q->k * v->i - q->i * v->k ) );
+    Rv->k = F_TYPE_2 * ( u_dot_v * q->k + s2m05 * v->k + q->r * ( q->i * v->j - q->j * v->i ) );
+}
+
+bool quat_from_two_vectors(Vec3 const * v_from, Vec3 const * v_to, Quat * q_out, F_TYPE tolerance){
+    if (vec3_is_null(v_from, tolerance) || vec3_is_null(v_to, tolerance)){
+        return false;
+    }
+
+    F_TYPE norms_product = F_TYPE_SQRT(vec3_norm_square(v_from) * vec3_norm_square(v_to));
+    F_TYPE scalar = vec3_scalar(v_from, v_to);
+    Vec3 cross_product;
+    vec3_cross(v_from, v_to, &cross_product);
+
+    // real part: twice the cos of the half angle, times the norms
+    q_out->r = norms_product + scalar;
+
+    if (scalar < F_TYPE_0){
+        // obtuse angle: the sum above cancels, and the cross product is only known up to
+        // rounding errors of the order of eps * norms_product, in any direction. Remove
+        // these along v_from (so that the axis stays orthogonal to it), and take the real
+        // part from |v_from|^2 |v_to|^2 = scalar^2 + |cross|^2 instead.
+        F_TYPE along_from = vec3_scalar(&cross_product, v_from) / vec3_norm_square(v_from);
+        vec3_setter(
+            &cross_product,
+            cross_product.i - along_from * v_from->i,
+            cross_product.j - along_from * v_from->j,
+            cross_product.k - along_from * v_from->k
+        );
+
+        F_TYPE cross_norm_square = vec3_norm_square(&cross_product);
+        F_TYPE cross_threshold = 8 * F_TYPE_EPS * norms_product;
+        q_out->r = cross_norm_square / (norms_product - scalar);
+
+        if (cross_norm_square <= cross_threshold * cross_threshold){
+            // opposite vectors: any axis orthogonal to v_from, here the cross product with
+            // the basis vector along the smallest component of v_from
+            F_TYPE abs_i = F_TYPE_ABS(v_from->i);
+            F_TYPE abs_j = F_TYPE_ABS(v_from->j);
+            F_TYPE abs_k = F_TYPE_ABS(v_from->k);
+
+            if (abs_i <= abs_j && abs_i <= abs_k){
+                vec3_setter(&cross_product, F_TYPE_0, v_from->k, -v_from->j);
+            }
+            else if (abs_j <= abs_k){
+                vec3_setter(&cross_product, -v_from->k, F_TYPE_0, v_from->i);
+            }
+            else{
+                vec3_setter(&cross_product, v_from->j, -v_from->i, F_TYPE_0);
+            }
+
+            q_out->r = F_TYPE_0;
+        }
+    }
+
+    q_out->i = cross_product.i;
+    q_out->j = cross_product.j;
+    q_out->k = cross_product.k;
+
+    F_TYPE norm = quat_norm(q_out);
+    quat_setter(q_out, q_out->r / norm, q_out->i / norm, q_out->j / norm, q_out->k / norm);
+
+    return true;
+}
+
+// ---------------------------------------------
+// VA_Rot functions
+// ---------------------------------------------
+
+void va_rot_setter(VA_Rot * va, Vec3 const * axis, F_TYPE angle_rad){
+    vec3_copy(axis, &va->axis);
+    va->angle_rad = angle_rad;
+}
+
+void va_rot_copy(VA_Rot const * va_in, VA_Rot * va_out){
+    vec3_copy(&va_in->axis, &va_out->axis);
+    va_out->angle_rad = va_in->angle_rad;
+}
+
+bool va_rot_canonicalize(VA_Rot * va, F_TYPE tolerance){
+    // angle in [-pi, pi)
+    F_TYPE two_pi = F_TYPE_2 * F_TYPE_PI;
+    F_TYPE angle = va->angle_rad - two_pi * F_TYPE_FLOOR((va->angle_rad + F_TYPE_PI) / two_pi);
+
+    if (vec3_is_null(&va->axis, tolerance)){
+        if (F_TYPE_ABS(angle) > tolerance){
+            return false;
+        }
+        vec3_setter(&va->axis, F_TYPE_1, F_TYPE_0, F_TYPE_0);
+        va->angle_rad = F_TYPE_0;
+        return true;
+    }
+
+    vec3_normalize(&va->axis);
+
+    if (angle < F_TYPE_0){
+        angle = -angle;
+        vec3_scale(&va->axis, -F_TYPE_1);
+    }
+
+    if (angle == F_TYPE_PI){
+        bool negative_axis = (va->axis.i != F_TYPE_0) ? (va->axis.i < F_TYPE_0) : ((va->axis.j != F_TYPE_0) ? (va->axis.j < F_TYPE_0) : (va->axis.k < F_TYPE_0));
+        if (negative_axis){
+            vec3_scale(&va->axis, -F_TYPE_1);
+        }
+    }
+
+    va->angle_rad = angle;
+    return true;
+}
+
+bool va_rot_equal(VA_Rot const * va_1, VA_Rot const * va_2, F_TYPE tolerance){
+    Quat q_1;
+    Quat q_2;
+
+    if (!va_rot_to_quat(va_1, &q_1, tolerance) || !va_rot_to_quat(va_2, &q_2, tolerance)){
+        return false;
+    }
+
+    if (quat_equal(&q_1, &q_2, tolerance)){
+        return true;
+    }
+
+    quat_setter(&q_2, -q_2.r, -q_2.i, -q_2.j, -q_2.k);
+    return quat_equal(&q_1, &q_2, tolerance);
+}
+
+bool va_rot_is_identity(VA_Rot const * va, F_TYPE tolerance){
+    Quat q;
+
+    if (!va_rot_to_quat(va, &q, tolerance)){
+        return false;
+    }
+
+    // the vector part is sin(angle / 2) times the unit axis
+    Vec3 q_vector {q.i, q.j, q.k};
+    return vec3_is_null(&q_vector, tolerance);
+}
+
+bool va_rot_to_quat(VA_Rot const * va, Quat * q_out, F_TYPE tolerance){
+    return rotation_to_quat(q_out, &va->axis, va->angle_rad, tolerance);
+}
+
+bool va_rot_from_quat(Quat const * q, VA_Rot * va_out, F_TYPE tolerance){
+    if (!quat_is_unitary(q, tolerance)){
+        return false;
+    }
+
+    // q and -q are the same rotation: use the one with r >= 0, i.e. an angle in [0, pi]
+    F_TYPE sign = (q->r < F_TYPE_0) ? -F_TYPE_1 : F_TYPE_1;
+    F_TYPE sin_of_half = F_TYPE_SQRT(q->i * q->i + q->j * q->j + q->k * q->k);
+
+    if (sin_of_half == F_TYPE_0){
+        vec3_setter(&va_out->axis, F_TYPE_1, F_TYPE_0, F_TYPE_0);
+        va_out->angle_rad = F_TYPE_0;
+        return true;
+    }
+
+    F_TYPE scale = sign / sin_of_half;
+    vec3_setter(&va_out->axis, scale * q->i, scale * q->j, scale * q->k);
+    va_out->angle_rad = F_TYPE_2 * F_TYPE_ATAN2(sin_of_half, sign * q->r);
+
+    return true;
+}
+
+size_t va_rot_to_quat_batch(VA_Rot const * va_in, size_t count, Quat_View const * q_out, F_TYPE tolerance){
+    size_t nbr_valid = 0;
+    Quat crrt_out;
+
+    count = min_count(count, q_out->count);
+
+    for (size_t n = 0; n < count; n++){
+        if (va_rot_to_quat(&va_in[n], &crrt_out, tolerance)){
+            nbr_valid++;
+        }
+        else{
+            quat_setter(&crrt_out, F_TYPE_1, F_TYPE_0, F_TYPE_0, F_TYPE_0);
+        }
+        quat_view_set(q_out, n, &crrt_out);
+    }
+
+    return nbr_valid;
+}
+
+size_t va_rot_from_quat_batch(Quat_View const * q_in, VA_Rot * va_out, size_t count, F_TYPE tolerance){
+    size_t nbr_valid = 0;
+    Quat crrt_in;
+    Vec3 const axis_i {F_TYPE_1, F_TYPE_0, F_TYPE_0};
+
+    count = min_count(count, q_in->count);
+
+    for (size_t n = 0; n < count; n++){
+        quat_view_get(q_in, n, &crrt_in);
+        if (va_rot_from_quat(&crrt_in, &va_out[n], tolerance)){
+            nbr_valid++;
+        }
+        else{
+            va_rot_setter(&va_out[n], &axis_i, F_TYPE_0);
+        }
+    }
+
+    return nbr_valid;
+}
+
+// ---------------------------------------------
+// Views functions
+// ---------------------------------------------
+
+// components are accessed through memcpy, so that any stride / offset is valid
+// (no alignment or aliasing issues); compilers turn this into plain loads / stores.
+
+static F_TYPE view_component_load(void * base, size_t position, char component_type){
+    unsigned char const * address = KISS_CAST(unsigned char const *, base) + position;
+    float value_as_float;
+    double value_as_double;
+    uint16_t value_as_16_bits;
+
+    switch (component_type){
+        case 'D':
+            memcpy(&value_as_double, address, sizeof(double));
+            return F_TYPE_FROM_DOUBLE(value_as_double);
+        case 'H':
+            memcpy(&value_as_16_bits, address, sizeof(uint16_t));
+            return F_TYPE_FROM_FLOAT(half_to_float(value_as_16_bits));
+        case 'B':
+            memcpy(&value_as_16_bits, address, sizeof(uint16_t));
+            return F_TYPE_FROM_FLOAT(bf16_to_float(value_as_16_bits));
+        case 'F':
+            memcpy(&value_as_float, address, sizeof(float));
+            return F_TYPE_FROM_FLOAT(value_as_float);
+        default:
+            KISS_UNREACHABLE();
+            return F_TYPE_FROM_FLOAT(0.0f);
+    }
+}
+
+static void view_component_store(void * base, size_t position, char component_type, F_TYPE value){
+    unsigned char * address = KISS_CAST(unsigned char *, base) + position;
+    float value_as_float = F_TYPE_TO_FLOAT(value);
+    double value_as_double = F_TYPE_TO_DOUBLE(value);
+    uint16_t value_as_16_bits;
+
+    switch (component_type){
+        case 'D':
+            memcpy(address, &value_as_double, sizeof(double));
+            break;
+        case 'H':
+            value_as_16_bits = float_to_half(value_as_float);
+            memcpy(address, &value_as_16_bits, sizeof(uint16_t));
+            break;
+        case 'B':
+            value_as_16_bits = float_to_bf16(value_as_float);
+            memcpy(address, &value_as_16_bits, sizeof(uint16_t));
+            break;
+        case 'F':
+            memcpy(address, &value_as_float, sizeof(float));
+            break;
+        default:
+            KISS_UNREACHABLE();
+            break;
+    }
+}
+
+void vec3_view_of_array(Vec3_View * view, Vec3 * array, size_t count){
+    vec3_view_setter(
+        view, array, sizeof(Vec3), count,
+        offsetof(Vec3, i), offsetof(Vec3, j), offsetof(Vec3, k),
+        F_TYPE_TAG
+    );
+}
+
+void vec3_view_get(Vec3_View const * view, size_t n, Vec3 * v_out){
+    size_t start = n * view->stride;
+    v_out->i = view_component_load(view->base, start + view->offset_i, view->component_type);
+    v_out->j = view_component_load(view->base, start + view->offset_j, view->component_type);
+    v_out->k = view_component_load(view->base, start + view->offset_k, view->component_type);
+}
+
+void vec3_view_set(Vec3_View const * view, size_t n, Vec3 const * v_in){
+    size_t start = n * view->stride;
+    view_component_store(view->base, start + view->offset_i, view->component_type, v_in->i);
+    view_component_store(view->base, start + view->offset_j, view->component_type, v_in->j);
+    view_component_store(view->base, start + view->offset_k, view->component_type, v_in->k);
+}
+
+void quat_view_of_array(Quat_View * view, Quat * array, size_t count){
+    quat_view_setter(
+        view, array, sizeof(Quat), count,
+        offsetof(Quat, r), offsetof(Quat, i), offsetof(Quat, j), offsetof(Quat, k),
+        F_TYPE_TAG
+    );
+}
+
+void quat_view_get(Quat_View const * view, size_t n, Quat * q_out){
+    size_t start = n * view->stride;
+    q_out->r = view_component_load(view->base, start + view->offset_r, view->component_type);
+    q_out->i = view_component_load(view->base, start + view->offset_i, view->component_type);
+    q_out->j = view_component_load(view->base, start + view->offset_j, view->component_type);
+    q_out->k = view_component_load(view->base, start + view->offset_k, view->component_type);
+}
+
+void quat_view_set(Quat_View const * view, size_t n, Quat const * q_in){
+    size_t start = n * view->stride;
+    view_component_store(view->base, start + view->offset_r, view->component_type, q_in->r);
+    view_component_store(view->base, start + view->offset_i, view->component_type, q_in->i);
+    view_component_store(view->base, start + view->offset_j, view->component_type, q_in->j);
+    view_component_store(view->base, start + view->offset_k, view->component_type, q_in->k);
+}
+
+// ---------------------------------------------
+// Batch functions
+// ---------------------------------------------
+
+void vec3_copy_batch(Vec3_View const * v_in, Vec3_View const * v_out){
+    size_t count = min_count(v_in->count, v_out->count);
+    Vec3 crrt;
+
+    for (size_t n = 0; n < count; n++){
+        vec3_view_get(v_in, n, &crrt);
+        vec3_view_set(v_out, n, &crrt);
+    }
+}
+
+void rotate_by_quat_R_batch(Vec3_View const * v_in, Quat const * q, Vec3_View const * v_out){
+    // the tolerance only absorbs the rounding of quaternions such as (sqrt(2) / 2, 0, 0, sqrt(2) / 2)
+    Octahedral_Rotation octahedral_rotation;
+    if (quat_to_octahedral_rotation(q, &octahedral_rotation, 8 * F_TYPE_EPS)){
+        rotate_by_octahedral_rotation_batch(v_in, &octahedral_rotation, v_out);
+        return;
+    }
+
+    size_t count = min_count(v_in->count, v_out->count);
+
+    if (is_packed_half_view(v_in) && is_packed_half_view(v_out)){
+        Quat_f const q_float {F_TYPE_TO_FLOAT(q->r), F_TYPE_TO_FLOAT(q->i), F_TYPE_TO_FLOAT(q->j), F_TYPE_TO_FLOAT(q->k)};
+        rotate_packed_half_batch(v_in, &q_float, v_out, count);
+        return;
+    }
+
+    Vec3 crrt_in;
+    Vec3 crrt_out;
+
+    for (size_t n = 0; n < count; n++){
+        vec3_view_get(v_in, n, &crrt_in);
+        rotate_by_quat_R(&crrt_in, q, &crrt_out);
+        vec3_view_set(v_out, n, &crrt_out);
+    }
+}
+
+size_t vec3_normalize_batch(Vec3_View const * v){
+    size_t nbr_normalized = 0;
+    Vec3 crrt;
+
+    for (size_t n = 0; n < v->count; n++){
+        vec3_view_get(v, n, &crrt);
+        if (vec3_normalize(&crrt)){
+            vec3_view_set(v, n, &crrt);
+            nbr_normalized++;
+        }
+    }
+
+    return nbr_normalized;
+}
+
+void vec3_scale_batch(Vec3_View const * v, F_TYPE scale){
+    Vec3 crrt;
+
+    for (size_t n = 0; n < v->count; n++){
+        vec3_view_get(v, n, &crrt);
+        vec3_scale(&crrt, scale);
+        vec3_view_set(v, n, &crrt);
+    }
+}
+
+void vec3_add_batch(Vec3_View const * v_acc, Vec3 const * v_add){
+    Vec3 crrt;
+
+    for (size_t n = 0; n < v_acc->count; n++){
+        vec3_view_get(v_acc, n, &crrt);
+        vec3_add(&crrt, v_add);
+        vec3_view_set(v_acc, n, &crrt);
+    }
+}
+
+void quat_prod_batch(Quat const * q_left, Quat_View const * q_in, Quat_View const * q_out){
+    size_t count = min_count(q_in->count, q_out->count);
+    Quat crrt_in;
+    Quat crrt_out;
+
+    for (size_t n = 0; n < count; n++){
+        quat_view_get(q_in, n, &crrt_in);
+        quat_prod(q_left, &crrt_in, &crrt_out);
+        quat_view_set(q_out, n, &crrt_out);
+    }
+}
+
+size_t quat_from_two_vectors_batch(Vec3_View const * v_from, Vec3_View const * v_to, Quat_View const * q_out, F_TYPE tolerance){
+    size_t count = min_count(min_count(v_from->count, v_to->count), q_out->count);
+    size_t nbr_valid = 0;
+    Vec3 crrt_from;
+    Vec3 crrt_to;
+    Quat crrt_out;
+
+    for (size_t n = 0; n < count; n++){
+        vec3_view_get(v_from, n, &crrt_from);
+        vec3_view_get(v_to, n, &crrt_to);
+        if (quat_from_two_vectors(&crrt_from, &crrt_to, &crrt_out, tolerance)){
+            nbr_valid++;
+        }
+        else{
+            quat_setter(&crrt_out, F_TYPE_1, F_TYPE_0, F_TYPE_0, F_TYPE_0);
+        }
+        quat_view_set(q_out, n, &crrt_out);
+    }
+
+    return nbr_valid;
+}
+
+void quat_abs_scalar_batch(Quat const * q, Quat_View const * q_in, F_TYPE * abs_scalars){
+    Quat crrt_in;
+
+    for (size_t n = 0; n < q_in->count; n++){
+        quat_view_get(q_in, n, &crrt_in);
+        abs_scalars[n] = F_TYPE_ABS(quat_scalar(q, &crrt_in));
+    }
+}
+
+size_t quat_nearest_batch(Quat const * q, Quat_View const * q_refs, size_t k, size_t * indexes, F_TYPE * angles){
+    size_t found = 0;
+    Quat crrt_ref;
+
+    // the best |scalar| so far, sorted by decreasing value, kept in angles
+    for (size_t n = 0; n < q_refs->count && k > 0; n++){
+        quat_view_get(q_refs, n, &crrt_ref);
+        F_TYPE abs_scalar = F_TYPE_ABS(quat_scalar(q, &crrt_ref));
+
+        if (found == k && abs_scalar <= angles[k - 1]){
+            continue;
+        }
+
+        size_t position = found < k ? found++ : k - 1;
+        while (position > 0 && angles[position - 1] < abs_scalar){
+            angles[position] = angles[position - 1];
+            indexes[position] = indexes[position - 1];
+            position--;
+        }
+        angles[position] = abs_scalar;
+        indexes[position] = n;
+    }
+
+    for (size_t n = 0; n < found; n++){
+        quat_view_get(q_refs, indexes[n], &crrt_ref);
+        angles[n] = quat_angle(q, &crrt_ref);
+    }
+
+    return found;
+}
+
+// ---------------------------------------------
+// Unit vectors encoding
+// ---------------------------------------------
+
+F_TYPE vec3_angle(Vec3 const * v1, Vec3 const * v2){
+    Vec3 cross;
+    vec3_cross(v1, v2, &cross);
+    return F_TYPE_ATAN2(vec3_norm(&cross), vec3_scalar(v1, v2));
+}
+
+// sign, with sign(0) = 1, as needed by the octahedral folding
+static F_TYPE oct_sign(F_TYPE x){
+    return x >= F_TYPE_0 ? F_TYPE_1 : -F_TYPE_1;
+}
+
+uint32_t vec3_oct_encode(Vec3 const * v, unsigned bits_per_component){
+    F_TYPE l1_norm = F_TYPE_ABS(v->i) + F_TYPE_ABS(v->j) + F_TYPE_ABS(v->k);
+    F_TYPE u = v->i / l1_norm;
+    F_TYPE w = v->j / l1_norm;
+
+    // fold the lower half of the octahedron over the upper half
+    if (v->k < F_TYPE_0){
+        F_TYPE u_folded = (F_TYPE_1 - F_TYPE_ABS(w)) * oct_sign(u);
+        w = (F_TYPE_1 - F_TYPE_ABS(u)) * oct_sign(w);
+        u = u_folded;
+    }
+
+    // quantize [-1, 1] on [0, 2^bits - 1], rounding to the nearest
+    uint32_t max_level = (1u << bits_per_component) - 1u;
+    F_TYPE scale = F_TYPE_05 * KISS_CAST(F_TYPE, max_level);
+    uint32_t u_quantized = KISS_CAST(uint32_t, F_TYPE_FLOOR((u + F_TYPE_1) * scale + F_TYPE_05));
+    uint32_t w_quantized = KISS_CAST(uint32_t, F_TYPE_FLOOR((w + F_TYPE_1) * scale + F_TYPE_05));
+
+    return u_quantized | (w_quantized << bits_per_component);
+}
+
+void vec3_oct_decode(uint32_t code, unsigned bits_per_component, Vec3 * v_out){
+    uint32_t max_level = (1u << bits_per_component) - 1u;
+    F_TYPE scale = F_TYPE_2 / KISS_CAST(F_TYPE, max_level);
+    F_TYPE u = KISS_CAST(F_TYPE, code & max_level) * scale - F_TYPE_1;
+    F_TYPE w = KISS_CAST(F_TYPE, (code >> bits_per_component) & max_level) * scale - F_TYPE_1;
+
+    v_out->k = F_TYPE_1 - F_TYPE_ABS(u) - F_TYPE_ABS(w);
+
+    // unfold the lower half of the octahedron
+    if (v_out->k < F_TYPE_0){
+        v_out->i = (F_TYPE_1 - F_TYPE_ABS(w)) * oct_sign(u);
+        v_out->j = (F_TYPE_1 - F_TYPE_ABS(u)) * oct_sign(w);
+    }
+    else{
+        v_out->i = u;
+        v_out->j = w;
+    }
+
+    vec3_scale(v_out, F_TYPE_1 / vec3_norm(v_out));
+}
+
+void vec3_oct_encode_batch(Vec3_View const * v_in, unsigned bits_per_component, unsigned char * codes, F_TYPE * max_angular_error){
+    size_t code_size = vec3_oct_code_size(bits_per_component);
+    F_TYPE crrt_max_angular_error = F_TYPE_0;
+    Vec3 crrt;
+    Vec3 crrt_decoded;
+
+    for (size_t n = 0; n < v_in->count; n++){
+        vec3_view_get(v_in, n, &crrt);
+        uint32_t code = vec3_oct_encode(&crrt, bits_per_component);
+
+        for (size_t byte = 0; byte < code_size; byte++){
+            codes[n * code_size + byte] = KISS_CAST(unsigned char, (code >> (8 * byte)) & 0xFFu);
+        }
+
+        if (max_angular_error != NULL){
+            vec3_oct_decode(code, bits_per_component, &crrt_decoded);
+            F_TYPE crrt_angular_error = vec3_angle(&crrt, &crrt_decoded);
+            if (crrt_angular_error > crrt_max_angular_error){
+                crrt_max_angular_error = crrt_angular_error;
+            }
+        }
+    }
+
+    if (max_angular_error != NULL){
+        *max_angular_error = crrt_max_angular_error;
+    }
+}
+
+void vec3_oct_decode_batch(unsigned char const * codes, unsigned bits_per_component, Vec3_View const * v_out){
+    size_t code_size = vec3_oct_code_size(bits_per_component);
+    Vec3 crrt;
+
+    for (size_t n = 0; n < v_out->count; n++){
+        uint32_t code = 0;
+        for (size_t byte = 0; byte < code_size; byte++){
+            code |= KISS_CAST(uint32_t, codes[n * code_size + byte]) << (8 * byte);
+        }
+
+        vec3_oct_decode(code, bits_per_component, &crrt);
+        vec3_view_set(v_out, n, &crrt);
+    }
+}
+
+// ---------------------------------------------
+// Octahedral rotations
+// ---------------------------------------------
+
+bool quat_to_octahedral_rotation(Quat const * q, Octahedral_Rotation * rotation, F_TYPE tolerance){
+    // the columns of the rotation matrix are the rotated axes
+    Vec3 const axes[3] {
+        {F_TYPE_1, F_TYPE_0, F_TYPE_0},
+        {F_TYPE_0, F_TYPE_1, F_TYPE_0},
+        {F_TYPE_0, F_TYPE_0, F_TYPE_1}
+    };
+    F_TYPE matrix[3][3];
+    Vec3 column;
+
+    for (size_t col = 0; col < 3; col++){
+        rotate_by_quat_R(&axes[col], q, &column);
+        matrix[0][col] = column.i;
+        matrix[1][col] = column.j;
+        matrix[2][col] = column.k;
+    }
+
+    // each row must have a single entry +-1, and zeros elsewhere, in distinct columns
+    bool column_used[3] {false, false, false};
+
+    for (size_t row = 0; row < 3; row++){
+        size_t source = 0;
+        for (size_t col = 1; col < 3; col++){
+            if (F_TYPE_ABS(matrix[row][col]) > F_TYPE_ABS(matrix[row][source])){
+                source = col;
+            }
+        }
+
+        if (column_used[source]){
+            return false;
+        }
+        column_used[source] = true;
+
+        for (size_t col = 0; col < 3; col++){
+            F_TYPE expected = (col == source) ? F_TYPE_1 : F_TYPE_0;
+            if (F_TYPE_ABS(F_TYPE_ABS(matrix[row][col]) - expected) > tolerance){
+                return false;
+            }
+        }
+
+        rotation->source[row] = KISS_CAST(unsigned char, source);
+        rotation->negate[row] = matrix[row][source] < F_TYPE_0;
+    }
+
+    return true;
+}
+
+void octahedral_rotation_to_quat(Octahedral_Rotation const * rotation, Quat * q){
+    F_TYPE m[3][3] {
+        {F_TYPE_0, F_TYPE_0, F_TYPE_0},
+        {F_TYPE_0, F_TYPE_0, F_TYPE_0},
+        {F_TYPE_0, F_TYPE_0, F_TYPE_0}
+    };
+    for (size_t row = 0; row < 3; row++){
+        m[row][rotation->source[row]] = rotation->negate[row] ? -F_TYPE_1 : F_TYPE_1;
+    }
+
+    // rotation matrix to quaternion, from the largest of the 4 components (Shepperd)
+    F_TYPE trace = m[0][0] + m[1][1] + m[2][2];
+
+    if (trace >= m[0][0] && trace >= m[1][1] && trace >= m[2][2]){
+        F_TYPE two_r = F_TYPE_SQRT(F_TYPE_1 + trace);
+        q->r = two_r / F_TYPE_2;
+        q->i = (m[2][1] - m[1][2]) / (F_TYPE_2 * two_r);
+        q->j = (m[0][2] - m[2][0]) / (F_TYPE_2 * two_r);
+        q->k = (m[1][0] - m[0][1]) / (F_TYPE_2 * two_r);
+    }
+    else if (m[0][0] >= m[1][1] && m[0][0] >= m[2][2]){
+        F_TYPE two_i = F_TYPE_SQRT(F_TYPE_1 + m[0][0] - m[1][1] - m[2][2]);
+        q->r = (m[2][1] - m[1][2]) / (F_TYPE_2 * two_i);
+        q->i = two_i / F_TYPE_2;
+        q->j = (m[0][1] + m[1][0]) / (F_TYPE_2 * two_i);
+        q->k = (m[0][2] + m[2][0]) / (F_TYPE_2 * two_i);
+    }
+    else if (m[1][1] >= m[2][2]){
+        F_TYPE two_j = F_TYPE_SQRT(F_TYPE_1 - m[0][0] + m[1][1] - m[2][2]);
+        q->r = (m[0][2] - m[2][0]) / (F_TYPE_2 * two_j);
+        q->i = (m[0][1] + m[1][0]) / (F_TYPE_2 * two_j);
+        q->j = two_j / F_TYPE_2;
+        q->k = (m[1][2] + m[2][1]) / (F_TYPE_2 * two_j);
+    }
+    else{
+        F_TYPE two_k = F_TYPE_SQRT(F_TYPE_1 - m[0][0] - m[1][1] + m[2][2]);
+        q->r = (m[1][0] - m[0][1]) / (F_TYPE_2 * two_k);
+        q->i = (m[0][2] + m[2][0]) / (F_TYPE_2 * two_k);
+        q->j = (m[1][2] + m[2][1]) / (F_TYPE_2 * two_k);
+        q->k = two_k / F_TYPE_2;
+    }
+
+    if (q->r < F_TYPE_0){
+        quat_setter(q, -q->r, -q->i, -q->j, -q->k);
+    }
+}
+
+void rotate_by_octahedral_rotation(Vec3 const * v, Octahedral_Rotation const * rotation, Vec3 * Rv){
+    F_TYPE const components[3] {v->i, v->j, v->k};
+    F_TYPE const vi = components[rotation->source[0]];
+    F_TYPE const vj = components[rotation->source[1]];
+    F_TYPE const vk = components[rotation->source[2]];
+
+    Rv->i = rotation->negate[0] ? -vi : vi;
+    Rv->j = rotation->negate[1] ? -vj : vj;
+    Rv->k = rotation->negate[2] ? -vk : vk;
+}
+
+void rotate_by_octahedral_rotation_batch(Vec3_View const * v_in, Octahedral_Rotation const * rotation, Vec3_View const * v_out){
+    size_t count = min_count(v_in->count, v_out->count);
+    Vec3 crrt_in;
+    Vec3 crrt_out;
+
+    for (size_t n = 0; n < count; n++){
+        vec3_view_get(v_in, n, &crrt_in);
+        rotate_by_octahedral_rotation(&crrt_in, rotation, &crrt_out);
+        vec3_view_set(v_out, n, &crrt_out);
+    }
+}
+
+// ---------------------------------------------
+// Tangent space: exponential and logarithm maps
+// ---------------------------------------------
+
+void quat_exp(Vec3 const * v, Quat * q_out){
+    F_TYPE angle_square = vec3_norm_square(v);
+    F_TYPE cos_of_half;
+    F_TYPE sin_of_half_o_angle;
+
+    if (angle_square * angle_square < F_TYPE_EPS){
+        // cos(a / 2) and sin(a / 2) / a, to the order 4 in a
+        cos_of_half = F_TYPE_1 - angle_square / 8 + angle_square * angle_square / 384;
+        sin_of_half_o_angle = F_TYPE_05 - angle_square / 48 + angle_square * angle_square / 3840;
+    }
+    else{
+        F_TYPE angle = F_TYPE_SQRT(angle_square);
+        cos_of_half = F_TYPE_COS(angle / F_TYPE_2);
+        sin_of_half_o_angle = F_TYPE_SIN(angle / F_TYPE_2) / angle;
+    }
+
+    q_out->r = cos_of_half;
+    q_out->i = sin_of_half_o_angle * v->i;
+    q_out->j = sin_of_half_o_angle * v->j;
+    q_out->k = sin_of_half_o_angle * v->k;
+}
+
+void quat_log(Quat const * q, Vec3 * v_out){
+    // q and -q are the same rotation: use the one with r >= 0, i.e. an angle in [0, pi]
+    F_TYPE sign = (q->r < F_TYPE_0) ? -F_TYPE_1 : F_TYPE_1;
+    F_TYPE r = sign * q->r;
+    F_TYPE sin_of_half_square = q->i * q->i + q->j * q->j + q->k * q->k;
+    F_TYPE angle_o_sin_of_half;
+
+    if (sin_of_half_square * sin_of_half_square < F_TYPE_EPS){
+        // 2 atan(s / r) / s, to the order 2 in s
+        angle_o_sin_of_half = F_TYPE_2 / r * (F_TYPE_1 - sin_of_half_square / (3 * r * r));
+    }
+    else{
+        F_TYPE sin_of_half = F_TYPE_SQRT(sin_of_half_square);
+        angle_o_sin_of_half = F_TYPE_2 * F_TYPE_ATAN2(sin_of_half, r) / sin_of_half;
+    }
+
+    v_out->i = sign * angle_o_sin_of_half * q->i;
+    v_out->j = sign * angle_o_sin_of_half * q->j;
+    v_out->k = sign * angle_o_sin_of_half * q->k;
+}
+
+void quat_boxplus(Quat const * q, Vec3 const * delta, Quat * q_out){
+    Quat q_delta;
+    quat_exp(delta, &q_delta);
+    quat_prod(q, &q_delta, q_out);
+}
+
+void quat_boxminus(Quat const * q_1, Quat const * q_2, Vec3 * delta_out){
+    Quat q_2_conj;
+    Quat q_difference;
+    quat_copy(q_2, &q_2_conj);
+    quat_conj(&q_2_conj);
+    quat_prod(&q_2_conj, q_1, &q_difference);
+    quat_log(&q_difference, delta_out);
+}
+
+void quat_exp_batch(Vec3_View const * v_in, Quat_View const * q_out){
+    size_t count = min_count(v_in->count, q_out->count);
+    Vec3 crrt_in;
+    Quat crrt_out;
+
+    for (size_t n = 0; n < count; n++){
+        vec3_view_get(v_in, n, &crrt_in);
+        quat_exp(&crrt_in, &crrt_out);
+        quat_view_set(q_out, n, &crrt_out);
+    }
+}
+
+void quat_log_batch(Quat_View const * q_in, Vec3_View const * v_out){
+    size_t count = min_count(q_in->count, v_out->count);
+    Quat crrt_in;
+    Vec3 crrt_out;
+
+    for (size_t n = 0; n < count; n++){
+        quat_view_get(q_in, n, &crrt_in);
+        quat_log(&crrt_in, &crrt_out);
+        vec3_view_set(v_out, n, &crrt_out);
+    }
+}
+
+void quat_boxplus_batch(Quat_View const * q_in, Vec3_View const * deltas, Quat_View const * q_out){
+    size_t count = min_count(min_count(q_in->count, deltas->count), q_out->count);
+    Quat crrt_in;
+    Vec3 crrt_delta;
+    Quat crrt_out;
+
+    for (size_t n = 0; n < count; n++){
+        quat_view_get(q_in, n, &crrt_in);
+        vec3_view_get(deltas, n, &crrt_delta);
+        quat_boxplus(&crrt_in, &crrt_delta, &crrt_out);
+        quat_view_set(q_out, n, &crrt_out);
+    }
+}
+
+void quat_boxminus_batch(Quat_View const * q_1, Quat_View const * q_2, Vec3_View const * deltas_out){
+    size_t count = min_count(min_count(q_1->count, q_2->count), deltas_out->count);
+    Quat crrt_1;
+    Quat crrt_2;
+    Vec3 crrt_delta;
+
+    for (size_t n = 0; n < count; n++){
+        quat_view_get(q_1, n, &crrt_1);
+        quat_view_get(q_2, n, &crrt_2);
+        quat_boxminus(&crrt_1, &crrt_2, &crrt_delta);
+        vec3_view_set(deltas_out, n, &crrt_delta);
+    }
+}
+
+// 1 / dt, and 0 for an interval that is not > 0, without branching
+static F_TYPE inverse_of_interval(F_TYPE dt){
+    return KISS_CAST(F_TYPE, dt > F_TYPE_0) / F_TYPE_FMAX(dt, F_TYPE_MIN);
+}
+
+// quat_boxminus(q_2, q_1) * inv_dt, without branching: the sign flip to the shortest of
+// q and -q uses copysign, and 2 atan2(s, |r|) / s is accurate for any s, so that the
+// series of quat_log close to the identity is not needed (below the smallest normal s,
+// the result is null to the precision anyway)
+static void angular_velocity_step(Quat const * q_1, Quat const * q_2, F_TYPE inv_dt, Vec3 * w_out){
+    Quat q_1_conj;
+    Quat q_difference;
+    quat_copy(q_1, &q_1_conj);
+    quat_conj(&q_1_conj);
+    quat_prod(&q_1_conj, q_2, &q_difference);
+
+    F_TYPE sin_of_half = F_TYPE_SQRT(q_difference.i * q_difference.i + q_difference.j * q_difference.j + q_difference.k * q_difference.k);
+    F_TYPE angle_o_sin_of_half = F_TYPE_2 * F_TYPE_ATAN2(sin_of_half, F_TYPE_ABS(q_difference.r)) / F_TYPE_FMAX(sin_of_half, F_TYPE_MIN);
+    F_TYPE scale = F_TYPE_COPYSIGN(angle_o_sin_of_half * inv_dt, q_difference.r);
+
+    w_out->i = scale * q_difference.i;
+    w_out->j = scale * q_difference.j;
+    w_out->k = scale * q_difference.k;
+}
+
+void quat_angular_velocity(Quat const * q_1, Quat const * q_2, F_TYPE dt, Vec3 * w_out){
+    angular_velocity_step(q_1, q_2, inverse_of_interval(dt), w_out);
+}
+
+size_t quat_angular_velocity_batch(Quat_View const * q_in, F_TYPE dt, Vec3_View const * w_out){
+    if (q_in->count < 2){
+        return 0;
+    }
+
+    size_t count = min_count(q_in->count - 1, w_out->count);
+    F_TYPE inv_dt = inverse_of_interval(dt);
+    Quat crrt_previous;
+    Quat crrt_next;
+    Vec3 crrt_w;
+
+    // each attitude is read once, and kept for the next interval
+    quat_view_get(q_in, 0, &crrt_previous);
+    for (size_t n = 0; n < count; n++){
+        quat_view_get(q_in, n + 1, &crrt_next);
+        angular_velocity_step(&crrt_previous, &crrt_next, inv_dt, &crrt_w);
+        vec3_view_set(w_out, n, &crrt_w);
+        quat_copy(&crrt_next, &crrt_previous);
+    }
+
+    return count;
+}
+
+size_t quat_angular_velocity_times_batch(Quat_View const * q_in, F_TYPE const * times, Vec3_View const * w_out){
+    if (q_in->count < 2){
+        return 0;
+    }
+
+    size_t count = min_count(q_in->count - 1, w_out->count);
+    Quat crrt_previous;
+    Quat crrt_next;
+    Vec3 crrt_w;
+
+    quat_view_get(q_in, 0, &crrt_previous);
+    for (size_t n = 0; n < count; n++){
+        quat_view_get(q_in, n + 1, &crrt_next);
+        angular_velocity_step(&crrt_previous, &crrt_next, inverse_of_interval(times[n + 1] - times[n]), &crrt_w);
+        vec3_view_set(w_out, n, &crrt_w);
+        quat_copy(&crrt_next, &crrt_previous);
+    }
+
+    return count;
+}
+
+// ---------------------------------------------
+// Swing twist decomposition and joint limits
+// ---------------------------------------------
+
+bool quat_swing_twist(Quat const * q, Vec3 const * twist_axis, Quat * swing, Quat * twist, F_TYPE tolerance){
+    if (vec3_is_null(twist_axis, tolerance)){
+        return false;
+    }
+
+    // the twist is the projection of the vector part on the axis, normalized
+    F_TYPE projection = (q->i * twist_axis->i + q->j * twist_axis->j + q->k * twist_axis->k) / vec3_norm_square(twist_axis);
+    quat_setter(twist, q->r, projection * twist_axis->i, projection * twist_axis->j, projection * twist_axis->k);
+
+    F_TYPE twist_norm = quat_norm(twist);
+    if (twist_norm <= F_TYPE_EPS){
+        quat_setter(twist, F_TYPE_1, F_TYPE_0, F_TYPE_0, F_TYPE_0);
+    }
+    else{
+        if (twist->r < F_TYPE_0){
+            twist_norm = -twist_norm;
+        }
+        quat_setter(twist, twist->r / twist_norm, twist->i / twist_norm, twist->j / twist_norm, twist->k / twist_norm);
+    }
+
+    Quat twist_conj;
+    quat_copy(twist, &twist_conj);
+    quat_conj(&twist_conj);
+    quat_prod(q, &twist_conj, swing);
+
+    return true;
+}
+
+bool quat_swing_twist_batch(Quat_View const * q_in, Vec3 const * twist_axis, Quat_View const * swings, Quat_View const * twists, F_TYPE tolerance){
+    if (vec3_is_null(twist_axis, tolerance)){
+        return false;
+    }
+
+    size_t count = min_count(min_count(q_in->count, swings->count), twists->count);
+    Quat crrt_in;
+    Quat crrt_swing;
+    Quat crrt_twist;
+
+    for (size_t n = 0; n < count; n++){
+        quat_view_get(q_in, n, &crrt_in);
+        quat_swing_twist(&crrt_in, twist_axis, &crrt_swing, &crrt_twist, tolerance);
+        quat_view_set(swings, n, &crrt_swing);
+        quat_view_set(twists, n, &crrt_twist);
+    }
+
+    return true;
+}
+
+bool joint_limits_setter(Joint_Limits * limits, Vec3 const * twist_axis, F_TYPE swing_max_rad, F_TYPE twist_min_rad, F_TYPE twist_max_rad, F_TYPE tolerance){
+    bool valid_limits = (
+        swing_max_rad >= F_TYPE_0 && swing_max_rad <= F_TYPE_PI &&
+        twist_min_rad >= -F_TYPE_PI && twist_min_rad <= twist_max_rad && twist_max_rad <= F_TYPE_PI
+    );
+
+    if (!valid_limits || vec3_is_null(twist_axis, tolerance)){
+        return false;
+    }
+
+    vec3_copy(twist_axis, &limits->twist_axis);
+    vec3_normalize(&limits->twist_axis);
+    limits->cos_half_swing_max = F_TYPE_COS(swing_max_rad / F_TYPE_2);
+    limits->sin_half_swing_max = F_TYPE_SIN(swing_max_rad / F_TYPE_2);
+    limits->cos_half_twist_min = F_TYPE_COS(twist_min_rad / F_TYPE_2);
+    limits->sin_half_twist_min = F_TYPE_SIN(twist_min_rad / F_TYPE_2);
+    limits->cos_half_twist_max = F_TYPE_COS(twist_max_rad / F_TYPE_2);
+    limits->sin_half_twist_max = F_TYPE_SIN(twist_max_rad / F_TYPE_2);
+
+    return true;
+}
+
+// the twist of q around the unit axis, as the cos and sin of its half angle, i.e. the
+// twist is [cos_half, sin_half * axis], with cos_half >= 0
+static void twist_of(Quat const * q, Vec3 const * unit_axis, F_TYPE * cos_half, F_TYPE * sin_half){
+    F_TYPE projection = q->i * unit_axis->i + q->j * unit_axis->j + q->k * unit_axis->k;
+    F_TYPE twist_norm = F_TYPE_SQRT(q->r * q->r + projection * projection);
+
+    if (twist_norm <= F_TYPE_EPS){
+        *cos_half = F_TYPE_1;
+        *sin_half = F_TYPE_0;
+        return;
+    }
+
+    if (q->r < F_TYPE_0){
+        twist_norm = -twist_norm;
+    }
+    *cos_half = q->r / twist_norm;
+    *sin_half = projection / twist_norm;
+}
+
+bool quat_clamp_to_limits(Quat const * q, Joint_Limits const * limits, Quat * q_out){
+    Vec3 const * axis = &limits->twist_axis;
+    F_TYPE twist_cos_half;
+    F_TYPE twist_sin_half;
+    twist_of(q, axis, &twist_cos_half, &twist_sin_half);
+
+    Quat twist_conj {twist_cos_half, -twist_sin_half * axis->i, -twist_sin_half * axis->j, -twist_sin_half * axis->k};
+    Quat swing;
+    quat_prod(q, &twist_conj, &swing);
+    if (swing.r < F_TYPE_0){
+        quat_setter(&swing, -swing.r, -swing.i, -swing.j, -swing.k);
+    }
+
+    bool clamped = false;
+
+    // the swing angle is at most swing max if the cos of its half is at least the one of the limit
+    if (swing.r < limits->cos_half_swing_max){
+        F_TYPE scale = limits->sin_half_swing_max / F_TYPE_SQRT(swing.i * swing.i + swing.j * swing.j + swing.k * swing.k);
+        quat_setter(&swing, limits->cos_half_swing_max, scale * swing.i, scale * swing.j, scale * swing.k);
+        clamped = true;
+    }
+
+    // the half twist angle is in [-pi / 2, pi / 2], where its sin is increasing
+    if (twist_sin_half < limits->sin_half_twist_min){
+        twist_cos_half = limits->cos_half_twist_min;
+        twist_sin_half = limits->sin_half_twist_min;
+        clamped = true;
+    }
+    else if (twist_sin_half > limits->sin_half_twist_max){
+        twist_cos_half = limits->cos_half_twist_max;
+        twist_sin_half = limits->sin_half_twist_max;
+        clamped = true;
+    }
+
+    if (!clamped){
+        quat_copy(q, q_out);
+        return false;
+    }
+
+    Quat const twist {twist_cos_half, twist_sin_half * axis->i, twist_sin_half * axis->j, twist_sin_half * axis->k};
+    quat_prod(&swing, &twist, q_out);
+    return true;
+}
+
+size_t quat_clamp_to_limits_batch(Quat_View const * q_in, Joint_Limits const * limits, Quat_View const * q_out){
+    size_t count = min_count(q_in->count, q_out->count);
+    size_t nbr_clamped = 0;
+    Quat crrt_in;
+    Quat crrt_out;
+
+    for (size_t n = 0; n < count; n++){
+        quat_view_get(q_in, n, &crrt_in);
+        if (quat_clamp_to_limits(&crrt_in, limits, &crrt_out)){
+            nbr_clamped++;
+        }
+        quat_view_set(q_out, n, &crrt_out);
+    }
+
+    return nbr_clamped;
+}
+
+// ---------------------------------------------
+// Point clouds
+// ---------------------------------------------
+
+void cloud_stats_clear(Cloud_Stats * stats){
+    stats->count = 0;
+    vec3_setter(&stats->box_min, F_TYPE_MAX, F_TYPE_MAX, F_TYPE_MAX);
+    vec3_setter(&stats->box_max, -F_TYPE_MAX, -F_TYPE_MAX, -F_TYPE_MAX);
+    vec3_setter(&stats->mean, F_TYPE_0, F_TYPE_0, F_TYPE_0);
+    for (size_t n = 0; n < 6; n++){
+        stats->comoments[n] = F_TYPE_0;
+    }
+}
+
+void cloud_stats_merge(Cloud_Stats * stats_acc, Cloud_Stats const * stats_add){
+    if (stats_add->count == 0){
+        return;
+    }
+    if (stats_acc->count == 0){
+        *stats_acc = *stats_add;
+        return;
+    }
+
+    F_TYPE count_acc = KISS_CAST(F_TYPE, stats_acc->count);
+    F_TYPE count_add = KISS_CAST(F_TYPE, stats_add->count);
+    F_TYPE count_total = count_acc + count_add;
+    F_TYPE delta[3] = {
+        stats_add->mean.i - stats_acc->mean.i,
+        stats_add->mean.j - stats_acc->mean.j,
+        stats_add->mean.k - stats_acc->mean.k
+    };
+    F_TYPE weight = count_acc * count_add / count_total;
+
+    size_t position = 0;
+    for (size_t row = 0; row < 3; row++){
+        for (size_t col = row; col < 3; col++){
+            stats_acc->comoments[position] += stats_add->comoments[position] + delta[row] * delta[col] * weight;
+            position++;
+        }
+    }
+
+    stats_acc->mean.i += delta[0] * count_add / count_total;
+    stats_acc->mean.j += delta[1] * count_add / count_total;
+    stats_acc->mean.k += delta[2] * count_add / count_total;
+
+    stats_acc->box_min.i = stats_add->box_min.i < stats_acc->box_min.i ? stats_add->box_min.i : stats_acc->box_min.i;
+    stats_acc->box_min.j = stats_add->box_min.j < stats_acc->box_min.j ? stats_add->box_min.j : stats_acc->box_min.j;
+    stats_acc->box_min.k = stats_add->box_min.k < stats_acc->box_min.k ? stats_add->box_min.k : stats_acc->box_min.k;
+    stats_acc->box_max.i = stats_add->box_max.i > stats_acc->box_max.i ? stats_add->box_max.i : stats_acc->box_max.i;
+    stats_acc->box_max.j = stats_add->box_max.j > stats_acc->box_max.j ? stats_add->box_max.j : stats_acc->box_max.j;
+    stats_acc->box_max.k = stats_add->box_max.k > stats_acc->box_max.k ? stats_add->box_max.k : stats_acc->box_max.k;
+
+    stats_acc->count += stats_add->count;
+}
+
+bool cloud_stats_covariance(Cloud_Stats const * stats, F_TYPE covariance[6]){
+    if (stats->count == 0){
+        return false;
+    }
+
+    for (size_t n = 0; n < 6; n++){
+        covariance[n] = stats->comoments[n] / KISS_CAST(F_TYPE, stats->count);
+    }
+
+    return true;
+}
+
+void cloud_transform_reduce_batch(Vec3_View const * v_in, Quat const * q, Vec3 const * translation, Vec3_View const * v_out, Cloud_Stats * stats){
+    // small enough for the sums of a block to stay accurate in float
+    size_t const block_size = 256;
+    size_t count = (v_out == NULL || v_in->count < v_out->count) ? v_in->count : v_out->count;
+    Vec3 crrt_in;
+    Vec3 crrt;
+    Cloud_Stats block_stats;
+
+    for (size_t first = 0; first < count; first += block_size){
+        size_t last = count - first < block_size ? count : first + block_size;
+        // the first point of the block, set in the loop
+        Vec3 shift {F_TYPE_0, F_TYPE_0, F_TYPE_0};
+        F_TYPE sums[3] = {F_TYPE_0, F_TYPE_0, F_TYPE_0};
+        F_TYPE sums_products[6] = {F_TYPE_0, F_TYPE_0, F_TYPE_0, F_TYPE_0, F_TYPE_0, F_TYPE_0};
+
+        cloud_stats_clear(&block_stats);
+
+        for (size_t n = first; n < last; n++){
+            vec3_view_get(v_in, n, &crrt_in);
+            if (q != NULL){
+                rotate_by_quat_R(&crrt_in, q, &crrt);
+            }
+            else{
+                vec3_copy(&crrt_in, &crrt);
+            }
+            if (translation != NULL){
+                vec3_add(&crrt, translation);
+            }
+            if (v_out != NULL){
+                vec3_view_set(v_out, n, &crrt);
+            }
+
+            if (n == first){
+                vec3_copy(&crrt, &shift);
+            }
+            F_TYPE di = crrt.i - shift.i;
+            F_TYPE dj = crrt.j - shift.j;
+            F_TYPE dk = crrt.k - shift.k;
+            sums[0] += di;
+            sums[1] += dj;
+            sums[2] += dk;
+            sums_products[0] += di * di;
+            sums_products[1] += di * dj;
+            sums_products[2] += di * dk;
+            sums_products[3] += dj * dj;
+            sums_products[4] += dj * dk;
+            sums_products[5] += dk * dk;
+
+            block_stats.box_min.i = crrt.i < block_stats.box_min.i ? crrt.i : block_stats.box_min.i;
+            block_stats.box_min.j = crrt.j < block_stats.box_min.j ? crrt.j : block_stats.box_min.j;
+            block_stats.box_min.k = crrt.k < block_stats.box_min.k ? crrt.k : block_stats.box_min.k;
+            block_stats.box_max.i = crrt.i > block_stats.box_max.i ? crrt.i : block_stats.box_max.i;
+            block_stats.box_max.j = crrt.j > block_stats.box_max.j ? crrt.j : block_stats.box_max.j;
+            block_stats.box_max.k = crrt.k > block_stats.box_max.k ? crrt.k : block_stats.box_max.k;
+        }
+
+        // shifted sums to mean and comoments
+        F_TYPE block_count = KISS_CAST(F_TYPE, last - first);
+        block_stats.count = last - first;
+        block_stats.mean.i = shift.i + sums[0] / block_count;
+        block_stats.mean.j = shift.j + sums[1] / block_count;
+        block_stats.mean.k = shift.k + sums[2] / block_count;
+        size_t position = 0;
+        for (size_t row = 0; row < 3; row++){
+            for (size_t col = row; col < 3; col++){
+                block_stats.comoments[position] = sums_products[position] - sums[row] * sums[col] / block_count;
+                position++;
+            }
+        }
+
+        cloud_stats_merge(stats, &block_stats);
+    }
+}
+
@@ -0,0 +1,238 @@
+#include "kiss_clang_3d_kd_tree.h"
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// ------------------------------------------------------------
+// INTERNALS
+// ------------------------------------------------------------
+
+// the split axis of a range, cycling i, j, k with the depth
+static F_TYPE coordinate(Vec3 const * v, size_t depth){
+    switch (depth % 3){
+        case 0:
+            return v->i;
+        case 1:
+            return v->j;
+        default:
+            return v->k;
+    }
+}
+
+static F_TYPE dist_square(Vec3 const * v_1, Vec3 const * v_2){
+    F_TYPE di = v_1->i - v_2->i;
+    F_TYPE dj = v_1->j - v_2->j;
+    F_TYPE dk = v_1->k - v_2->k;
+    return di * di + dj * dj + dk * dk;
+}
+
+static void swap_points(Vec3 * points, size_t * original_indexes, size_t a, size_t b){
+    Vec3 tmp_point = points[a];
+    points[a] = points[b];
+    points[b] = tmp_point;
+
+    if (original_indexes != NULL){
+        size_t tmp_index = original_indexes[a];
+        original_indexes[a] = original_indexes[b];
+        original_indexes[b] = tmp_index;
+    }
+}
+
+// quickselect of the median position nth of [low, high), with a 3 way partition so
+// that many equal coordinates (for example a planar cloud) stay O(n)
+static void select_median(Vec3 * points, size_t * original_indexes, size_t low, size_t high, size_t nth, size_t depth){
+    while (high - low > 1){
+        F_TYPE pivot = coordinate(&points[low + (high - low) / 2], depth);
+
+        // [low, less) < pivot, [less, crrt) == pivot, [greater, high) > pivot
+        size_t less = low;
+        size_t crrt = low;
+        size_t greater = high;
+        while (crrt < greater){
+            F_TYPE value = coordinate(&points[crrt], depth);
+            if (value < pivot){
+                swap_points(points, original_indexes, less, crrt);
+                less++;
+                crrt++;
+            }
+            else if (value > pivot){
+                greater--;
+                swap_points(points, original_indexes, crrt, greater);
+            }
+            else{
+                crrt++;
+            }
+        }
+
+        if (nth < less){
+            high = less;
+        }
+        else if (nth >= greater){
+            low = greater;
+        }
+        else{
+            return;
+        }
+    }
+}
+
+static void build_range(Vec3 * points, size_t * original_indexes, size_t low, size_t high, size_t depth){
+    if (high - low <= 1){
+        return;
+    }
+
+    size_t middle = low + (high - low) / 2;
+    select_median(points, original_indexes, low, high, middle, depth);
+    build_range(points, original_indexes, low, middle, depth + 1);
+    build_range(points, original_indexes, middle + 1, high, depth + 1);
+}
+
+// the k best so far, sorted by increasing distance
+struct Nearest_Search {
+    Vec3 const * points;
+    Vec3 const * query;
+    size_t k;
+    size_t found;
+    size_t * indexes;
+    F_TYPE * dist_squares;
+};
+
+static F_TYPE worst_dist_square(Nearest_Search const * search){
+    return search->found < search->k ? F_TYPE_MAX : search->dist_squares[search->k - 1];
+}
+
+static void consider_nearest(Nearest_Search * search, size_t index){
+    F_TYPE crrt_dist_square = dist_square(&search->points[index], search->query);
+
+    if (search->found == search->k && crrt_dist_square >= search->dist_squares[search->k - 1]){
+        return;
+    }
+
+    size_t position = search->found < search->k ? search->found++ : search->k - 1;
+    while (position > 0 && search->dist_squares[position - 1] > crrt_dist_square){
+        search->dist_squares[position] = search->dist_squares[position - 1];
+        search->indexes[position] = search->indexes[position - 1];
+        position--;
+    }
+    search->dist_squares[position] = crrt_dist_square;
+    search->indexes[position] = index;
+}
+
+static void search_nearest(Nearest_Search * search, size_t low, size_t high, size_t depth){
+    if (low >= high){
+        return;
+    }
+
+    size_t middle = low + (high - low) / 2;
+    consider_nearest(search, middle);
+
+    F_TYPE diff = coordinate(search->query, depth) - coordinate(&search->points[middle], depth);
+    bool below = diff < F_TYPE_0;
+
+    // the side of the query first, so that the other side is often pruned
+    search_nearest(search, below ? low : middle + 1, below ? middle : high, depth + 1);
+    if (diff * diff < worst_dist_square(search)){
+        search_nearest(search, below ? middle + 1 : low, below ? high : middle, depth + 1);
+    }
+}
+
+struct Radius_Search {
+    Vec3 const * points;
+    Vec3 const * query;
+    F_TYPE radius_square;
+    size_t found;
+    size_t * indexes;
+    size_t max_indexes;
+};
+
+static void search_radius(Radius_Search * search, size_t low, size_t high, size_t depth){
+    if (low >= high){
+        return;
+    }
+
+    size_t middle = low + (high - low) / 2;
+    if (dist_square(&search->points[middle], search->query) <= search->radius_square){
+        if (search->found < search->max_indexes){
+            search->indexes[search->found] = middle;
+        }
+        search->found++;
+    }
+
+    F_TYPE diff = coordinate(search->query, depth) - coordinate(&search->points[middle], depth);
+
+    if (diff <= F_TYPE_0 || diff * diff <= search->radius_square){
+        search_radius(search, low, middle, depth + 1);
+    }
+    if (diff >= F_TYPE_0 || diff * diff <= search->radius_square){
+        search_radius(search, middle + 1, high, depth + 1);
+    }
+}
+
+// ------------------------------------------------------------
+// FUNCTIONS DEFINITIONS
+// ------------------------------------------------------------
+
+bool kd_tree_build(KD_Tree * tree, Vec3 * points, size_t count, size_t * original_indexes){
+    if (points == NULL){
+        return false;
+    }
+
+    if (original_indexes != NULL){
+        for (size_t n = 0; n < count; n++){
+            original_indexes[n] = n;
+        }
+    }
+
+    build_range(points, original_indexes, 0, count, 0);
+
+    tree->points = points;
+    tree->count = count;
+
+    return true;
+}
+
+size_t kd_tree_nearest(KD_Tree const * tree, Vec3 const * query, size_t k, size_t * indexes, F_TYPE * dist_squares){
+    if (k == 0){
+        return 0;
+    }
+
+    Nearest_Search search {tree->points, query, k, 0, indexes, dist_squares};
+    search_nearest(&search, 0, tree->count, 0);
+
+    for (size_t n = search.found; n < k; n++){
+        indexes[n] = KD_TREE_NOT_FOUND;
+        dist_squares[n] = F_TYPE_MAX;
+    }
+
+    return search.found;
+}
+
+size_t kd_tree_radius(KD_Tree const * tree, Vec3 const * query, F_TYPE radius, size_t * indexes, size_t max_indexes){
+    Radius_Search search {tree->points, query, radius * radius, 0, indexes, max_indexes};
+    search_radius(&search, 0, tree->count, 0);
+    return search.found;
+}
+
+size_t kd_tree_nearest_batch(KD_Tree const * tree, Vec3_View const * queries, size_t k, size_t * indexes, F_TYPE * dist_squares){
+    Vec3 crrt_query;
+
+    for (size_t n = 0; n < queries->count; n++){
+        vec3_view_get(queries, n, &crrt_query);
+        kd_tree_nearest(tree, &crrt_query, k, &indexes[n * k], &dist_squares[n * k]);
+    }
+
+    return queries->count;
+}
+
+size_t kd_tree_radius_batch(KD_Tree const * tree, Vec3_View const * queries, F_TYPE radius, size_t * counts, size_t * indexes, size_t max_indexes){
+    size_t total = 0;
+    Vec3 crrt_query;
+
+    for (size_t n = 0; n < queries->count; n++){
+        vec3_view_get(queries, n, &crrt_query);
+        size_t room = total < max_indexes ? max_indexes - total : 0;
+        counts[n] = kd_tree_radius(tree, &crrt_query, radius, room > 0 ? &indexes[total] : NULL, room);
+        total += counts[n];
+    }
+
+    return total;
+}
@@ -0,0 +1,72 @@
+#ifndef KISS_CLANG_3D_KD_TREE_H
+#define KISS_CLANG_3D_KD_TREE_H
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// k-d tree over an array of Vec3 points, in the default precision (F_TYPE), for
+// nearest neighbours and radius queries on point clouds without converting them to
+// the types of another library.
+// The tree is implicit: building it only reorders the points in place, so that the
+// median of each range (along the axis i, j, k, cycling with the depth) is in the
+// middle of the range, with the points before it on one side and the points after
+// it on the other. There are no nodes and no pointers, and no memory beyond the
+// points themselves (plus, optionally, the original index of each point). The
+// distances are compared squared, as vec3_norm_square, so there is no sqrt.
+
+#include "./kiss_clang_3d.h"
+
+// ------------------------------------------------------------
+// STRUCTS
+// ------------------------------------------------------------
+
+// --------------------------------------------------
+// the tree; use kd_tree_build to set it up, and only read the members
+struct KD_Tree {
+    Vec3 * points;
+    size_t count;
+};
+
+// index written for the missing neighbours, when there are less than k points
+#define KD_TREE_NOT_FOUND SIZE_MAX
+
+// ------------------------------------------------------------
+// FUNCTIONS DECLARATIONS
+// ------------------------------------------------------------
+
+/*
+Build the tree over the count points, reordering them in place (O(count log count) on
+average). If original_indexes is not null, it receives, for each position of the
+reordered array, the index the point had before. The indexes returned by the queries
+are positions in the reordered array. Return false if points is null.
+*/
+bool kd_tree_build(KD_Tree * tree, Vec3 * points, size_t count, size_t * original_indexes=NULL);
+
+/*
+The k nearest points to query, by increasing distance: their indexes and squared
+distances are written in the arrays of k elements. If the tree has less than k
+points, the end of the arrays is filled with KD_TREE_NOT_FOUND and F_TYPE_MAX.
+Return the number of neighbours found.
+*/
+size_t kd_tree_nearest(KD_Tree const * tree, Vec3 const * query, size_t k, size_t * indexes, F_TYPE * dist_squares);
+
+/*
+The points within radius of query (distance <= radius), in no particular order: the
+first max_indexes of them are written to indexes. Return the total number of points
+within radius, which is larger than max_indexes if the output was truncated.
+*/
+size_t kd_tree_radius(KD_Tree const * tree, Vec3 const * query, F_TYPE radius, size_t * indexes, size_t max_indexes);
+
+/*
+Batch versions, over a view of queries.
+kd_tree_nearest_batch writes the k results of query n at n * k in indexes and
+dist_squares, and returns the number of queries.
+kd_tree_radius_batch writes the number of points found for each query in counts, and
+the indexes one query after the other in indexes (the ones of query n start at the
+sum of the counts of the queries before it); it returns the total number of points
+found, and, as kd_tree_radius, the output is truncated if this is larger than
+max_indexes.
+*/
+size_t kd_tree_nearest_batch(KD_Tree const * tree, Vec3_View const * queries, size_t k, size_t * indexes, F_TYPE * dist_squares);
+size_t kd_tree_radius_batch(KD_Tree const * tree, Vec3_View const * queries, F_TYPE radius, size_t * counts, size_t * indexes, size_t max_indexes);
+
+#endif
@@ -0,0 +1,267 @@
+#include "kiss_clang_3d_mixed.h"
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// ------------------------------------------------------------
+// INTERNALS
+// ------------------------------------------------------------
+
+// double precision accumulator for quaternions
+struct Quat_Acc {
+    double r;
+    double i;
+    double j;
+    double k;
+};
+
+static void quat_acc_from_mixed(Quat_Mixed const * q_in, Quat_Acc * q_out){
+    q_out->r = KISS_CAST(double, q_in->r);
+    q_out->i = KISS_CAST(double, q_in->i);
+    q_out->j = KISS_CAST(double, q_in->j);
+    q_out->k = KISS_CAST(double, q_in->k);
+}
+
+static void quat_acc_to_mixed(Quat_Acc const * q_in, Quat_Mixed * q_out){
+    q_out->r = KISS_CAST(float, q_in->r);
+    q_out->i = KISS_CAST(float, q_in->i);
+    q_out->j = KISS_CAST(float, q_in->j);
+    q_out->k = KISS_CAST(float, q_in->k);
+}
+
+// same formula as quat_prod; q_result can not be one of the inputs
+static void quat_acc_prod(Quat_Acc const * q_left, Quat_Acc const * q_right, Quat_Acc * q_result){
+    q_result->r = q_left->r * q_right->r  -  q_left->i * q_right->i  -  q_left->j * q_right->j  -  q_left->k * q_right->k;
+    q_result->i = q_left->r * q_right->i  +  q_left->i * q_right->r  +  q_left->j * q_right->k  -  q_left->k * q_right->j;
+    q_result->j = q_left->r * q_right->j  -  q_left->i * q_right->k  +  q_left->j * q_right->r  +  q_left->k * q_right->i;
+    q_result->k = q_left->r * q_right->k  +  q_left->i * q_right->j  -  q_left->j * q_right->i  +  q_left->k * q_right->r;
+}
+
+static bool quat_acc_normalize(Quat_Acc * q){
+    double norm = sqrt(q->r * q->r + q->i * q->i + q->j * q->j + q->k * q->k);
+
+    if (norm <= 0.0){
+        return false;
+    }
+
+    q->r /= norm;
+    q->i /= norm;
+    q->j /= norm;
+    q->k /= norm;
+
+    return true;
+}
+
+// compensated float accumulator; this relies on strict IEEE float semantics, so
+// it must not be compiled with -ffast-math or similar.
+struct Compensated_Sum {
+    float sum;
+    float error;
+};
+
+// Kahan summation: the rounding error of each addition is kept in error, and
+// re-injected in the next addition
+static void compensated_add(Compensated_Sum * acc, float value){
+    float corrected_value = value - acc->error;
+    float new_sum = acc->sum + corrected_value;
+    acc->error = (new_sum - acc->sum) - corrected_value;
+    acc->sum = new_sum;
+}
+
+static float compensated_result(Compensated_Sum const * acc){
+    return acc->sum - acc->error;
+}
+
+// ------------------------------------------------------------
+// DEFINITIONS
+// ------------------------------------------------------------
+
+void mixed_vec3_to_vec3(Vec3_Mixed const * v_in, Vec3 * v_out){
+    v_out->i = F_TYPE_FROM_FLOAT(v_in->i);
+    v_out->j = F_TYPE_FROM_FLOAT(v_in->j);
+    v_out->k = F_TYPE_FROM_FLOAT(v_in->k);
+}
+
+void vec3_to_mixed_vec3(Vec3 const * v_in, Vec3_Mixed * v_out){
+    v_out->i = F_TYPE_TO_FLOAT(v_in->i);
+    v_out->j = F_TYPE_TO_FLOAT(v_in->j);
+    v_out->k = F_TYPE_TO_FLOAT(v_in->k);
+}
+
+void mixed_quat_to_quat(Quat_Mixed const * q_in, Quat * q_out){
+    q_out->r = F_TYPE_FROM_FLOAT(q_in->r);
+    q_out->i = F_TYPE_FROM_FLOAT(q_in->i);
+    q_out->j = F_TYPE_FROM_FLOAT(q_in->j);
+    q_out->k = F_TYPE_FROM_FLOAT(q_in->k);
+}
+
+void quat_to_mixed_quat(Quat const * q_in, Quat_Mixed * q_out){
+    q_out->r = F_TYPE_TO_FLOAT(q_in->r);
+    q_out->i = F_TYPE_TO_FLOAT(q_in->i);
+    q_out->j = F_TYPE_TO_FLOAT(q_in->j);
+    q_out->k = F_TYPE_TO_FLOAT(q_in->k);
+}
+
+void mixed_quat_prod_chain(Quat_Mixed const * q_array, size_t count, Quat_Mixed * q_result){
+    Quat_Acc acc {1.0, 0.0, 0.0, 0.0};
+    Quat_Acc crrt;
+    Quat_Acc prod;
+
+    for (size_t n = 0; n < count; n++){
+        quat_acc_from_mixed(&q_array[n], &crrt);
+        quat_acc_prod(&acc, &crrt, &prod);
+        acc = prod;
+    }
+
+    quat_acc_to_mixed(&acc, q_result);
+}
+
+bool mixed_vec3_mean(Vec3_Mixed const * v_array, size_t count, Vec3_Mixed * v_result){
+    if (count == 0){
+        return false;
+    }
+
+    double sum_i = 0.0;
+    double sum_j = 0.0;
+    double sum_k = 0.0;
+
+    for (size_t n = 0; n < count; n++){
+        sum_i += KISS_CAST(double, v_array[n].i);
+        sum_j += KISS_CAST(double, v_array[n].j);
+        sum_k += KISS_CAST(double, v_array[n].k);
+    }
+
+    double count_as_double = KISS_CAST(double, count);
+    v_result->i = KISS_CAST(float, sum_i / count_as_double);
+    v_result->j = KISS_CAST(float, sum_j / count_as_double);
+    v_result->k = KISS_CAST(float, sum_k / count_as_double);
+
+    return true;
+}
+
+bool mixed_vec3_mean_compensated(Vec3_Mixed const * v_array, size_t count, Vec3_Mixed * v_result){
+    if (count == 0){
+        return false;
+    }
+
+    Compensated_Sum sum_i {0.0f, 0.0f};
+    Compensated_Sum sum_j {0.0f, 0.0f};
+    Compensated_Sum sum_k {0.0f, 0.0f};
+
+    for (size_t n = 0; n < count; n++){
+        compensated_add(&sum_i, v_array[n].i);
+        compensated_add(&sum_j, v_array[n].j);
+        compensated_add(&sum_k, v_array[n].k);
+    }
+
+    float count_as_float = KISS_CAST(float, count);
+    v_result->i = compensated_result(&sum_i) / count_as_float;
+    v_result->j = compensated_result(&sum_j) / count_as_float;
+    v_result->k = compensated_result(&sum_k) / count_as_float;
+
+    return true;
+}
+
+// sign of the alignment of q with the reference quaternion, to stay in the same half space
+static float hemisphere_sign(Quat_Mixed const * q, Quat_Mixed const * q_reference){
+    float dot = q->r * q_reference->r + q->i * q_reference->i + q->j * q_reference->j + q->k * q_reference->k;
+    return dot < 0.0f ? -1.0f : 1.0f;
+}
+
+bool mixed_quat_average(Quat_Mixed const * q_array, size_t count, Quat_Mixed * q_result){
+    if (count == 0){
+        return false;
+    }
+
+    Quat_Acc acc {0.0, 0.0, 0.0, 0.0};
+
+    for (size_t n = 0; n < count; n++){
+        double sign = KISS_CAST(double, hemisphere_sign(&q_array[n], &q_array[0]));
+        acc.r += sign * KISS_CAST(double, q_array[n].r);
+        acc.i += sign * KISS_CAST(double, q_array[n].i);
+        acc.j += sign * KISS_CAST(double, q_array[n].j);
+        acc.k += sign * KISS_CAST(double, q_array[n].k);
+    }
+
+    if (!quat_acc_normalize(&acc)){
+        return false;
+    }
+
+    quat_acc_to_mixed(&acc, q_result);
+    return true;
+}
+
+bool mixed_quat_average_compensated(Quat_Mixed const * q_array, size_t count, Quat_Mixed * q_result){
+    if (count == 0){
+        return false;
+    }
+
+    Compensated_Sum sum_r {0.0f, 0.0f};
+    Compensated_Sum sum_i {0.0f, 0.0f};
+    Compensated_Sum sum_j {0.0f, 0.0f};
+    Compensated_Sum sum_k {0.0f, 0.0f};
+
+    for (size_t n = 0; n < count; n++){
+        float sign = hemisphere_sign(&q_array[n], &q_array[0]);
+        compensated_add(&sum_r, sign * q_array[n].r);
+        compensated_add(&sum_i, sign * q_array[n].i);
+        compensated_add(&sum_j, sign * q_array[n].j);
+        compensated_add(&sum_k, sign * q_array[n].k);
+    }
+
+    Quat_Mixed sum {
+        compensated_result(&sum_r),
+        compensated_result(&sum_i),
+        compensated_result(&sum_j),
+        compensated_result(&sum_k)
+    };
+    float norm = sqrtf(sum.r * sum.r + sum.i * sum.i + sum.j * sum.j + sum.k * sum.k);
+
+    if (norm <= 0.0f){
+        return false;
+    }
+
+    q_result->r = sum.r / norm;
+    q_result->i = sum.i / norm;
+    q_result->j = sum.j / norm;
+    q_result->k = sum.k / norm;
+
+    return true;
+}
+
+void mixed_quat_integrate(Quat_Mixed * q, Vec3_Mixed const * angular_velocities, size_t count, float dt){
+    Quat_Acc attitude;
+    Quat_Acc increment;
+    Quat_Acc prod;
+    double dt_as_double = KISS_CAST(double, dt);
+
+    quat_acc_from_mixed(q, &attitude);
+
+    for (size_t n = 0; n < count; n++){
+        double w_i = KISS_CAST(double, angular_velocities[n].i);
+        double w_j = KISS_CAST(double, angular_velocities[n].j);
+        double w_k = KISS_CAST(double, angular_velocities[n].k);
+        double w_norm = sqrt(w_i * w_i + w_j * w_j + w_k * w_k);
+        double half_angle = 0.5 * w_norm * dt_as_double;
+
+        // exp(w dt / 2); for very small rotations, use the first order expansion
+        // to avoid dividing by a vanishing norm
+        double sin_half_over_norm;
+        if (half_angle < 1.0e-8){
+            increment.r = 1.0;
+            sin_half_over_norm = 0.5 * dt_as_double;
+        }
+        else{
+            increment.r = cos(half_angle);
+            sin_half_over_norm = sin(half_angle) / w_norm;
+        }
+        increment.i = w_i * sin_half_over_norm;
+        increment.j = w_j * sin_half_over_norm;
+        increment.k = w_k * sin_half_over_norm;
+
+        quat_acc_prod(&attitude, &increment, &prod);
+        attitude = prod;
+    }
+
+    quat_acc_normalize(&attitude);
+    quat_acc_to_mixed(&attitude, q);
+}
@@ -0,0 +1,73 @@
+#ifndef KISS_CLANG_3D_MIXED_H
+#define KISS_CLANG_3D_MIXED_H
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// Mixed precision: Vec3 and Quat are stored as float (half the memory and bandwidth
+// of double), but the operations that accumulate error (long chains of compositions,
+// averaging, integration) are performed with double accumulators, and only the final
+// result is rounded back to float. This is independent of the F_TYPE_SWITCH, and all
+// the symbols are prefixed by mixed_, so this co-exists with the F_TYPE functions.
+
+#include "./kiss_clang_3d.h"
+
+// ------------------------------------------------------------
+// STRUCTS
+// ------------------------------------------------------------
+
+// the float storage is the one of the float precision structs, so that all the _f
+// functions of the library can also be used on the mixed precision data
+typedef Vec3_f Vec3_Mixed;
+typedef Quat_f Quat_Mixed;
+
+// ------------------------------------------------------------
+// FUNCTIONS DECLARATIONS
+// ------------------------------------------------------------
+
+/*
+Conversions between the float storage and the F_TYPE structs
+*/
+void mixed_vec3_to_vec3(Vec3_Mixed const * v_in, Vec3 * v_out);
+void vec3_to_mixed_vec3(Vec3 const * v_in, Vec3_Mixed * v_out);
+void mixed_quat_to_quat(Quat_Mixed const * q_in, Quat * q_out);
+void quat_to_mixed_quat(Quat const * q_in, Quat_Mixed * q_out);
+
+/*
+Compose a chain of quaternions, i.e. q_result = q_array[0] x q_array[1] x ... x q_array[count-1],
+accumulating in double. An empty chain gives the identity.
+*/
+void mixed_quat_prod_chain(Quat_Mixed const * q_array, size_t count, Quat_Mixed * q_result);
+
+/*
+Mean of an array of vectors, accumulating in double. Return false if count is 0.
+*/
+bool mixed_vec3_mean(Vec3_Mixed const * v_array, size_t count, Vec3_Mixed * v_result);
+
+/*
+Same as mixed_vec3_mean, but accumulating in float with compensated (Kahan)
+summation; this is for targets where double is slow or not available (for example,
+on AVR double is a float).
+*/
+bool mixed_vec3_mean_compensated(Vec3_Mixed const * v_array, size_t count, Vec3_Mixed * v_result);
+
+/*
+Average of an array of unit quaternions representing close rotations: the quaternions
+are flipped to the half space of the first one (q and -q are the same rotation), summed
+in double, and the sum is normalized. Return false if count is 0 or the sum is null.
+*/
+bool mixed_quat_average(Quat_Mixed const * q_array, size_t count, Quat_Mixed * q_result);
+
+/*
+Same as mixed_quat_average, but accumulating in float with compensated (Kahan)
+summation.
+*/
+bool mixed_quat_average_compensated(Quat_Mixed const * q_array, size_t count, Quat_Mixed * q_result);
+
+/*
+Integrate an attitude quaternion q from a series of body angular velocities (rad/s),
+sampled every dt seconds: q <- q x exp(w dt / 2) for each sample. The attitude is
+kept in double during the whole integration, and normalized before being written back.
+*/
+void mixed_quat_integrate(Quat_Mixed * q, Vec3_Mixed const * angular_velocities, size_t count, float dt);
+
+#endif
@@ -0,0 +1,289 @@
+#include "kiss_clang_3d_quat_spline.h"
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// ------------------------------------------------------------
+// INTERNALS
+// ------------------------------------------------------------
+
+// q * quat_exp(scale * delta); q_out can not be q
+static void boxplus_scaled(Quat const * q, Vec3 const * delta, F_TYPE scale, Quat * q_out){
+    Vec3 delta_scaled {scale * delta->i, scale * delta->j, scale * delta->k};
+    quat_boxplus(q, &delta_scaled, q_out);
+}
+
+// binary search of the segment n in [low, high], with times[n] <= t < times[n + 1] (low
+// or high out of the range, and low for a NaN t)
+static size_t search_segment(F_TYPE const * times, size_t low, size_t high, F_TYPE t){
+    while (low < high){
+        size_t middle = low + (high - low) / 2;
+        if (times[middle + 1] <= t){
+            low = middle + 1;
+        }
+        else{
+            high = middle;
+        }
+    }
+    return low;
+}
+
+// same as search_segment over all the segments, for the sorted batch evaluation: hint
+// is the segment of the previous time, so that increasing times only walk forward
+static size_t find_segment(F_TYPE const * times, size_t nbr_keys, F_TYPE t, size_t hint){
+    size_t last_segment = nbr_keys - 2;
+
+    if (!(t >= times[hint])){
+        // the order is broken (or t is NaN): binary search in [0, hint]
+        return search_segment(times, 0, hint, t);
+    }
+
+    while (hint < last_segment && times[hint + 1] <= t){
+        hint++;
+    }
+    return hint;
+}
+
+static void squad_eval_segment(Squad_Segment const * segment, F_TYPE h, Quat * q_out){
+    Quat q_slerp;
+    Quat s_slerp;
+    Vec3 delta;
+
+    boxplus_scaled(&segment->q_0, &segment->delta_q, h, &q_slerp);
+    boxplus_scaled(&segment->s_0, &segment->delta_s, h, &s_slerp);
+    quat_boxminus(&s_slerp, &q_slerp, &delta);
+    boxplus_scaled(&q_slerp, &delta, F_TYPE_2 * h * (F_TYPE_1 - h), q_out);
+}
+
+// fraction h of t in the segment, clamped to [0, 1] (0 for a NaN t); out_of_range tells
+// if it was
+static F_TYPE squad_fraction(Squad_Spline const * spline, size_t segment, F_TYPE t, bool * out_of_range){
+    F_TYPE h = (t - spline->times[segment]) / (spline->times[segment + 1] - spline->times[segment]);
+
+    *out_of_range = !(h >= F_TYPE_0) || h > F_TYPE_1;
+    if (!(h >= F_TYPE_0)){
+        return F_TYPE_0;
+    }
+    if (h > F_TYPE_1){
+        return F_TYPE_1;
+    }
+    return h;
+}
+
+// segment of the B-spline and fraction u in it, for the time t clamped to the range; a
+// NaN t is out of the range, at the start (before converting the position to an index)
+static size_t bspline_segment(Quat_BSpline const * spline, F_TYPE t, F_TYPE * u, bool * out_of_range){
+    F_TYPE nbr_segments = KISS_CAST(F_TYPE, spline->nbr_control_points - 3);
+    F_TYPE position = (t - spline->start_time) / spline->dt;
+
+    *out_of_range = !(position >= F_TYPE_0) || position > nbr_segments;
+    if (!(position >= F_TYPE_0)){
+        position = F_TYPE_0;
+    }
+    if (position >= nbr_segments){
+        *u = F_TYPE_1;
+        return spline->nbr_control_points - 4;
+    }
+
+    F_TYPE segment = F_TYPE_FLOOR(position);
+    *u = position - segment;
+    return KISS_CAST(size_t, segment);
+}
+
+static void bspline_eval_segment(Quat_BSpline const * spline, size_t segment, F_TYPE u, Quat * q_out, Vec3 * angular_velocity, Vec3 * angular_acceleration){
+    // the cumulative basis functions of the uniform cubic B-spline, and their first
+    // and second derivatives in u
+    F_TYPE const u_2 = u * u;
+    F_TYPE const u_3 = u_2 * u;
+    F_TYPE const sixth = F_TYPE_1 / KISS_CAST(F_TYPE, 6);
+    F_TYPE const three = KISS_CAST(F_TYPE, 3);
+    F_TYPE const basis[3] = {
+        (KISS_CAST(F_TYPE, 5) + three * u - three * u_2 + u_3) * sixth,
+        (F_TYPE_1 + three * u + three * u_2 - F_TYPE_2 * u_3) * sixth,
+        u_3 * sixth
+    };
+    F_TYPE const basis_d[3] = {
+        (F_TYPE_1 - u) * (F_TYPE_1 - u) * F_TYPE_05,
+        F_TYPE_05 + u - u_2,
+        u_2 * F_TYPE_05
+    };
+    F_TYPE const basis_dd[3] = {u - F_TYPE_1, F_TYPE_1 - F_TYPE_2 * u, u};
+
+    Quat q_crrt;
+    Quat q_step;
+    Vec3 velocity {F_TYPE_0, F_TYPE_0, F_TYPE_0};
+    Vec3 acceleration {F_TYPE_0, F_TYPE_0, F_TYPE_0};
+
+    quat_copy(&spline->control_points[segment], &q_crrt);
+
+    for (size_t n = 0; n < 3; n++){
+        Vec3 const * delta = &spline->deltas[segment + n];
+        Vec3 delta_scaled {basis[n] * delta->i, basis[n] * delta->j, basis[n] * delta->k};
+        quat_exp(&delta_scaled, &q_step);
+        quat_prod(&q_crrt, &q_step, q_out);
+        quat_copy(q_out, &q_crrt);
+
+        if (angular_velocity == NULL && angular_acceleration == NULL){
+            continue;
+        }
+
+        // recursion of Sommer et al., in the frame of each step: the previous
+        // velocity and acceleration are rotated by the inverse of the step, and the
+        // ones of the step are added, with the acceleration due to the rotation of
+        // the velocity of the step
+        Quat q_step_conj;
+        Vec3 rotated;
+        quat_copy(&q_step, &q_step_conj);
+        quat_conj(&q_step_conj);
+
+        Vec3 velocity_step {basis_d[n] * delta->i, basis_d[n] * delta->j, basis_d[n] * delta->k};
+        rotate_by_quat_R(&velocity, &q_step_conj, &rotated);
+        vec3_copy(&rotated, &velocity);
+        vec3_add(&velocity, &velocity_step);
+
+        Vec3 acceleration_step {basis_dd[n] * delta->i, basis_dd[n] * delta->j, basis_dd[n] * delta->k};
+        Vec3 coriolis;
+        rotate_by_quat_R(&acceleration, &q_step_conj, &rotated);
+        vec3_copy(&rotated, &acceleration);
+        vec3_add(&acceleration, &acceleration_step);
+        vec3_cross(&velocity, &velocity_step, &coriolis);
+        vec3_add(&acceleration, &coriolis);
+    }
+
+    if (angular_velocity != NULL){
+        vec3_copy(&velocity, angular_velocity);
+        vec3_scale(angular_velocity, F_TYPE_1 / spline->dt);
+    }
+    if (angular_acceleration != NULL){
+        vec3_copy(&acceleration, angular_acceleration);
+        vec3_scale(angular_acceleration, F_TYPE_1 / (spline->dt * spline->dt));
+    }
+}
+
+// ------------------------------------------------------------
+// FUNCTIONS DEFINITIONS
+// ------------------------------------------------------------
+
+bool squad_spline_init(Squad_Spline * spline, Quat const * keys, F_TYPE const * times, size_t nbr_keys, Squad_Segment * segments){
+    if (nbr_keys < 2){
+        return false;
+    }
+    for (size_t n = 0; n + 1 < nbr_keys; n++){
+        if (!(times[n] < times[n + 1])){
+            return false;
+        }
+    }
+
+    // s_n = q_n * exp(-(log(q_n^-1 q_n+1) + log(q_n^-1 q_n-1)) / 4), and s_n = q_n at
+    // the ends; segment n keeps s_n, and the rotation vector from s_n to s_n+1
+    Vec3 delta_next;
+    Vec3 delta_previous;
+    Quat s_next;
+
+    for (size_t n = 0; n + 1 < nbr_keys; n++){
+        Squad_Segment * segment = &segments[n];
+        quat_copy(&keys[n], &segment->q_0);
+        quat_boxminus(&keys[n + 1], &keys[n], &segment->delta_q);
+
+        if (n == 0){
+            quat_copy(&keys[0], &segment->s_0);
+        }
+        else{
+            quat_copy(&s_next, &segment->s_0);
+        }
+
+        if (n + 2 == nbr_keys){
+            quat_copy(&keys[n + 1], &s_next);
+        }
+        else{
+            quat_boxminus(&keys[n + 2], &keys[n + 1], &delta_next);
+            quat_boxminus(&keys[n], &keys[n + 1], &delta_previous);
+            vec3_add(&delta_next, &delta_previous);
+            boxplus_scaled(&keys[n + 1], &delta_next, -F_TYPE_05 * F_TYPE_05, &s_next);
+        }
+        quat_boxminus(&s_next, &segment->s_0, &segment->delta_s);
+    }
+
+    spline->times = times;
+    spline->segments = segments;
+    spline->nbr_keys = nbr_keys;
+
+    return true;
+}
+
+void squad_spline_eval(Squad_Spline const * spline, F_TYPE t, Quat * q_out){
+    bool out_of_range;
+    size_t segment = search_segment(spline->times, 0, spline->nbr_keys - 2, t);
+    F_TYPE h = squad_fraction(spline, segment, t, &out_of_range);
+    squad_eval_segment(&spline->segments[segment], h, q_out);
+}
+
+size_t squad_spline_eval_batch(Squad_Spline const * spline, F_TYPE const * times, Quat_View const * q_out){
+    size_t nbr_out_of_range = 0;
+    size_t segment = 0;
+    bool out_of_range;
+    Quat crrt_out;
+
+    for (size_t n = 0; n < q_out->count; n++){
+        segment = find_segment(spline->times, spline->nbr_keys, times[n], segment);
+        F_TYPE h = squad_fraction(spline, segment, times[n], &out_of_range);
+        if (out_of_range){
+            nbr_out_of_range++;
+        }
+        squad_eval_segment(&spline->segments[segment], h, &crrt_out);
+        quat_view_set(q_out, n, &crrt_out);
+    }
+
+    return nbr_out_of_range;
+}
+
+bool quat_bspline_init(Quat_BSpline * spline, Quat const * control_points, size_t nbr_control_points, F_TYPE start_time, F_TYPE dt, Vec3 * deltas){
+    if (nbr_control_points < 4 || !(dt > F_TYPE_0)){
+        return false;
+    }
+
+    for (size_t n = 0; n + 1 < nbr_control_points; n++){
+        quat_boxminus(&control_points[n + 1], &control_points[n], &deltas[n]);
+    }
+
+    spline->control_points = control_points;
+    spline->deltas = deltas;
+    spline->nbr_control_points = nbr_control_points;
+    spline->start_time = start_time;
+    spline->dt = dt;
+
+    return true;
+}
+
+void quat_bspline_eval(Quat_BSpline const * spline, F_TYPE t, Quat * q_out, Vec3 * angular_velocity, Vec3 * angular_acceleration){
+    F_TYPE u;
+    bool out_of_range;
+    size_t segment = bspline_segment(spline, t, &u, &out_of_range);
+    bspline_eval_segment(spline, segment, u, q_out, angular_velocity, angular_acceleration);
+}
+
+size_t quat_bspline_eval_batch(Quat_BSpline const * spline, F_TYPE const * times, Quat_View const * q_out, Vec3_View const * angular_velocities, Vec3_View const * angular_accelerations){
+    size_t nbr_out_of_range = 0;
+    F_TYPE u;
+    bool out_of_range;
+    Quat crrt_out;
+    Vec3 crrt_velocity;
+    Vec3 crrt_acceleration;
+
+    for (size_t n = 0; n < q_out->count; n++){
+        size_t segment = bspline_segment(spline, times[n], &u, &out_of_range);
+        if (out_of_range){
+            nbr_out_of_range++;
+        }
+
+        bspline_eval_segment(spline, segment, u, &crrt_out, angular_velocities != NULL ? &crrt_velocity : NULL, angular_accelerations != NULL ? &crrt_acceleration : NULL);
+        quat_view_set(q_out, n, &crrt_out);
+        if (angular_velocities != NULL){
+            vec3_view_set(angular_velocities, n, &crrt_velocity);
+        }
+        if (angular_accelerations != NULL){
+            vec3_view_set(angular_accelerations, n, &crrt_acceleration);
+        }
+    }
+
+    return nbr_out_of_range;
+}
@@ -0,0 +1,111 @@
+#ifndef KISS_CLANG_3D_QUAT_SPLINE_H
+#define KISS_CLANG_3D_QUAT_SPLINE_H
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// Smooth interpolation of orientations over time, in the default precision (F_TYPE),
+// for camera and IMU trajectories:
+// - SQUAD (spherical quadrangle interpolation, Shoemake 1987) through key rotations at
+//   increasing times: the spline goes through the keys, with a continuous angular
+//   velocity (C1);
+// - cumulative cubic B-spline on SO(3) (Kim et al. 1995), over control rotations at
+//   uniform times: the spline does not go through the control rotations, but its
+//   angular velocity and acceleration are continuous (C2), and are computed in closed
+//   form, as in Sommer et al. ("Efficient derivative computation for cumulative
+//   B-splines on Lie groups", CVPR 2020).
+// The rotation vectors between consecutive rotations (see quat_boxminus) are computed
+// once, when setting up the spline, so that an evaluation only needs a few quat_exp.
+// The SQUAD batch evaluation sweeps forward through increasing query times, so that
+// finding the segment of each time is not a search; the B-spline, with uniform times,
+// finds it directly.
+// All the memory is provided by the caller; nothing is allocated.
+
+#include "./kiss_clang_3d.h"
+
+// ------------------------------------------------------------
+// STRUCTS
+// ------------------------------------------------------------
+
+// --------------------------------------------------
+// segment of a SQUAD spline, between 2 keys q_0 and q_1: the intermediate rotations
+// s_0 and s_1 are kept as the rotation vectors from q_0 and between s_0 and s_1
+struct Squad_Segment {
+    Quat q_0;
+    Quat s_0;
+    Vec3 delta_q;
+    Vec3 delta_s;
+};
+
+// --------------------------------------------------
+// SQUAD spline; use squad_spline_init to set it up, and only read the members
+struct Squad_Spline {
+    F_TYPE const * times;
+    Squad_Segment * segments;
+    size_t nbr_keys;
+};
+
+// --------------------------------------------------
+// cumulative cubic B-spline; use quat_bspline_init to set it up, and only read the
+// members. deltas[n] is the rotation vector from control_points[n] to
+// control_points[n + 1].
+struct Quat_BSpline {
+    Quat const * control_points;
+    Vec3 * deltas;
+    size_t nbr_control_points;
+    F_TYPE start_time;
+    F_TYPE dt;
+};
+
+// ------------------------------------------------------------
+// FUNCTIONS DECLARATIONS
+// ------------------------------------------------------------
+
+/*
+Set up a SQUAD spline through the nbr_keys unit quaternions keys, at the strictly
+increasing times; segments has nbr_keys - 1 elements, and times must stay valid while
+the spline is used. Return false if there are less than 2 keys, or the times are not
+strictly increasing.
+*/
+bool squad_spline_init(Squad_Spline * spline, Quat const * keys, F_TYPE const * times, size_t nbr_keys, Squad_Segment * segments);
+
+/*
+Rotation of the SQUAD spline at the time t, found by binary search in the times of the
+keys; t is clamped to them, and a NaN t gives the first key.
+*/
+void squad_spline_eval(Squad_Spline const * spline, F_TYPE t, Quat * q_out);
+
+/*
+Rotations of the SQUAD spline at the times (one per quaternion of q_out), which should
+be in increasing order for speed (other orders give the same results, with a binary
+search each time the order is broken). Return the number of times outside the range of
+the spline, which are clamped to it (NaN times count as outside, and give the first key).
+*/
+size_t squad_spline_eval_batch(Squad_Spline const * spline, F_TYPE const * times, Quat_View const * q_out);
+
+/*
+Set up a cumulative cubic B-spline over the nbr_control_points unit quaternions
+control_points, spaced by dt in time; deltas has nbr_control_points - 1 elements, and
+control_points must stay valid while the spline is used. The spline is defined from
+start_time to start_time + (nbr_control_points - 3) * dt; segment n (from start_time +
+n * dt) depends on the control points n to n + 3. Return false if there are less than
+4 control points, or dt is not > 0.
+*/
+bool quat_bspline_init(Quat_BSpline * spline, Quat const * control_points, size_t nbr_control_points, F_TYPE start_time, F_TYPE dt, Vec3 * deltas);
+
+/*
+Rotation of the B-spline at the time t, clamped to the range of the spline (a NaN t
+gives the start of the spline), and, if not
+null, its angular velocity (rad/s) and acceleration (rad/s^2), in the local (body)
+frame of the rotation, as the angular velocities of mixed_quat_integrate.
+*/
+void quat_bspline_eval(Quat_BSpline const * spline, F_TYPE t, Quat * q_out, Vec3 * angular_velocity=NULL, Vec3 * angular_acceleration=NULL);
+
+/*
+Same as quat_bspline_eval, at the times (one per quaternion of q_out); the angular
+velocities and accelerations are written only if their views are not null. Return the
+number of times outside the range of the spline, which are clamped to it (NaN times
+count as outside).
+*/
+size_t quat_bspline_eval_batch(Quat_BSpline const * spline, F_TYPE const * times, Quat_View const * q_out, Vec3_View const * angular_velocities=NULL, Vec3_View const * angular_accelerations=NULL);
+
+#endif
@@ -0,0 +1,102 @@
+#include "kiss_clang_3d_rotation_cache.h"
+
+#include <string.h>
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// ------------------------------------------------------------
+// INTERNALS
+// ------------------------------------------------------------
+
+static uint64_t bits_of(F_TYPE x){
+    uint64_t bits = 0;
+    memcpy(&bits, &x, sizeof(F_TYPE));
+    return bits;
+}
+
+// splitmix64 steps over the bits of the 4 inputs
+static size_t hash_of_key(Vec3 const * axis, F_TYPE angle){
+    uint64_t const values[4] = {bits_of(axis->i), bits_of(axis->j), bits_of(axis->k), bits_of(angle)};
+    uint64_t hash = 0;
+
+    for (int n = 0; n < 4; n++){
+        hash += values[n] + 0x9e3779b97f4a7c15ULL;
+        hash ^= hash >> 30;
+        hash *= 0xbf58476d1ce4e5b9ULL;
+        hash ^= hash >> 27;
+        hash *= 0x94d049bb133111ebULL;
+        hash ^= hash >> 31;
+    }
+
+    return hash;
+}
+
+static bool entry_has_key(Rotation_Cache_Entry const * entry, Vec3 const * axis, F_TYPE angle){
+    return memcmp(&entry->axis, axis, sizeof(Vec3)) == 0 && memcmp(&entry->angle, &angle, sizeof(F_TYPE)) == 0;
+}
+
+// ------------------------------------------------------------
+// FUNCTIONS DEFINITIONS
+// ------------------------------------------------------------
+
+bool rotation_cache_init(Rotation_Cache * cache, Rotation_Cache_Entry * entries, size_t nbr_entries){
+    bool nbr_entries_power_of_2 = nbr_entries != 0 && (nbr_entries & (nbr_entries - 1)) == 0;
+
+    if (entries == NULL || !nbr_entries_power_of_2){
+        return false;
+    }
+
+    cache->entries = entries;
+    cache->nbr_entries = nbr_entries;
+    rotation_cache_clear(cache);
+
+    return true;
+}
+
+void rotation_cache_clear(Rotation_Cache * cache){
+    for (size_t n = 0; n < cache->nbr_entries; n++){
+        cache->entries[n].valid = false;
+    }
+    cache->nbr_hits = 0;
+    cache->nbr_misses = 0;
+}
+
+bool rotation_to_quat_cached(Rotation_Cache * cache, Quat * q, Vec3 const * rotation_axis, F_TYPE const rotation_angle_rad, F_TYPE tolerance){
+    // the only case that depends on the tolerance, and as cheap as a lookup
+    if (vec3_is_null(rotation_axis)){
+        return rotation_to_quat(q, rotation_axis, rotation_angle_rad, tolerance);
+    }
+
+    size_t mask = cache->nbr_entries - 1;
+    size_t home = hash_of_key(rotation_axis, rotation_angle_rad) & mask;
+    size_t nbr_probes = cache->nbr_entries < ROTATION_CACHE_MAX_PROBES ? cache->nbr_entries : ROTATION_CACHE_MAX_PROBES;
+    Rotation_Cache_Entry * free_entry = NULL;
+
+    for (size_t n = 0; n < nbr_probes; n++){
+        Rotation_Cache_Entry * entry = &cache->entries[(home + n) & mask];
+
+        if (!entry->valid){
+            if (free_entry == NULL){
+                free_entry = entry;
+            }
+        }
+        else if (entry_has_key(entry, rotation_axis, rotation_angle_rad)){
+            cache->nbr_hits++;
+            quat_copy(&entry->q, q);
+            return true;
+        }
+    }
+
+    cache->nbr_misses++;
+    rotation_to_quat(q, rotation_axis, rotation_angle_rad, tolerance);
+
+    if (free_entry == NULL){
+        free_entry = &cache->entries[home];
+    }
+    vec3_copy(rotation_axis, &free_entry->axis);
+    free_entry->angle = rotation_angle_rad;
+    quat_copy(q, &free_entry->q);
+    free_entry->valid = true;
+
+    return true;
+}
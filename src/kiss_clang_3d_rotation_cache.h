@@ -0,0 +1,68 @@
+#ifndef KISS_CLANG_3D_ROTATION_CACHE_H
+#define KISS_CLANG_3D_ROTATION_CACHE_H
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// Opt-in memoization of rotation_to_quat, in the default precision (F_TYPE), for
+// the cases where the same (axis, angle) inputs come back again and again (replay of
+// recorded motions, rigs with a fixed set of poses, ...): a hit is a hash lookup,
+// instead of a cos, a sin and a vec3_norm.
+// The cache is a bounded open addressing hash table, over caller memory, keyed on
+// the bits of the inputs: only bit-exact repetitions hit (0.0 and -0.0 are different
+// keys), and the results are exactly the ones of rotation_to_quat. When all the
+// entries near the slot of a new key are in use, the entry at that slot is evicted.
+// A cache is not synchronized in any way: use one cache per thread (for example a
+// thread_local one), so that no lock is ever needed.
+
+#include "./kiss_clang_3d.h"
+
+// ------------------------------------------------------------
+// STRUCTS
+// ------------------------------------------------------------
+
+// --------------------------------------------------
+// one entry of the cache; the caller only provides the memory
+struct Rotation_Cache_Entry {
+    Vec3 axis;
+    F_TYPE angle;
+    Quat q;
+    bool valid;
+};
+
+// --------------------------------------------------
+// the cache; use rotation_cache_init to set it up, and only read the members.
+// nbr_hits and nbr_misses count the calls to rotation_to_quat_cached since the last
+// init or clear (the calls with a null axis bypass the cache, and are not counted).
+struct Rotation_Cache {
+    Rotation_Cache_Entry * entries;
+    size_t nbr_entries;
+    uint64_t nbr_hits;
+    uint64_t nbr_misses;
+};
+
+// number of consecutive slots looked at for a key, before evicting
+#define ROTATION_CACHE_MAX_PROBES 4
+
+// ------------------------------------------------------------
+// FUNCTIONS DECLARATIONS
+// ------------------------------------------------------------
+
+/*
+Set up an empty cache over the caller array of nbr_entries entries; nbr_entries must
+be a power of 2. For a working set of n different inputs, 2 n entries or more keep
+the evictions rare. Return false if the memory is not valid.
+*/
+bool rotation_cache_init(Rotation_Cache * cache, Rotation_Cache_Entry * entries, size_t nbr_entries);
+
+/*
+Remove all the entries, and reset the counters.
+*/
+void rotation_cache_clear(Rotation_Cache * cache);
+
+/*
+Same as rotation_to_quat (same result and return value), but looking up the cache
+first, and storing the computed quaternion in it on a miss.
+*/
+bool rotation_to_quat_cached(Rotation_Cache * cache, Quat * q, Vec3 const * rotation_axis, F_TYPE const rotation_angle_rad, F_TYPE tolerance=DEFAULT_TOL);
+
+#endif
@@ -0,0 +1,231 @@
+#include "kiss_clang_3d_rotation_index.h"
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// ------------------------------------------------------------
+// INTERNALS
+// ------------------------------------------------------------
+
+// the split component of a range, cycling r, i, j, k with the depth
+static F_TYPE component(Quat const * q, size_t depth){
+    switch (depth % 4){
+        case 0:
+            return q->r;
+        case 1:
+            return q->i;
+        case 2:
+            return q->j;
+        default:
+            return q->k;
+    }
+}
+
+// squared chord between the rotations of p and q: the nearest of q and -q to p
+static F_TYPE chord_square(Quat const * p, Quat const * q){
+    Quat diff {p->r - q->r, p->i - q->i, p->j - q->j, p->k - q->k};
+    Quat sum {p->r + q->r, p->i + q->i, p->j + q->j, p->k + q->k};
+    F_TYPE diff_square = quat_norm_square(&diff);
+    F_TYPE sum_square = quat_norm_square(&sum);
+    return diff_square < sum_square ? diff_square : sum_square;
+}
+
+static void swap_rotations(Quat * rotations, size_t * original_indexes, size_t a, size_t b){
+    Quat tmp_rotation = rotations[a];
+    rotations[a] = rotations[b];
+    rotations[b] = tmp_rotation;
+
+    if (original_indexes != NULL){
+        size_t tmp_index = original_indexes[a];
+        original_indexes[a] = original_indexes[b];
+        original_indexes[b] = tmp_index;
+    }
+}
+
+// quickselect of the median position nth of [low, high), with a 3 way partition, as
+// in the k-d tree
+static void select_median(Quat * rotations, size_t * original_indexes, size_t low, size_t high, size_t nth, size_t depth){
+    while (high - low > 1){
+        F_TYPE pivot = component(&rotations[low + (high - low) / 2], depth);
+
+        // [low, less) < pivot, [less, crrt) == pivot, [greater, high) > pivot
+        size_t less = low;
+        size_t crrt = low;
+        size_t greater = high;
+        while (crrt < greater){
+            F_TYPE value = component(&rotations[crrt], depth);
+            if (value < pivot){
+                swap_rotations(rotations, original_indexes, less, crrt);
+                less++;
+                crrt++;
+            }
+            else if (value > pivot){
+                greater--;
+                swap_rotations(rotations, original_indexes, crrt, greater);
+            }
+            else{
+                crrt++;
+            }
+        }
+
+        if (nth < less){
+            high = less;
+        }
+        else if (nth >= greater){
+            low = greater;
+        }
+        else{
+            return;
+        }
+    }
+}
+
+static void build_range(Quat * rotations, size_t * original_indexes, size_t low, size_t high, size_t depth){
+    if (high - low <= 1){
+        return;
+    }
+
+    size_t middle = low + (high - low) / 2;
+    select_median(rotations, original_indexes, low, high, middle, depth);
+    build_range(rotations, original_indexes, low, middle, depth + 1);
+    build_range(rotations, original_indexes, middle + 1, high, depth + 1);
+}
+
+// the k best so far, sorted by increasing squared chord; offsets are, for q and -q,
+// the distances along each component to the region of the range being searched, so
+// that the sum of their squares is a lower bound of the squared chords of this region
+struct Rotation_Search {
+    Quat const * rotations;
+    F_TYPE components[2][4];
+    F_TYPE offsets[2][4];
+    Quat const * q;
+    size_t k;
+    size_t found;
+    size_t * indexes;
+    F_TYPE * chord_squares;
+};
+
+static F_TYPE worst_chord_square(Rotation_Search const * search){
+    return search->found < search->k ? F_TYPE_MAX : search->chord_squares[search->k - 1];
+}
+
+static void consider_nearest(Rotation_Search * search, size_t index){
+    F_TYPE crrt_chord_square = chord_square(&search->rotations[index], search->q);
+
+    if (search->found == search->k && crrt_chord_square >= search->chord_squares[search->k - 1]){
+        return;
+    }
+
+    size_t position = search->found < search->k ? search->found++ : search->k - 1;
+    while (position > 0 && search->chord_squares[position - 1] > crrt_chord_square){
+        search->chord_squares[position] = search->chord_squares[position - 1];
+        search->indexes[position] = search->indexes[position - 1];
+        position--;
+    }
+    search->chord_squares[position] = crrt_chord_square;
+    search->indexes[position] = index;
+}
+
+static F_TYPE offsets_square(F_TYPE const offsets[4]){
+    return offsets[0] * offsets[0] + offsets[1] * offsets[1] + offsets[2] * offsets[2] + offsets[3] * offsets[3];
+}
+
+static void search_nearest(Rotation_Search * search, size_t low, size_t high, size_t depth){
+    if (low >= high){
+        return;
+    }
+
+    size_t middle = low + (high - low) / 2;
+    consider_nearest(search, middle);
+
+    size_t axis = depth % 4;
+    F_TYPE split = component(&search->rotations[middle], depth);
+
+    // the side of q first, so that the other side is often pruned
+    F_TYPE diff = search->components[0][axis] - split;
+    bool below = diff < F_TYPE_0;
+    size_t near_low = below ? low : middle + 1;
+    size_t near_high = below ? middle : high;
+    size_t far_low = below ? middle + 1 : low;
+    size_t far_high = below ? high : middle;
+
+    // entering a side sets the offset along axis of q or -q to its distance to the
+    // split if it is on the other side of the split, and keeps it otherwise
+    F_TYPE saved[2] = {search->offsets[0][axis], search->offsets[1][axis]};
+    F_TYPE diff_opposite = search->components[1][axis] - split;
+    bool opposite_below = diff_opposite < F_TYPE_0;
+
+    if (opposite_below != below){
+        search->offsets[1][axis] = diff_opposite;
+    }
+    if (offsets_square(search->offsets[0]) < worst_chord_square(search) || offsets_square(search->offsets[1]) < worst_chord_square(search)){
+        search_nearest(search, near_low, near_high, depth + 1);
+    }
+    search->offsets[1][axis] = opposite_below != below ? saved[1] : diff_opposite;
+    search->offsets[0][axis] = diff;
+
+    if (offsets_square(search->offsets[0]) < worst_chord_square(search) || offsets_square(search->offsets[1]) < worst_chord_square(search)){
+        search_nearest(search, far_low, far_high, depth + 1);
+    }
+    search->offsets[0][axis] = saved[0];
+    search->offsets[1][axis] = saved[1];
+}
+
+// ------------------------------------------------------------
+// FUNCTIONS DEFINITIONS
+// ------------------------------------------------------------
+
+bool rotation_index_build(Rotation_Index * index, Quat * rotations, size_t count, size_t * original_indexes){
+    if (rotations == NULL){
+        return false;
+    }
+
+    for (size_t n = 0; n < count; n++){
+        quat_canonicalize(&rotations[n]);
+        if (original_indexes != NULL){
+            original_indexes[n] = n;
+        }
+    }
+
+    build_range(rotations, original_indexes, 0, count, 0);
+
+    index->rotations = rotations;
+    index->count = count;
+
+    return true;
+}
+
+size_t rotation_index_nearest(Rotation_Index const * index, Quat const * q, size_t k, size_t * indexes, F_TYPE * angles){
+    if (k == 0){
+        return 0;
+    }
+
+    // the squared chords are kept in angles until the end
+    Rotation_Search search {
+        index->rotations,
+        {{q->r, q->i, q->j, q->k}, {-q->r, -q->i, -q->j, -q->k}},
+        {{F_TYPE_0, F_TYPE_0, F_TYPE_0, F_TYPE_0}, {F_TYPE_0, F_TYPE_0, F_TYPE_0, F_TYPE_0}},
+        q, k, 0, indexes, angles
+    };
+    search_nearest(&search, 0, index->count, 0);
+
+    for (size_t n = 0; n < search.found; n++){
+        angles[n] = quat_angle(&index->rotations[indexes[n]], q);
+    }
+    for (size_t n = search.found; n < k; n++){
+        indexes[n] = ROTATION_INDEX_NOT_FOUND;
+        angles[n] = F_TYPE_MAX;
+    }
+
+    return search.found;
+}
+
+size_t rotation_index_nearest_batch(Rotation_Index const * index, Quat_View const * queries, size_t k, size_t * indexes, F_TYPE * angles){
+    Quat crrt_query;
+
+    for (size_t n = 0; n < queries->count; n++){
+        quat_view_get(queries, n, &crrt_query);
+        rotation_index_nearest(index, &crrt_query, k, &indexes[n * k], &angles[n * k]);
+    }
+
+    return queries->count;
+}
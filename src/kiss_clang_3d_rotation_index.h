@@ -0,0 +1,59 @@
+#ifndef KISS_CLANG_3D_ROTATION_INDEX_H
+#define KISS_CLANG_3D_ROTATION_INDEX_H
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// Index over an array of unit quaternions, in the default precision (F_TYPE), for the
+// nearest rotations to a query rotation in large sets of reference orientations (pose
+// libraries, templates), where the brute force quat_nearest_batch is too slow.
+// It is an implicit k-d tree in 4D, as kiss_clang_3d_kd_tree.h: building it
+// canonicalizes the quaternions (see quat_canonicalize) and reorders them in place,
+// without any node or pointer. As q and -q are the same rotation, the distance between
+// p and q is the chord min(|p - q|, |p + q|), which orders the rotations as their angle
+// (the chord is 2 sin(angle / 4)); the search prunes a side of a split only if both q
+// and -q are far enough from it, and only the k final angles use trigonometry.
+
+#include "./kiss_clang_3d.h"
+
+// ------------------------------------------------------------
+// STRUCTS
+// ------------------------------------------------------------
+
+// --------------------------------------------------
+// the index; use rotation_index_build to set it up, and only read the members
+struct Rotation_Index {
+    Quat * rotations;
+    size_t count;
+};
+
+// index written for the missing rotations, when there are less than k of them
+#define ROTATION_INDEX_NOT_FOUND SIZE_MAX
+
+// ------------------------------------------------------------
+// FUNCTIONS DECLARATIONS
+// ------------------------------------------------------------
+
+/*
+Build the index over the count unit quaternions, canonicalizing and reordering them in
+place (O(count log count) on average). If original_indexes is not null, it receives,
+for each position of the reordered array, the index the rotation had before. The
+indexes returned by the queries are positions in the reordered array. Return false if
+rotations is null.
+*/
+bool rotation_index_build(Rotation_Index * index, Quat * rotations, size_t count, size_t * original_indexes=NULL);
+
+/*
+The k rotations nearest to the rotation of the unit quaternion q, by increasing angle:
+their indexes and angles (in rad, as quat_angle) are written in the arrays of k
+elements. If the index has less than k rotations, the end of the arrays is filled with
+ROTATION_INDEX_NOT_FOUND and F_TYPE_MAX. Return the number of rotations found.
+*/
+size_t rotation_index_nearest(Rotation_Index const * index, Quat const * q, size_t k, size_t * indexes, F_TYPE * angles);
+
+/*
+Batch version, over a view of queries: the k results of query n are written at n * k in
+indexes and angles. Return the number of queries.
+*/
+size_t rotation_index_nearest_batch(Rotation_Index const * index, Quat_View const * queries, size_t k, size_t * indexes, F_TYPE * angles);
+
+#endif
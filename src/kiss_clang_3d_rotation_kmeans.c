@@ -0,0 +1,251 @@
+#include "kiss_clang_3d_rotation_kmeans.h"
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// ------------------------------------------------------------
+// INTERNALS
+// ------------------------------------------------------------
+
+// the largest number of sweeps of the Jacobi method; 4x4 matrices converge in a few
+#define MAX_JACOBI_SWEEPS 50
+
+// eigenvector of the largest eigenvalue of a symmetric 4x4 matrix, with the cyclic
+// Jacobi method: each rotation zeroes one off diagonal element, and the product of
+// the rotations converges to the eigenvectors (columns of eigenvectors)
+static void principal_eigenvector(double matrix[4][4], double vector[4]){
+    double eigenvectors[4][4] = {{1.0, 0.0, 0.0, 0.0}, {0.0, 1.0, 0.0, 0.0}, {0.0, 0.0, 1.0, 0.0}, {0.0, 0.0, 0.0, 1.0}};
+
+    for (int sweep = 0; sweep < MAX_JACOBI_SWEEPS; sweep++){
+        double off_diagonal = 0.0;
+        double diagonal = 0.0;
+        for (int p = 0; p < 4; p++){
+            diagonal += matrix[p][p] * matrix[p][p];
+            for (int q = p + 1; q < 4; q++){
+                off_diagonal += matrix[p][q] * matrix[p][q];
+            }
+        }
+        if (off_diagonal <= 1.0e-30 * diagonal){
+            break;
+        }
+
+        for (int p = 0; p < 3; p++){
+            for (int q = p + 1; q < 4; q++){
+                if (matrix[p][q] == 0.0){
+                    continue;
+                }
+
+                double theta = (matrix[q][q] - matrix[p][p]) / (2.0 * matrix[p][q]);
+                double t = (theta < 0.0 ? -1.0 : 1.0) / (fabs(theta) + sqrt(theta * theta + 1.0));
+                double c = 1.0 / sqrt(t * t + 1.0);
+                double s = t * c;
+
+                for (int m = 0; m < 4; m++){
+                    double m_p = matrix[m][p];
+                    double m_q = matrix[m][q];
+                    matrix[m][p] = c * m_p - s * m_q;
+                    matrix[m][q] = s * m_p + c * m_q;
+                }
+                for (int m = 0; m < 4; m++){
+                    double p_m = matrix[p][m];
+                    double q_m = matrix[q][m];
+                    matrix[p][m] = c * p_m - s * q_m;
+                    matrix[q][m] = s * p_m + c * q_m;
+                }
+                for (int m = 0; m < 4; m++){
+                    double v_p = eigenvectors[m][p];
+                    double v_q = eigenvectors[m][q];
+                    eigenvectors[m][p] = c * v_p - s * v_q;
+                    eigenvectors[m][q] = s * v_p + c * v_q;
+                }
+            }
+        }
+    }
+
+    int largest = 0;
+    for (int p = 1; p < 4; p++){
+        if (matrix[p][p] > matrix[largest][largest]){
+            largest = p;
+        }
+    }
+    for (int m = 0; m < 4; m++){
+        vector[m] = eigenvectors[m][largest];
+    }
+}
+
+// the centroid with the largest |scalar| with q, i.e. the nearest in angle
+static size_t nearest_centroid(Quat const * q, Quat const * centroids, size_t k){
+    size_t best = 0;
+    F_TYPE best_abs_scalar = -F_TYPE_1;
+
+    for (size_t n = 0; n < k; n++){
+        F_TYPE abs_scalar = F_TYPE_ABS(quat_scalar(q, &centroids[n]));
+        if (abs_scalar > best_abs_scalar){
+            best_abs_scalar = abs_scalar;
+            best = n;
+        }
+    }
+
+    return best;
+}
+
+// ------------------------------------------------------------
+// FUNCTIONS DEFINITIONS
+// ------------------------------------------------------------
+
+void quat_mean_acc_clear(Quat_Mean_Acc * acc){
+    acc->count = 0;
+    for (int n = 0; n < 10; n++){
+        acc->moments[n] = 0.0;
+    }
+}
+
+void quat_mean_acc_add(Quat_Mean_Acc * acc, Quat const * q){
+    double const components[4] = {F_TYPE_TO_DOUBLE(q->r), F_TYPE_TO_DOUBLE(q->i), F_TYPE_TO_DOUBLE(q->j), F_TYPE_TO_DOUBLE(q->k)};
+    int position = 0;
+
+    for (int a = 0; a < 4; a++){
+        for (int b = a; b < 4; b++){
+            acc->moments[position] += components[a] * components[b];
+            position++;
+        }
+    }
+    acc->count++;
+}
+
+void quat_mean_acc_merge(Quat_Mean_Acc * acc, Quat_Mean_Acc const * acc_other){
+    for (int n = 0; n < 10; n++){
+        acc->moments[n] += acc_other->moments[n];
+    }
+    acc->count += acc_other->count;
+}
+
+bool quat_mean_acc_result(Quat_Mean_Acc const * acc, Quat * mean){
+    if (acc->count == 0){
+        return false;
+    }
+
+    double matrix[4][4];
+    int position = 0;
+    for (int a = 0; a < 4; a++){
+        for (int b = a; b < 4; b++){
+            matrix[a][b] = acc->moments[position];
+            matrix[b][a] = acc->moments[position];
+            position++;
+        }
+    }
+
+    double vector[4];
+    principal_eigenvector(matrix, vector);
+
+    quat_setter(mean, F_TYPE_FROM_DOUBLE(vector[0]), F_TYPE_FROM_DOUBLE(vector[1]), F_TYPE_FROM_DOUBLE(vector[2]), F_TYPE_FROM_DOUBLE(vector[3]));
+    quat_canonicalize(mean);
+
+    return true;
+}
+
+bool quat_mean_markley(Quat_View const * q_in, Quat * mean){
+    Quat_Mean_Acc acc;
+    Quat crrt_in;
+
+    quat_mean_acc_clear(&acc);
+    for (size_t n = 0; n < q_in->count; n++){
+        quat_view_get(q_in, n, &crrt_in);
+        quat_mean_acc_add(&acc, &crrt_in);
+    }
+
+    return quat_mean_acc_result(&acc, mean);
+}
+
+size_t rotation_kmeans_init(Quat_View const * q_in, size_t k, Quat * centroids, F_TYPE * best_abs_scalars){
+    size_t nbr_centroids = k < q_in->count ? k : q_in->count;
+    Quat crrt_in;
+
+    if (nbr_centroids == 0){
+        for (size_t m = 0; m < k; m++){
+            quat_setter(&centroids[m], F_TYPE_1, F_TYPE_0, F_TYPE_0, F_TYPE_0);
+        }
+        return 0;
+    }
+
+    quat_view_get(q_in, 0, &centroids[0]);
+    for (size_t n = 0; n < q_in->count; n++){
+        best_abs_scalars[n] = -F_TYPE_1;
+    }
+
+    for (size_t m = 1; m < nbr_centroids; m++){
+        // the rotation farthest from its nearest centroid, i.e. with the smallest
+        // largest |scalar|; only the last centroid can change it
+        size_t farthest = 0;
+        for (size_t n = 0; n < q_in->count; n++){
+            quat_view_get(q_in, n, &crrt_in);
+            F_TYPE abs_scalar = F_TYPE_ABS(quat_scalar(&crrt_in, &centroids[m - 1]));
+            if (abs_scalar > best_abs_scalars[n]){
+                best_abs_scalars[n] = abs_scalar;
+            }
+            if (best_abs_scalars[n] < best_abs_scalars[farthest]){
+                farthest = n;
+            }
+        }
+        quat_view_get(q_in, farthest, &centroids[m]);
+    }
+
+    // more centroids than rotations: copies of the first one, which come after it, so
+    // that they never win the assignment, and their clusters stay empty
+    for (size_t m = nbr_centroids; m < k; m++){
+        quat_copy(&centroids[0], &centroids[m]);
+    }
+
+    return nbr_centroids;
+}
+
+size_t rotation_kmeans_assign(Quat_View const * q_in, Quat const * centroids, size_t k, size_t * assignments, Quat_Mean_Acc * accs){
+    size_t nbr_changes = 0;
+    Quat crrt_in;
+
+    for (size_t n = 0; n < q_in->count; n++){
+        quat_view_get(q_in, n, &crrt_in);
+        size_t cluster = nearest_centroid(&crrt_in, centroids, k);
+
+        if (cluster != assignments[n]){
+            assignments[n] = cluster;
+            nbr_changes++;
+        }
+        quat_mean_acc_add(&accs[cluster], &crrt_in);
+    }
+
+    return nbr_changes;
+}
+
+void rotation_kmeans_update(Quat * centroids, size_t k, Quat_Mean_Acc const * accs){
+    Quat mean;
+
+    for (size_t n = 0; n < k; n++){
+        if (quat_mean_acc_result(&accs[n], &mean)){
+            quat_copy(&mean, &centroids[n]);
+        }
+    }
+}
+
+size_t rotation_kmeans(Quat_View const * q_in, size_t k, Quat * centroids, size_t * assignments, Quat_Mean_Acc * accs, size_t max_iterations){
+    size_t nbr_iterations = 0;
+
+    for (size_t n = 0; n < q_in->count; n++){
+        assignments[n] = ROTATION_KMEANS_UNASSIGNED;
+    }
+
+    while (nbr_iterations < max_iterations && k > 0){
+        for (size_t n = 0; n < k; n++){
+            quat_mean_acc_clear(&accs[n]);
+        }
+
+        size_t nbr_changes = rotation_kmeans_assign(q_in, centroids, k, assignments, accs);
+        nbr_iterations++;
+        if (nbr_changes == 0){
+            break;
+        }
+
+        rotation_kmeans_update(centroids, k, accs);
+    }
+
+    return nbr_iterations;
+}
@@ -0,0 +1,100 @@
+#ifndef KISS_CLANG_3D_ROTATION_KMEANS_H
+#define KISS_CLANG_3D_ROTATION_KMEANS_H
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// Mean and k-means clustering of unit quaternions, in the default precision (F_TYPE),
+// to reduce large sets of observed orientations to a few representative ones.
+// As q and -q are the same rotation, the mean is not the normalized sum of the
+// quaternions, but the one of Markley et al. ("Averaging quaternions", 2007): the
+// eigenvector of the largest eigenvalue of the sum of the outer products q q^T, which
+// does not depend on the signs. The sums are accumulated in double (10 sums, as the
+// matrix is symmetric), and accumulators can be merged, so that a large set can be
+// split (for example with quat_view_slice) between threads, each with its own
+// accumulators, and merged at the end.
+// k-means alternates the assignment of each rotation to the centroid with the largest
+// |scalar| (as quat_nearest_batch, i.e. the nearest in angle), and the update of the
+// centroids to the mean of their rotations, until no assignment changes.
+// All the memory is provided by the caller; nothing is allocated.
+
+#include "./kiss_clang_3d.h"
+
+// ------------------------------------------------------------
+// STRUCTS
+// ------------------------------------------------------------
+
+// --------------------------------------------------
+// accumulator of the Markley mean: the number of rotations, and the sums of the
+// products of their components (rr, ri, rj, rk, ii, ij, ik, jj, jk, kk)
+struct Quat_Mean_Acc {
+    size_t count;
+    double moments[10];
+};
+
+// assignment of a rotation not assigned to any cluster yet
+#define ROTATION_KMEANS_UNASSIGNED SIZE_MAX
+
+// ------------------------------------------------------------
+// FUNCTIONS DECLARATIONS
+// ------------------------------------------------------------
+
+/*
+Empty accumulator.
+*/
+void quat_mean_acc_clear(Quat_Mean_Acc * acc);
+
+/*
+Add a unit quaternion to the accumulator.
+*/
+void quat_mean_acc_add(Quat_Mean_Acc * acc, Quat const * q);
+
+/*
+Add all the rotations of acc_other to acc.
+*/
+void quat_mean_acc_merge(Quat_Mean_Acc * acc, Quat_Mean_Acc const * acc_other);
+
+/*
+Markley mean of the rotations of the accumulator, as a canonical unit quaternion (see
+quat_canonicalize). Return false if the accumulator is empty.
+*/
+bool quat_mean_acc_result(Quat_Mean_Acc const * acc, Quat * mean);
+
+/*
+Markley mean of all the unit quaternions of q_in. Return false if q_in is empty.
+*/
+bool quat_mean_markley(Quat_View const * q_in, Quat * mean);
+
+/*
+Initial centroids for rotation_kmeans, spread over the rotations of q_in: the first
+rotation, then, repeatedly, the rotation farthest from all the centroids so far.
+best_abs_scalars is scratch memory with one element per rotation of q_in. Return the
+number of centroids taken from q_in, min(k, count of q_in); all the k centroids are set
+anyway, the extra ones as copies of the first (the identity if q_in is empty), so that
+rotation_kmeans can run with k, and leaves their clusters empty.
+*/
+size_t rotation_kmeans_init(Quat_View const * q_in, size_t k, Quat * centroids, F_TYPE * best_abs_scalars);
+
+/*
+Assignment step: assign each rotation n of q_in to the nearest of the k centroids in
+assignments[n], and add it to the accumulator of its cluster in accs (k accumulators,
+not cleared, so that the calls over the slices of a large set can share them, or use
+their own and merge them). Return the number of assignments that changed.
+*/
+size_t rotation_kmeans_assign(Quat_View const * q_in, Quat const * centroids, size_t k, size_t * assignments, Quat_Mean_Acc * accs);
+
+/*
+Update step: set each of the k centroids to the mean of its accumulator; the centroids
+of empty clusters are kept.
+*/
+void rotation_kmeans_update(Quat * centroids, size_t k, Quat_Mean_Acc const * accs);
+
+/*
+k-means over the rotations of q_in, from the k initial centroids (for example from
+rotation_kmeans_init), for at most max_iterations assignment and update steps, or until
+no assignment changes. centroids receives the final centroids, assignments the cluster
+of each rotation, and accs (k accumulators) the rotations of each cluster, with their
+count. Return the number of iterations done.
+*/
+size_t rotation_kmeans(Quat_View const * q_in, size_t k, Quat * centroids, size_t * assignments, Quat_Mean_Acc * accs, size_t max_iterations=100);
+
+#endif
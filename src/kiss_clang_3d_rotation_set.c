@@ -0,0 +1,218 @@
+#include "kiss_clang_3d_rotation_set.h"
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// ------------------------------------------------------------
+// INTERNALS
+// ------------------------------------------------------------
+
+// marks an empty slot of the hash table
+#define EMPTY_SLOT SIZE_MAX
+
+// cells of the grid, in units of cell_size, for the 4 components r, i, j, k
+struct Quat_Cell {
+    int64_t coords[4];
+};
+
+// bound on the cell coordinates, 2^62, so that they and their neighbours fit an int64_t;
+// a unit quaternion is far within it, as cell_size >= F_TYPE_EPS
+#define MAX_CELL_COORD (4611686018427387904.0)
+
+// false for a non finite component, or one too large for the cells
+static bool cell_coord(F_TYPE x, F_TYPE cell_size, int64_t * coord){
+    F_TYPE scaled = F_TYPE_FLOOR(x / cell_size);
+
+    // written so that NaN fails
+    if (!(F_TYPE_ABS(scaled) <= F_TYPE_FROM_DOUBLE(MAX_CELL_COORD))){
+        return false;
+    }
+
+    *coord = KISS_CAST(int64_t, scaled);
+    return true;
+}
+
+static bool cell_of_quat(Quat const * q, F_TYPE cell_size, Quat_Cell * cell){
+    return(
+        cell_coord(q->r, cell_size, &cell->coords[0]) &&
+        cell_coord(q->i, cell_size, &cell->coords[1]) &&
+        cell_coord(q->j, cell_size, &cell->coords[2]) &&
+        cell_coord(q->k, cell_size, &cell->coords[3])
+    );
+}
+
+// splitmix64 steps over the 4 coordinates, so that neighbouring cells land on
+// unrelated slots
+static size_t hash_of_cell(Quat_Cell const * cell){
+    uint64_t hash = 0;
+
+    for (int n = 0; n < 4; n++){
+        hash += KISS_CAST(uint64_t, cell->coords[n]) + 0x9e3779b97f4a7c15ULL;
+        hash ^= hash >> 30;
+        hash *= 0xbf58476d1ce4e5b9ULL;
+        hash ^= hash >> 27;
+        hash *= 0x94d049bb133111ebULL;
+        hash ^= hash >> 31;
+    }
+
+    return hash;
+}
+
+// walk the probe sequence of one cell; the sequence may also contain rotations of
+// other cells, but they are simply compared as the others
+static size_t find_in_cell(Rotation_Set const * set, Quat_Cell const * cell, Quat const * q){
+    size_t mask = set->nbr_slots - 1;
+    size_t slot = hash_of_cell(cell) & mask;
+
+    while (set->slots[slot] != EMPTY_SLOT){
+        size_t index = set->slots[slot];
+        if (quat_equal(&set->rotations[index], q, set->tolerance)){
+            return index;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return ROTATION_SET_NOT_FOUND;
+}
+
+// the stored rotations within tolerance of q are in the cells of [x - tolerance,
+// x + tolerance] for each component x; as cell_size >= 2 * tolerance, this is 1 or
+// 2 cells per component, i.e. at most 16 cells
+static size_t find_near(Rotation_Set const * set, Quat const * q){
+    F_TYPE const components[4] = {q->r, q->i, q->j, q->k};
+    int64_t low[4];
+    int64_t high[4];
+
+    for (int n = 0; n < 4; n++){
+        if (
+            !cell_coord(components[n] - set->tolerance, set->cell_size, &low[n]) ||
+            !cell_coord(components[n] + set->tolerance, set->cell_size, &high[n])
+        ){
+            return ROTATION_SET_NOT_FOUND;
+        }
+    }
+
+    for (unsigned combination = 0; combination < 16; combination++){
+        Quat_Cell cell;
+        bool valid = true;
+
+        for (int n = 0; n < 4; n++){
+            bool use_high = (combination >> n) & 1u;
+            if (use_high && high[n] == low[n]){
+                valid = false;
+                break;
+            }
+            cell.coords[n] = use_high ? high[n] : low[n];
+        }
+
+        if (valid){
+            size_t index = find_in_cell(set, &cell, q);
+            if (index != ROTATION_SET_NOT_FOUND){
+                return index;
+            }
+        }
+    }
+
+    return ROTATION_SET_NOT_FOUND;
+}
+
+// ------------------------------------------------------------
+// FUNCTIONS DEFINITIONS
+// ------------------------------------------------------------
+
+bool rotation_set_init(Rotation_Set * set, Quat * rotations, size_t capacity, size_t * slots, size_t nbr_slots, F_TYPE tolerance){
+    bool nbr_slots_power_of_2 = nbr_slots != 0 && (nbr_slots & (nbr_slots - 1)) == 0;
+
+    if (rotations == NULL || slots == NULL || !nbr_slots_power_of_2 || nbr_slots <= capacity || !(tolerance > F_TYPE_0)){
+        return false;
+    }
+
+    set->rotations = rotations;
+    set->capacity = capacity;
+    set->slots = slots;
+    set->nbr_slots = nbr_slots;
+    set->tolerance = tolerance;
+    // a few tolerances, so that a lookup usually probes few cells; at least
+    // F_TYPE_EPS, so that the cell coordinates of unit quaternions fit an int64_t
+    set->cell_size = F_TYPE_2 * F_TYPE_2 * tolerance;
+    if (set->cell_size < F_TYPE_EPS){
+        set->cell_size = F_TYPE_EPS;
+    }
+
+    rotation_set_clear(set);
+
+    return true;
+}
+
+void rotation_set_clear(Rotation_Set * set){
+    for (size_t n = 0; n < set->nbr_slots; n++){
+        set->slots[n] = EMPTY_SLOT;
+    }
+    set->count = 0;
+}
+
+size_t rotation_set_find(Rotation_Set const * set, Quat const * q){
+    Quat q_canonical;
+    quat_copy(q, &q_canonical);
+    quat_canonicalize(&q_canonical);
+
+    size_t index = find_near(set, &q_canonical);
+
+    // the stored rotations have r >= 0: they can only be close to -q_canonical if
+    // both are close to r = 0
+    if (index == ROTATION_SET_NOT_FOUND && q_canonical.r <= set->tolerance){
+        Quat q_opposite;
+        quat_setter(&q_opposite, -q_canonical.r, -q_canonical.i, -q_canonical.j, -q_canonical.k);
+        index = find_near(set, &q_opposite);
+    }
+
+    return index;
+}
+
+size_t rotation_set_insert(Rotation_Set * set, Quat const * q, bool * inserted){
+    size_t index = rotation_set_find(set, q);
+
+    if (inserted != NULL){
+        *inserted = false;
+    }
+
+    if (index != ROTATION_SET_NOT_FOUND || set->count == set->capacity){
+        return index;
+    }
+
+    Quat q_canonical;
+    Quat_Cell cell;
+    quat_copy(q, &q_canonical);
+    quat_canonicalize(&q_canonical);
+    if (!cell_of_quat(&q_canonical, set->cell_size, &cell)){
+        return ROTATION_SET_NOT_FOUND;
+    }
+
+    index = set->count;
+    quat_copy(&q_canonical, &set->rotations[index]);
+    set->count++;
+
+    size_t mask = set->nbr_slots - 1;
+    size_t slot = hash_of_cell(&cell) & mask;
+    // there is always an empty slot, as nbr_slots > capacity
+    while (set->slots[slot] != EMPTY_SLOT){
+        slot = (slot + 1) & mask;
+    }
+    set->slots[slot] = index;
+
+    if (inserted != NULL){
+        *inserted = true;
+    }
+
+    return index;
+}
+
+size_t rotations_dedup(Quat const * q_array, size_t count, Rotation_Set * set, size_t * unique_indexes){
+    for (size_t n = 0; n < count; n++){
+        size_t index = rotation_set_insert(set, &q_array[n]);
+        if (unique_indexes != NULL){
+            unique_indexes[n] = index;
+        }
+    }
+
+    return set->count;
+}
@@ -0,0 +1,84 @@
+#ifndef KISS_CLANG_3D_ROTATION_SET_H
+#define KISS_CLANG_3D_ROTATION_SET_H
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// Set of rotations with a tolerance, in the default precision (F_TYPE): 2 unit
+// quaternions are the same rotation if they are equal up to the tolerance (as
+// quat_equal), or opposite up to the tolerance (q and -q are the same rotation).
+// The rotations are stored with their canonical sign (see quat_canonicalize), and
+// hashed on a grid of cells of a few tolerances; a lookup only probes the cells
+// within the tolerance of the quaternion, so that inserting / finding is O(1) on
+// average, and deduplicating n rotations is O(n) instead of O(n^2) with pairwise
+// comparisons. The deduplication is approximate in the usual way of tolerances:
+// each rotation is matched to one of the stored rotations within tolerance (if
+// any), and "equal within tolerance" is not transitive, so the result depends on
+// the insertion order.
+// All the memory is provided by the caller; nothing is allocated.
+
+#include "./kiss_clang_3d.h"
+
+// ------------------------------------------------------------
+// STRUCTS
+// ------------------------------------------------------------
+
+// --------------------------------------------------
+// the set itself; use rotation_set_init to set it up, and only read the members.
+// rotations[0 .. count - 1] are the distinct rotations, in insertion order; slots is
+// an open addressing hash table of indexes in rotations.
+struct Rotation_Set {
+    Quat * rotations;
+    size_t capacity;
+    size_t count;
+    size_t * slots;
+    size_t nbr_slots;
+    F_TYPE tolerance;
+    F_TYPE cell_size;
+};
+
+// index returned when a rotation is not found, or can not be inserted
+#define ROTATION_SET_NOT_FOUND SIZE_MAX
+
+// ------------------------------------------------------------
+// FUNCTIONS DECLARATIONS
+// ------------------------------------------------------------
+
+/*
+Set up an empty set over caller memory: rotations can hold capacity rotations, and
+slots has nbr_slots elements. nbr_slots must be a power of 2, larger than capacity;
+twice capacity or more keeps the probe sequences short. Return false if the memory
+or tolerance (> 0) is not valid.
+*/
+bool rotation_set_init(Rotation_Set * set, Quat * rotations, size_t capacity, size_t * slots, size_t nbr_slots, F_TYPE tolerance=DEFAULT_TOL);
+
+/*
+Remove all the rotations, keeping the memory and tolerance.
+*/
+void rotation_set_clear(Rotation_Set * set);
+
+/*
+Index in set->rotations of a rotation equal to q (up to the tolerance and the sign),
+or ROTATION_SET_NOT_FOUND; this is also the case for a q with non finite components, or
+components far out of the range of unit quaternions (beyond 2^62 cells).
+*/
+size_t rotation_set_find(Rotation_Set const * set, Quat const * q);
+
+/*
+Insert q if no equal rotation is in the set yet. Return the index of the rotation of
+the set equal to q (the existing one, or q itself, canonicalized, if it was inserted),
+or ROTATION_SET_NOT_FOUND if the set is full, or if q is rejected, as it has non finite
+components or components far out of the range of unit quaternions (see
+rotation_set_find). If inserted is not null, it tells if q was inserted.
+*/
+size_t rotation_set_insert(Rotation_Set * set, Quat const * q, bool * inserted=NULL);
+
+/*
+Deduplicate an array of count unit quaternions: all of them are inserted in the set,
+and, if unique_indexes is not null, the index in set->rotations of the rotation each
+of them was matched to is written there (ROTATION_SET_NOT_FOUND if the set got full,
+or for rejected quaternions, as in rotation_set_insert).
+Return the number of distinct rotations in the set.
+*/
+size_t rotations_dedup(Quat const * q_array, size_t count, Rotation_Set * set, size_t * unique_indexes=NULL);
+
+#endif
@@ -0,0 +1,239 @@
+#include "kiss_clang_3d_sample_ring.h"
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// ------------------------------------------------------------
+// INTERNALS
+// ------------------------------------------------------------
+
+static bool indexes_init(SPSC_Indexes * indexes, size_t capacity){
+    bool capacity_power_of_2 = capacity != 0 && (capacity & (capacity - 1)) == 0;
+
+    if (!capacity_power_of_2){
+        return false;
+    }
+
+    indexes->head.store(0, std::memory_order_relaxed);
+    indexes->tail.store(0, std::memory_order_relaxed);
+    indexes->tail_cache = 0;
+    indexes->head_cache = 0;
+    indexes->mask = capacity - 1;
+
+    return true;
+}
+
+// producer: first index to write, and the number of free slots, up to wanted; the
+// tail of the consumer is only reloaded when the cached one does not leave enough room
+static size_t reserve_push(SPSC_Indexes * indexes, size_t wanted, size_t * first){
+    size_t capacity = indexes->mask + 1;
+    size_t head = indexes->head.load(std::memory_order_relaxed);
+    size_t free_slots = capacity - (head - indexes->tail_cache);
+
+    if (free_slots < wanted){
+        // acquire: the consumer is done with the slots before its tail
+        indexes->tail_cache = indexes->tail.load(std::memory_order_acquire);
+        free_slots = capacity - (head - indexes->tail_cache);
+    }
+
+    *first = head;
+    return free_slots < wanted ? free_slots : wanted;
+}
+
+// release: the samples written are visible to the consumer before the new head
+static void commit_push(SPSC_Indexes * indexes, size_t first, size_t count){
+    indexes->head.store(first + count, std::memory_order_release);
+}
+
+// consumer: first index to read, and the number of samples available, up to wanted
+static size_t reserve_pop(SPSC_Indexes * indexes, size_t wanted, size_t * first){
+    size_t tail = indexes->tail.load(std::memory_order_relaxed);
+    size_t available = indexes->head_cache - tail;
+
+    if (available < wanted){
+        // acquire: the samples before the head of the producer are written
+        indexes->head_cache = indexes->head.load(std::memory_order_acquire);
+        available = indexes->head_cache - tail;
+    }
+
+    *first = tail;
+    return available < wanted ? available : wanted;
+}
+
+// release: the samples are read before the producer may write over them
+static void commit_pop(SPSC_Indexes * indexes, size_t first, size_t count){
+    indexes->tail.store(first + count, std::memory_order_release);
+}
+
+static size_t indexes_size(SPSC_Indexes const * indexes){
+    size_t tail = indexes->tail.load(std::memory_order_acquire);
+    size_t head = indexes->head.load(std::memory_order_acquire);
+    return head - tail;
+}
+
+// ------------------------------------------------------------
+// FUNCTIONS DEFINITIONS
+// ------------------------------------------------------------
+
+bool vec3_ring_init(Vec3_Ring * ring, Vec3 * samples, size_t capacity){
+    if (samples == NULL || !indexes_init(&ring->indexes, capacity)){
+        return false;
+    }
+
+    ring->samples = samples;
+    return true;
+}
+
+bool quat_ring_init(Quat_Ring * ring, Quat * samples, size_t capacity){
+    if (samples == NULL || !indexes_init(&ring->indexes, capacity)){
+        return false;
+    }
+
+    ring->samples = samples;
+    return true;
+}
+
+bool vec3_ring_push(Vec3_Ring * ring, Vec3 const * v){
+    size_t first;
+
+    if (reserve_push(&ring->indexes, 1, &first) == 0){
+        return false;
+    }
+
+    vec3_copy(v, &ring->samples[first & ring->indexes.mask]);
+    commit_push(&ring->indexes, first, 1);
+    return true;
+}
+
+size_t vec3_ring_push_batch(Vec3_Ring * ring, Vec3_View const * v_in){
+    size_t first;
+    size_t count = reserve_push(&ring->indexes, v_in->count, &first);
+
+    for (size_t n = 0; n < count; n++){
+        vec3_view_get(v_in, n, &ring->samples[(first + n) & ring->indexes.mask]);
+    }
+
+    commit_push(&ring->indexes, first, count);
+    return count;
+}
+
+bool quat_ring_push(Quat_Ring * ring, Quat const * q){
+    size_t first;
+
+    if (reserve_push(&ring->indexes, 1, &first) == 0){
+        return false;
+    }
+
+    quat_copy(q, &ring->samples[first & ring->indexes.mask]);
+    commit_push(&ring->indexes, first, 1);
+    return true;
+}
+
+size_t quat_ring_push_batch(Quat_Ring * ring, Quat_View const * q_in){
+    size_t first;
+    size_t count = reserve_push(&ring->indexes, q_in->count, &first);
+
+    for (size_t n = 0; n < count; n++){
+        quat_view_get(q_in, n, &ring->samples[(first + n) & ring->indexes.mask]);
+    }
+
+    commit_push(&ring->indexes, first, count);
+    return count;
+}
+
+bool vec3_ring_pop(Vec3_Ring * ring, Vec3 * v){
+    size_t first;
+
+    if (reserve_pop(&ring->indexes, 1, &first) == 0){
+        return false;
+    }
+
+    vec3_copy(&ring->samples[first & ring->indexes.mask], v);
+    commit_pop(&ring->indexes, first, 1);
+    return true;
+}
+
+size_t vec3_ring_pop_batch(Vec3_Ring * ring, Vec3_View const * v_out){
+    size_t first;
+    size_t count = reserve_pop(&ring->indexes, v_out->count, &first);
+
+    for (size_t n = 0; n < count; n++){
+        vec3_view_set(v_out, n, &ring->samples[(first + n) & ring->indexes.mask]);
+    }
+
+    commit_pop(&ring->indexes, first, count);
+    return count;
+}
+
+bool quat_ring_pop(Quat_Ring * ring, Quat * q){
+    size_t first;
+
+    if (reserve_pop(&ring->indexes, 1, &first) == 0){
+        return false;
+    }
+
+    quat_copy(&ring->samples[first & ring->indexes.mask], q);
+    commit_pop(&ring->indexes, first, 1);
+    return true;
+}
+
+size_t quat_ring_pop_batch(Quat_Ring * ring, Quat_View const * q_out){
+    size_t first;
+    size_t count = reserve_pop(&ring->indexes, q_out->count, &first);
+
+    for (size_t n = 0; n < count; n++){
+        quat_view_set(q_out, n, &ring->samples[(first + n) & ring->indexes.mask]);
+    }
+
+    commit_pop(&ring->indexes, first, count);
+    return count;
+}
+
+size_t vec3_ring_size(Vec3_Ring const * ring){
+    return indexes_size(&ring->indexes);
+}
+
+size_t quat_ring_size(Quat_Ring const * ring){
+    return indexes_size(&ring->indexes);
+}
+
+void quat_seqlock_init(Quat_Seqlock * lock, Quat const * q){
+    lock->sequence.store(0, std::memory_order_relaxed);
+    lock->components[0].store(q->r, std::memory_order_relaxed);
+    lock->components[1].store(q->i, std::memory_order_relaxed);
+    lock->components[2].store(q->j, std::memory_order_relaxed);
+    lock->components[3].store(q->k, std::memory_order_relaxed);
+}
+
+void quat_seqlock_write(Quat_Seqlock * lock, Quat const * q){
+    uint64_t sequence = lock->sequence.load(std::memory_order_relaxed);
+
+    // odd while writing; the fence keeps the components after it
+    lock->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    lock->components[0].store(q->r, std::memory_order_relaxed);
+    lock->components[1].store(q->i, std::memory_order_relaxed);
+    lock->components[2].store(q->j, std::memory_order_relaxed);
+    lock->components[3].store(q->k, std::memory_order_relaxed);
+    lock->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+uint64_t quat_seqlock_read(Quat_Seqlock const * lock, Quat * q){
+    while (true){
+        uint64_t sequence_before = lock->sequence.load(std::memory_order_acquire);
+        if (sequence_before % 2 == 1){
+            continue;
+        }
+
+        F_TYPE r = lock->components[0].load(std::memory_order_relaxed);
+        F_TYPE i = lock->components[1].load(std::memory_order_relaxed);
+        F_TYPE j = lock->components[2].load(std::memory_order_relaxed);
+        F_TYPE k = lock->components[3].load(std::memory_order_relaxed);
+
+        // the fence keeps the components before the second read of the sequence
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (lock->sequence.load(std::memory_order_relaxed) == sequence_before){
+            quat_setter(q, r, i, j, k);
+            return sequence_before / 2;
+        }
+    }
+}
@@ -0,0 +1,118 @@
+#ifndef KISS_CLANG_3D_SAMPLE_RING_H
+#define KISS_CLANG_3D_SAMPLE_RING_H
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// Lock free exchange of samples between 2 threads, in the default precision (F_TYPE),
+// for example from an acquisition thread to a fusion thread:
+// - rings of Vec3 (or Quat) samples, with exactly one producer thread and one consumer
+//   thread (single producer, single consumer), and batch push and pop. The indexes
+//   written by the producer and by the consumer are on different cache lines, and each
+//   side keeps a copy of the index of the other side, which it reloads only when the
+//   ring looks full (or empty), so that the 2 threads do not keep bouncing the same
+//   cache line between their cores;
+// - a sequence lock publishing the latest value of a Quat (for example the current
+//   attitude) from one writer thread to any number of reader threads: the writer never
+//   waits, and the readers retry if the value changed while they were reading it.
+// C++ only, as the other optional components: the indexes and the published values are
+// std::atomic. The memory of the samples is provided by the caller; nothing is allocated.
+
+#include "./kiss_clang_3d.h"
+
+#include <atomic>
+
+// size of the cache lines, to keep the data of the 2 threads apart
+#define KISS_CACHE_LINE 64
+
+// ------------------------------------------------------------
+// STRUCTS
+// ------------------------------------------------------------
+
+// --------------------------------------------------
+// indexes of a single producer, single consumer ring. head and tail only grow (the slot
+// of an index is index & mask), so that the ring is full when head - tail is its
+// capacity; the producer owns head and tail_cache, the consumer tail and head_cache.
+struct SPSC_Indexes {
+    alignas(KISS_CACHE_LINE) std::atomic<size_t> head;
+    size_t tail_cache;
+    alignas(KISS_CACHE_LINE) std::atomic<size_t> tail;
+    size_t head_cache;
+    alignas(KISS_CACHE_LINE) size_t mask;
+};
+
+// --------------------------------------------------
+// the rings; use vec3_ring_init / quat_ring_init to set them up
+struct Vec3_Ring {
+    SPSC_Indexes indexes;
+    Vec3 * samples;
+};
+
+struct Quat_Ring {
+    SPSC_Indexes indexes;
+    Quat * samples;
+};
+
+// --------------------------------------------------
+// latest value of a Quat; sequence is odd while the writer is changing the value
+struct Quat_Seqlock {
+    alignas(KISS_CACHE_LINE) std::atomic<uint64_t> sequence;
+    std::atomic<F_TYPE> components[4];
+};
+
+// ------------------------------------------------------------
+// FUNCTIONS DECLARATIONS
+// ------------------------------------------------------------
+
+/*
+Set up an empty ring over caller memory: samples has capacity elements, and capacity
+must be a power of 2. Return false if it is not, or samples is null. This must be done
+before the 2 threads start to use the ring.
+*/
+bool vec3_ring_init(Vec3_Ring * ring, Vec3 * samples, size_t capacity);
+bool quat_ring_init(Quat_Ring * ring, Quat * samples, size_t capacity);
+
+/*
+Producer side: add a sample, or as many of the samples of v_in (q_in) as there is room
+for, in order. vec3_ring_push returns false if the ring is full; the batch versions
+return the number of samples added.
+*/
+bool vec3_ring_push(Vec3_Ring * ring, Vec3 const * v);
+size_t vec3_ring_push_batch(Vec3_Ring * ring, Vec3_View const * v_in);
+bool quat_ring_push(Quat_Ring * ring, Quat const * q);
+size_t quat_ring_push_batch(Quat_Ring * ring, Quat_View const * q_in);
+
+/*
+Consumer side: take the oldest sample, or as many of the oldest samples as there are
+(up to the count of v_out / q_out), in order. vec3_ring_pop returns false if the ring
+is empty; the batch versions return the number of samples taken.
+*/
+bool vec3_ring_pop(Vec3_Ring * ring, Vec3 * v);
+size_t vec3_ring_pop_batch(Vec3_Ring * ring, Vec3_View const * v_out);
+bool quat_ring_pop(Quat_Ring * ring, Quat * q);
+size_t quat_ring_pop_batch(Quat_Ring * ring, Quat_View const * q_out);
+
+/*
+Number of samples in the ring; from either thread, this is only a snapshot.
+*/
+size_t vec3_ring_size(Vec3_Ring const * ring);
+size_t quat_ring_size(Quat_Ring const * ring);
+
+/*
+Set up the lock with the value q, as version 0. This must be done before the threads
+start to use it.
+*/
+void quat_seqlock_init(Quat_Seqlock * lock, Quat const * q);
+
+/*
+Writer side (one thread only): publish a new value, without waiting.
+*/
+void quat_seqlock_write(Quat_Seqlock * lock, Quat const * q);
+
+/*
+Reader side (any thread): copy of the latest value published, consistent (never mixing
+components of 2 values). Return its version, the number of values published before it,
+so that a reader can tell if the value changed since its last read.
+*/
+uint64_t quat_seqlock_read(Quat_Seqlock const * lock, Quat * q);
+
+#endif
@@ -0,0 +1,108 @@
+#include "kiss_clang_3d_so3_sampling.h"
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// ------------------------------------------------------------
+// INTERNALS
+// ------------------------------------------------------------
+
+// the golden ratio, and the constants of the super-Fibonacci spirals
+#define GOLDEN_RATIO (1.6180339887498948482)
+#define SUPER_FIBONACCI_PHI (1.4142135623730950488)
+#define SUPER_FIBONACCI_PSI (1.5337511687552042881)
+
+// splitmix64
+static uint64_t next_bits(SO3_Rng * rng){
+    rng->state += 0x9e3779b97f4a7c15ULL;
+    uint64_t bits = rng->state;
+    bits = (bits ^ (bits >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    bits = (bits ^ (bits >> 27)) * 0x94d049bb133111ebULL;
+    return bits ^ (bits >> 31);
+}
+
+// fractional part of x / ratio, in double: the indexes of large grids do not fit the
+// mantissa of a float
+static F_TYPE turn_fraction(double x, double ratio){
+    double turns = x / ratio;
+    return F_TYPE_FROM_DOUBLE(turns - floor(turns));
+}
+
+// ------------------------------------------------------------
+// FUNCTIONS DEFINITIONS
+// ------------------------------------------------------------
+
+void so3_rng_seed(SO3_Rng * rng, uint64_t seed){
+    rng->state = seed;
+}
+
+F_TYPE so3_rng_uniform(SO3_Rng * rng){
+    return F_TYPE_FROM_DOUBLE(KISS_CAST(double, next_bits(rng) >> 11) * (1.0 / 9007199254740992.0));
+}
+
+void so3_random(SO3_Rng * rng, Quat * q){
+    F_TYPE u_1 = so3_rng_uniform(rng);
+    F_TYPE angle_1 = F_TYPE_2 * F_TYPE_PI * so3_rng_uniform(rng);
+    F_TYPE angle_2 = F_TYPE_2 * F_TYPE_PI * so3_rng_uniform(rng);
+
+    // 2 circles, with radii of squares uniform in [0, 1] and summing to 1
+    F_TYPE radius_1 = F_TYPE_SQRT(F_TYPE_1 - u_1);
+    F_TYPE radius_2 = F_TYPE_SQRT(u_1);
+
+    quat_setter(q, radius_2 * F_TYPE_COS(angle_2), radius_1 * F_TYPE_SIN(angle_1), radius_1 * F_TYPE_COS(angle_1), radius_2 * F_TYPE_SIN(angle_2));
+}
+
+void so3_random_batch(SO3_Rng * rng, Quat_View const * q_out){
+    Quat crrt_out;
+
+    for (size_t n = 0; n < q_out->count; n++){
+        so3_random(rng, &crrt_out);
+        quat_view_set(q_out, n, &crrt_out);
+    }
+}
+
+void so3_fibonacci_grid(Quat_View const * q_out){
+    double const count = KISS_CAST(double, q_out->count);
+    Quat crrt_out;
+
+    for (size_t n = 0; n < q_out->count; n++){
+        double s = KISS_CAST(double, n) + 0.5;
+        F_TYPE t = F_TYPE_FROM_DOUBLE(s / count);
+        F_TYPE radius_1 = F_TYPE_SQRT(t);
+        F_TYPE radius_2 = F_TYPE_SQRT(F_TYPE_1 - t);
+        F_TYPE angle_1 = F_TYPE_2 * F_TYPE_PI * turn_fraction(s, SUPER_FIBONACCI_PHI);
+        F_TYPE angle_2 = F_TYPE_2 * F_TYPE_PI * turn_fraction(s, SUPER_FIBONACCI_PSI);
+
+        quat_setter(&crrt_out, radius_2 * F_TYPE_COS(angle_2), radius_1 * F_TYPE_SIN(angle_1), radius_1 * F_TYPE_COS(angle_1), radius_2 * F_TYPE_SIN(angle_2));
+        quat_view_set(q_out, n, &crrt_out);
+    }
+}
+
+size_t so3_hopf_grid(size_t nbr_sphere, size_t nbr_circle, Quat_View const * q_out){
+    size_t written = 0;
+    Quat crrt_out;
+
+    for (size_t n_sphere = 0; n_sphere < nbr_sphere; n_sphere++){
+        // Fibonacci sphere: heights evenly spaced (the sphere has the same area in
+        // slices of the same height), and longitudes turning by the golden ratio
+        F_TYPE z = F_TYPE_FROM_DOUBLE(1.0 - (2.0 * KISS_CAST(double, n_sphere) + 1.0) / KISS_CAST(double, nbr_sphere));
+        F_TYPE half_longitude = F_TYPE_PI * turn_fraction(KISS_CAST(double, n_sphere), GOLDEN_RATIO);
+        // cos and sin of half the colatitude
+        F_TYPE cos_half = F_TYPE_SQRT((F_TYPE_1 + z) * F_TYPE_05);
+        F_TYPE sin_half = F_TYPE_SQRT((F_TYPE_1 - z) * F_TYPE_05);
+
+        for (size_t n_circle = 0; n_circle < nbr_circle; n_circle++){
+            if (written == q_out->count){
+                return written;
+            }
+
+            // rotation of psi around k, then of the colatitude around j, then of the
+            // longitude around k; psi / 2 in [0, pi), as q and -q are the same rotation
+            F_TYPE half_psi = F_TYPE_PI * F_TYPE_FROM_DOUBLE((KISS_CAST(double, n_circle) + 0.5) / KISS_CAST(double, nbr_circle));
+            quat_setter(&crrt_out, cos_half * F_TYPE_COS(half_longitude + half_psi), sin_half * F_TYPE_SIN(half_psi - half_longitude), sin_half * F_TYPE_COS(half_psi - half_longitude), cos_half * F_TYPE_SIN(half_longitude + half_psi));
+            quat_view_set(q_out, written, &crrt_out);
+            written++;
+        }
+    }
+
+    return written;
+}
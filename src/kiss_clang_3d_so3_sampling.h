@@ -0,0 +1,71 @@
+#ifndef KISS_CLANG_3D_SO3_SAMPLING_H
+#define KISS_CLANG_3D_SO3_SAMPLING_H
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// Sets of orientations covering SO(3), in the default precision (F_TYPE), for tests and
+// search over orientations. Random axes and angles are not uniform over the rotations
+// (they crowd the small angles); these are:
+// - uniform random unit quaternions, with the method of Shoemake ("Uniform random
+//   rotations", Graphics Gems III, 1992), from a small seeded generator (splitmix64),
+//   so that the sequences are reproducible on all platforms;
+// - deterministic grids of any size: the super-Fibonacci spirals of Alexa ("Super-
+//   Fibonacci spirals: fast, low-discrepancy sampling of SO(3)", CVPR 2022), and
+//   Hopf fibration grids, as Yershova et al. ("Generating uniform incremental grids on
+//   SO(3) using the Hopf fibration", 2010), with Fibonacci points on the sphere in
+//   place of HEALPix, for a resolution chosen separately on the sphere and the circle.
+// The quaternions are written to views, as the batch functions.
+
+#include "./kiss_clang_3d.h"
+
+// ------------------------------------------------------------
+// STRUCTS
+// ------------------------------------------------------------
+
+// --------------------------------------------------
+// state of the random generator; use so3_rng_seed to set it up
+struct SO3_Rng {
+    uint64_t state;
+};
+
+// ------------------------------------------------------------
+// FUNCTIONS DECLARATIONS
+// ------------------------------------------------------------
+
+/*
+Seed the random generator; the same seed always gives the same sequence.
+*/
+void so3_rng_seed(SO3_Rng * rng, uint64_t seed);
+
+/*
+Next uniform random number in [0, 1] (the 53 bits of a double, rounded to F_TYPE).
+*/
+F_TYPE so3_rng_uniform(SO3_Rng * rng);
+
+/*
+Uniform random rotation, as a unit quaternion.
+*/
+void so3_random(SO3_Rng * rng, Quat * q);
+
+/*
+Uniform random rotations, for all the quaternions of q_out.
+*/
+void so3_random_batch(SO3_Rng * rng, Quat_View const * q_out);
+
+/*
+Super-Fibonacci spiral with as many rotations as the count of q_out: deterministic,
+low discrepancy, and more evenly spread than random rotations, for any count.
+*/
+void so3_fibonacci_grid(Quat_View const * q_out);
+
+/*
+Hopf fibration grid of nbr_sphere * nbr_circle rotations: nbr_sphere directions on the
+sphere, times nbr_circle angles around each of them. The spacing is about even when
+nbr_circle is close to sqrt(pi * nbr_sphere). Rotation n_sphere * nbr_circle + n_circle
+turns by the angle n_circle around k, then takes k to the direction n_sphere. Return the
+number of rotations written, which is less than nbr_sphere * nbr_circle if q_out is too
+small.
+*/
+size_t so3_hopf_grid(size_t nbr_sphere, size_t nbr_circle, Quat_View const * q_out);
+
+#endif
@@ -0,0 +1,215 @@
+#include "kiss_clang_3d_voxel_grid.h"
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// ------------------------------------------------------------
+// INTERNALS
+// ------------------------------------------------------------
+
+// marks an empty slot of the hash table
+#define EMPTY_SLOT SIZE_MAX
+
+// largest |coordinate| of a voxel, 2^62: converting a larger (or non finite) value to
+// int64_t is undefined, and the neighbours of a voxel must not overflow either
+#define MAX_VOXEL_COORD (4611686018427387904.0)
+
+static bool voxel_coord(F_TYPE x, F_TYPE inv_voxel_size, int64_t * coord){
+    F_TYPE scaled = F_TYPE_FLOOR(x * inv_voxel_size);
+
+    // written so that NaN fails
+    if (!(F_TYPE_ABS(scaled) <= F_TYPE_FROM_DOUBLE(MAX_VOXEL_COORD))){
+        return false;
+    }
+
+    *coord = KISS_CAST(int64_t, scaled);
+    return true;
+}
+
+// splitmix64 steps over the 3 coordinates
+static size_t hash_of_coords(int64_t const coords[3]){
+    uint64_t hash = 0;
+
+    for (int n = 0; n < 3; n++){
+        hash += KISS_CAST(uint64_t, coords[n]) + 0x9e3779b97f4a7c15ULL;
+        hash ^= hash >> 30;
+        hash *= 0xbf58476d1ce4e5b9ULL;
+        hash ^= hash >> 27;
+        hash *= 0x94d049bb133111ebULL;
+        hash ^= hash >> 31;
+    }
+
+    return hash;
+}
+
+static bool same_coords(int64_t const coords_1[3], int64_t const coords_2[3]){
+    return coords_1[0] == coords_2[0] && coords_1[1] == coords_2[1] && coords_1[2] == coords_2[2];
+}
+
+// the slot of the voxel of coords, or the empty slot where it would go
+static size_t slot_of(Voxel_Grid const * grid, int64_t const coords[3]){
+    size_t mask = grid->nbr_slots - 1;
+    size_t slot = hash_of_coords(coords) & mask;
+
+    while (grid->slots[slot] != EMPTY_SLOT && !same_coords(grid->voxels[grid->slots[slot]].coords, coords)){
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+// ------------------------------------------------------------
+// FUNCTIONS DEFINITIONS
+// ------------------------------------------------------------
+
+bool voxel_grid_init(Voxel_Grid * grid, F_TYPE voxel_size, Voxel * voxels, size_t capacity, size_t * slots, size_t nbr_slots, Vec3 * points, size_t * next_points, size_t points_capacity){
+    bool nbr_slots_power_of_2 = nbr_slots != 0 && (nbr_slots & (nbr_slots - 1)) == 0;
+
+    if (voxels == NULL || slots == NULL || !nbr_slots_power_of_2 || nbr_slots <= capacity || !(voxel_size > F_TYPE_0)){
+        return false;
+    }
+
+    grid->voxel_size = voxel_size;
+    grid->inv_voxel_size = F_TYPE_1 / voxel_size;
+    grid->voxels = voxels;
+    grid->capacity = capacity;
+    grid->slots = slots;
+    grid->nbr_slots = nbr_slots;
+    grid->points = points;
+    grid->next_points = next_points;
+    grid->points_capacity = (points != NULL && next_points != NULL) ? points_capacity : 0;
+
+    voxel_grid_clear(grid);
+
+    return true;
+}
+
+void voxel_grid_clear(Voxel_Grid * grid){
+    for (size_t n = 0; n < grid->nbr_slots; n++){
+        grid->slots[n] = EMPTY_SLOT;
+    }
+    grid->nbr_voxels = 0;
+    grid->nbr_points = 0;
+}
+
+bool voxel_grid_coords(Voxel_Grid const * grid, Vec3 const * point, int64_t coords[3]){
+    return(
+        voxel_coord(point->i, grid->inv_voxel_size, &coords[0]) &&
+        voxel_coord(point->j, grid->inv_voxel_size, &coords[1]) &&
+        voxel_coord(point->k, grid->inv_voxel_size, &coords[2])
+    );
+}
+
+size_t voxel_grid_find(Voxel_Grid const * grid, int64_t const coords[3]){
+    size_t index = grid->slots[slot_of(grid, coords)];
+    return index == EMPTY_SLOT ? VOXEL_GRID_NOT_FOUND : index;
+}
+
+size_t voxel_grid_insert(Voxel_Grid * grid, Vec3 const * point){
+    int64_t coords[3];
+    if (!voxel_grid_coords(grid, point, coords)){
+        return VOXEL_GRID_NOT_FOUND;
+    }
+
+    size_t slot = slot_of(grid, coords);
+    size_t index = grid->slots[slot];
+
+    if (index == EMPTY_SLOT){
+        if (grid->nbr_voxels == grid->capacity){
+            return VOXEL_GRID_NOT_FOUND;
+        }
+
+        index = grid->nbr_voxels++;
+        grid->slots[slot] = index;
+
+        Voxel * voxel = &grid->voxels[index];
+        voxel->coords[0] = coords[0];
+        voxel->coords[1] = coords[1];
+        voxel->coords[2] = coords[2];
+        vec3_setter(&voxel->centroid, F_TYPE_0, F_TYPE_0, F_TYPE_0);
+        voxel->count = 0;
+        voxel->first_point = VOXEL_GRID_NOT_FOUND;
+    }
+
+    Voxel * voxel = &grid->voxels[index];
+    voxel->count++;
+    F_TYPE weight = F_TYPE_1 / KISS_CAST(F_TYPE, voxel->count);
+    voxel->centroid.i += (point->i - voxel->centroid.i) * weight;
+    voxel->centroid.j += (point->j - voxel->centroid.j) * weight;
+    voxel->centroid.k += (point->k - voxel->centroid.k) * weight;
+
+    if (grid->nbr_points < grid->points_capacity){
+        size_t point_index = grid->nbr_points++;
+        vec3_copy(point, &grid->points[point_index]);
+        grid->next_points[point_index] = voxel->first_point;
+        voxel->first_point = point_index;
+    }
+
+    return index;
+}
+
+size_t voxel_grid_insert_batch(Voxel_Grid * grid, Vec3_View const * points){
+    size_t nbr_inserted = 0;
+    Vec3 crrt_point;
+
+    for (size_t n = 0; n < points->count; n++){
+        vec3_view_get(points, n, &crrt_point);
+        if (voxel_grid_insert(grid, &crrt_point) != VOXEL_GRID_NOT_FOUND){
+            nbr_inserted++;
+        }
+    }
+
+    return nbr_inserted;
+}
+
+size_t voxel_grid_insert_transformed_batch(Voxel_Grid * grid, Vec3_View const * points, Quat const * rotation, Vec3 const * translation){
+    size_t nbr_inserted = 0;
+    Vec3 crrt_point;
+    Vec3 transformed_point;
+
+    for (size_t n = 0; n < points->count; n++){
+        vec3_view_get(points, n, &crrt_point);
+        rotate_by_quat_R(&crrt_point, rotation, &transformed_point);
+        vec3_add(&transformed_point, translation);
+        if (voxel_grid_insert(grid, &transformed_point) != VOXEL_GRID_NOT_FOUND){
+            nbr_inserted++;
+        }
+    }
+
+    return nbr_inserted;
+}
+
+size_t voxel_grid_neighbours(Voxel_Grid const * grid, Vec3 const * point, size_t * voxel_indexes){
+    int64_t center[3];
+    int64_t coords[3];
+    size_t nbr_found = 0;
+
+    if (!voxel_grid_coords(grid, point, center)){
+        return 0;
+    }
+
+    for (int64_t di = -1; di <= 1; di++){
+        for (int64_t dj = -1; dj <= 1; dj++){
+            for (int64_t dk = -1; dk <= 1; dk++){
+                coords[0] = center[0] + di;
+                coords[1] = center[1] + dj;
+                coords[2] = center[2] + dk;
+                size_t index = voxel_grid_find(grid, coords);
+                if (index != VOXEL_GRID_NOT_FOUND){
+                    voxel_indexes[nbr_found++] = index;
+                }
+            }
+        }
+    }
+
+    return nbr_found;
+}
+
+size_t voxel_grid_downsample(Voxel_Grid const * grid, Vec3_View const * centroids_out){
+    size_t count = grid->nbr_voxels < centroids_out->count ? grid->nbr_voxels : centroids_out->count;
+
+    for (size_t n = 0; n < count; n++){
+        vec3_view_set(centroids_out, n, &grid->voxels[n].centroid);
+    }
+
+    return count;
+}
@@ -0,0 +1,119 @@
+#ifndef KISS_CLANG_3D_VOXEL_GRID_H
+#define KISS_CLANG_3D_VOXEL_GRID_H
+
+// for more information, see: https://github.com/jerabaul29/kiss_clang_3d_utils
+
+// Uniform voxel grid over Vec3 points, in the default precision (F_TYPE), for binning
+// streams of points (for example lidar frames) without any allocation per point.
+// Only the voxels that receive points exist: they are stored one after the other in
+// an array, and found from their integer coordinates (floor of the point coordinates
+// divided by the voxel size) through an open addressing hash table. Each voxel keeps
+// the number and the centroid of its points, which is what a voxel grid filter
+// (downsampling) needs; optionally, the points themselves are also kept, in an arena
+// where the points of each voxel are linked together.
+// All the memory is provided by the caller; nothing is allocated.
+
+#include "./kiss_clang_3d.h"
+
+// ------------------------------------------------------------
+// STRUCTS
+// ------------------------------------------------------------
+
+// --------------------------------------------------
+// a voxel, with its integer coordinates i, j, k; its points (if the grid keeps them)
+// are first_point, next_points[first_point], ..., until VOXEL_GRID_NOT_FOUND
+struct Voxel {
+    int64_t coords[3];
+    Vec3 centroid;
+    size_t count;
+    size_t first_point;
+};
+
+// --------------------------------------------------
+// the grid; use voxel_grid_init to set it up, and only read the members
+struct Voxel_Grid {
+    F_TYPE voxel_size;
+    F_TYPE inv_voxel_size;
+    Voxel * voxels;
+    size_t capacity;
+    size_t nbr_voxels;
+    size_t * slots;
+    size_t nbr_slots;
+    Vec3 * points;
+    size_t * next_points;
+    size_t points_capacity;
+    size_t nbr_points;
+};
+
+// index returned when a voxel does not exist, or can not be created, and end of the
+// lists of points
+#define VOXEL_GRID_NOT_FOUND SIZE_MAX
+
+// number of voxels in the neighbourhood of a point, itself included
+#define VOXEL_GRID_NBR_NEIGHBOURS 27
+
+// ------------------------------------------------------------
+// FUNCTIONS DECLARATIONS
+// ------------------------------------------------------------
+
+/*
+Set up an empty grid of voxels of size voxel_size (> 0) over caller memory: voxels
+can hold capacity voxels, and slots has nbr_slots elements, a power of 2 larger than
+capacity (twice capacity or more keeps the probe sequences short). If points and
+next_points are not null, the grid also keeps up to points_capacity points in them.
+Return false if the memory or the voxel size is not valid.
+*/
+bool voxel_grid_init(Voxel_Grid * grid, F_TYPE voxel_size, Voxel * voxels, size_t capacity, size_t * slots, size_t nbr_slots, Vec3 * points=NULL, size_t * next_points=NULL, size_t points_capacity=0);
+
+/*
+Remove all the voxels and points, keeping the memory and voxel size.
+*/
+void voxel_grid_clear(Voxel_Grid * grid);
+
+/*
+Integer coordinates of the voxel containing point. Return false if point is not finite
+(for example the NaN of a lidar "no return"), or its coordinates are too large for the
+voxel size (beyond +-2^62 voxels); coords is then not valid.
+*/
+bool voxel_grid_coords(Voxel_Grid const * grid, Vec3 const * point, int64_t coords[3]);
+
+/*
+Index in grid->voxels of the voxel of coordinates coords, or VOXEL_GRID_NOT_FOUND.
+*/
+size_t voxel_grid_find(Voxel_Grid const * grid, int64_t const coords[3]);
+
+/*
+Add point to its voxel, creating the voxel if needed, and updating its count and
+centroid (as a running mean, so that it stays accurate in float over many points).
+The point is also kept if the grid keeps points and its arena is not full. Return the
+index of the voxel, or VOXEL_GRID_NOT_FOUND if the point has no valid coordinates (see
+voxel_grid_coords), or its voxel had to be created but the grid is full (the point is
+then dropped).
+*/
+size_t voxel_grid_insert(Voxel_Grid * grid, Vec3 const * point);
+
+/*
+Batch insertion over a view of points; return the number of points inserted (not
+dropped, as voxel_grid_insert: when the grid is full, or the point is not valid).
+voxel_grid_insert_transformed_batch inserts rotation x points + translation (rotation
+as rotate_by_quat_R), so that a frame in the sensor coordinates can be binned in the
+world coordinates in a single pass.
+*/
+size_t voxel_grid_insert_batch(Voxel_Grid * grid, Vec3_View const * points);
+size_t voxel_grid_insert_transformed_batch(Voxel_Grid * grid, Vec3_View const * points, Quat const * rotation, Vec3 const * translation);
+
+/*
+Indexes of the existing voxels among the VOXEL_GRID_NBR_NEIGHBOURS voxels around the
+voxel of point (itself included); voxel_indexes must have VOXEL_GRID_NBR_NEIGHBOURS
+elements. Return the number of indexes written, 0 if point has no valid coordinates (see
+voxel_grid_coords).
+*/
+size_t voxel_grid_neighbours(Voxel_Grid const * grid, Vec3 const * point, size_t * voxel_indexes);
+
+/*
+Voxel grid filter: write the centroid of each voxel to centroids_out, in the order of
+grid->voxels; return the number of centroids written.
+*/
+size_t voxel_grid_downsample(Voxel_Grid const * grid, Vec3_View const * centroids_out);
+
+#endif
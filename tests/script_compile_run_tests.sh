@@ -18,7 +18,8 @@ echo " "
 echo "--------------------"
 echo "compile all tests for double"
 
-g++ $WFLAGS -DF_TYPE_SWITCH="'D'" -DKISS_CLANG_3D_IGNORE_DEPRECATED -o test_suite.out main.cpp test*.cpp ../src/kiss_clang_3d.c ../src/kiss_clang_3d_extra_utils.cpp
+g++ $WFLAGS -DF_TYPE_SWITCH="'D'" -DKISS_CLANG_3D_IGNORE_DEPRECATED -c ../src/*.c ../src/*.cpp
+g++ $WFLAGS -DF_TYPE_SWITCH="'D'" -DKISS_CLANG_3D_IGNORE_DEPRECATED -o test_suite.out main.cpp test*.cpp ./*.o
 
 echo " "
 echo "--------------------"
@@ -28,13 +29,16 @@ echo " "
 
 echo "--------------------"
 echo "cleanup double test"
-rm ./test_suite.out
+rm ./test_suite.out ./*.o
 
 echo " "
 echo "--------------------"
 echo "compile all tests for float"
 
-g++ $WFLAGS -DF_TYPE_SWITCH="'F'" -DKISS_CLANG_3D_IGNORE_DEPRECATED -fsingle-precision-constant -o test_suite.out main.cpp test*.cpp ../src/kiss_clang_3d.c ../src/kiss_clang_3d_extra_utils.cpp
+# the library itself does not need -fsingle-precision-constant (it uses float constants
+# explicitly), and some of its parts do accumulate in double; only the tests need it.
+g++ $WFLAGS -DF_TYPE_SWITCH="'F'" -DKISS_CLANG_3D_IGNORE_DEPRECATED -c ../src/*.c ../src/*.cpp
+g++ $WFLAGS -DF_TYPE_SWITCH="'F'" -DKISS_CLANG_3D_IGNORE_DEPRECATED -fsingle-precision-constant -o test_suite.out main.cpp test*.cpp ./*.o
 
 echo " "
 echo "--------------------"
@@ -44,6 +48,6 @@ echo " "
 
 echo "--------------------"
 echo "cleanup float test"
-rm ./test_suite.out
+rm ./test_suite.out ./*.o
 
 echo " "
@@ -0,0 +1,182 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+#include "../src/kiss_clang_3d_axes.h"
+
+TEST_CASE("octahedral group"){
+    Octahedral_Rotation rotation;
+    Octahedral_Rotation rotation_back;
+    Quat q;
+    Quat quats[OCTAHEDRAL_GROUP_SIZE];
+    Vec3 const v {0.3, -1.0, 2.0};
+    Vec3 Rv;
+    Vec3 Rv_quat;
+
+    REQUIRE( !octahedral_rotation_of_index(&rotation, OCTAHEDRAL_GROUP_SIZE) );
+
+    size_t nbr_mismatches {0};
+
+    for (unsigned index = 0; index < OCTAHEDRAL_GROUP_SIZE; index++){
+        REQUIRE( octahedral_rotation_of_index(&rotation, index) );
+
+        // the quaternion is a unit quaternion, that classifies back to the same rotation
+        octahedral_rotation_to_quat(&rotation, &q);
+        if (!quat_is_unitary(&q) || !quat_to_octahedral_rotation(&q, &rotation_back)){
+            nbr_mismatches++;
+            continue;
+        }
+        for (size_t c = 0; c < 3; c++){
+            if (rotation.source[c] != rotation_back.source[c] || rotation.negate[c] != rotation_back.negate[c]){
+                nbr_mismatches++;
+            }
+        }
+
+        // the exact kernel and the Rodriguez formula agree
+        rotate_by_octahedral_rotation(&v, &rotation, &Rv);
+        rotate_by_quat_R(&v, &q, &Rv_quat);
+        if (!vec3_equal(&Rv, &Rv_quat)){
+            nbr_mismatches++;
+        }
+
+        quat_copy(&q, &quats[index]);
+    }
+
+    REQUIRE( nbr_mismatches == 0 );
+
+    // the 24 rotations are all different, also up to the sign of the quaternions
+    for (size_t n = 0; n < OCTAHEDRAL_GROUP_SIZE; n++){
+        for (size_t m = n + 1; m < OCTAHEDRAL_GROUP_SIZE; m++){
+            F_TYPE scalar = quats[n].r * quats[m].r + quats[n].i * quats[m].i + quats[n].j * quats[m].j + quats[n].k * quats[m].k;
+            if (F_TYPE_ABS(scalar) > 0.99){
+                nbr_mismatches++;
+            }
+        }
+    }
+
+    REQUIRE( nbr_mismatches == 0 );
+
+    // index 0 is the identity
+    Quat const identity {1.0, 0.0, 0.0, 0.0};
+    octahedral_rotation_of_index(&rotation, 0);
+    octahedral_rotation_to_quat(&rotation, &q);
+    REQUIRE( quat_equal(&q, &identity) );
+}
+
+TEST_CASE("quat_to_octahedral_rotation"){
+    Vec3 const axis_k {0.0, 0.0, 1.0};
+    Vec3 const axis_ij {1.0, 1.0, 0.0};
+    Quat q;
+    Octahedral_Rotation rotation;
+
+    rotation_to_quat(&q, &axis_k, F_TYPE_PI / 2.0);
+    REQUIRE( quat_to_octahedral_rotation(&q, &rotation) );
+    REQUIRE( rotation.source[0] == 1 );
+    REQUIRE( rotation.negate[0] );
+
+    rotation_to_quat(&q, &axis_ij, F_TYPE_PI);
+    REQUIRE( quat_to_octahedral_rotation(&q, &rotation) );
+
+    rotation_to_quat(&q, &axis_k, 0.3);
+    REQUIRE( !quat_to_octahedral_rotation(&q, &rotation) );
+
+    rotation_to_quat(&q, &axis_ij, F_TYPE_PI / 2.0);
+    REQUIRE( !quat_to_octahedral_rotation(&q, &rotation) );
+
+    // not a unit quaternion
+    Quat const q_2 {2.0, 0.0, 0.0, 0.0};
+    REQUIRE( !quat_to_octahedral_rotation(&q_2, &rotation) );
+}
+
+TEST_CASE("rotate_by_quat_R_batch dispatch to octahedral rotations"){
+    Vec3 array[2] {
+        {1.0, 2.0, 3.0},
+        {-4.0, 5.0, 0.5}
+    };
+    Vec3_View view;
+    vec3_view_of_array(&view, array, 2);
+
+    Vec3 const axis_k {0.0, 0.0, 1.0};
+    Quat q;
+    rotation_to_quat(&q, &axis_k, F_TYPE_PI / 2.0);
+
+    // exact: (i, j, k) -> (-j, i, k)
+    rotate_by_quat_R_batch(&view, &q, &view);
+    REQUIRE( array[0].i == -2 );
+    REQUIRE( array[0].j == 1 );
+    REQUIRE( array[0].k == 3 );
+    REQUIRE( array[1].i == -5 );
+    REQUIRE( array[1].j == -4 );
+
+    // a general rotation still uses the Rodriguez formula
+    Vec3 expected;
+    rotation_to_quat(&q, &axis_k, 0.3);
+    rotate_by_quat_R(&array[0], &q, &expected);
+    rotate_by_quat_R_batch(&view, &q, &view);
+    REQUIRE( vec3_equal(&array[0], &expected) );
+}
+
+TEST_CASE("kiss3d::rotate_about"){
+    Vec3 const axes[3] {
+        {1.0, 0.0, 0.0},
+        {0.0, 1.0, 0.0},
+        {0.0, 0.0, 1.0}
+    };
+    Quat const q_specialized[3] {
+        kiss3d::rotate_about<kiss3d::Axis::I>(0.943),
+        kiss3d::rotate_about<kiss3d::Axis::J>(0.943),
+        kiss3d::rotate_about<kiss3d::Axis::K>(0.943)
+    };
+    Vec3 const v {0.3, -1.0, 2.0};
+    Vec3 const Rv_specialized[3] {
+        kiss3d::rotate_about<kiss3d::Axis::I>(0.943, v),
+        kiss3d::rotate_about<kiss3d::Axis::J>(0.943, v),
+        kiss3d::rotate_about<kiss3d::Axis::K>(0.943, v)
+    };
+
+    Quat q;
+    Vec3 Rv;
+    for (size_t n = 0; n < 3; n++){
+        rotation_to_quat(&q, &axes[n], 0.943);
+        REQUIRE( quat_equal(&q_specialized[n], &q) );
+
+        rotate_by_quat_R(&v, &q, &Rv);
+        REQUIRE( vec3_equal(&Rv_specialized[n], &Rv) );
+    }
+}
+
+TEST_CASE("kiss3d::rotate_quarter_turns"){
+    // built at compile time
+    constexpr Vec3 v {1.0, 2.0, 3.0};
+    constexpr Vec3 Rv_k = kiss3d::rotate_quarter_turns<kiss3d::Axis::K, 1>(v);
+    static_assert(Rv_k.i == -2 && Rv_k.j == 1 && Rv_k.k == 3, "quarter turn around k");
+    constexpr Vec3 Rv_k_4 = kiss3d::rotate_quarter_turns<kiss3d::Axis::K, 4>(v);
+    static_assert(Rv_k_4.i == 1 && Rv_k_4.j == 2 && Rv_k_4.k == 3, "full turn around k");
+
+    Vec3 const axis_i {1.0, 0.0, 0.0};
+    Vec3 const axis_j {0.0, 1.0, 0.0};
+    Quat q;
+    Vec3 Rv;
+
+    rotation_to_quat(&q, &axis_i, -F_TYPE_PI / 2.0);
+    rotate_by_quat_R(&v, &q, &Rv);
+    Vec3 const Rv_i = kiss3d::rotate_quarter_turns<kiss3d::Axis::I, -1>(v);
+    REQUIRE( vec3_equal(&Rv_i, &Rv) );
+
+    rotation_to_quat(&q, &axis_j, F_TYPE_PI);
+    rotate_by_quat_R(&v, &q, &Rv);
+    Vec3 const Rv_j = kiss3d::rotate_quarter_turns<kiss3d::Axis::J, 2>(v);
+    REQUIRE( vec3_equal(&Rv_j, &Rv) );
+
+    rotation_to_quat(&q, &axis_j, 3.0 * F_TYPE_PI / 2.0);
+    rotate_by_quat_R(&v, &q, &Rv);
+    Vec3 const Rv_j_3 = kiss3d::rotate_quarter_turns<kiss3d::Axis::J, 3>(v);
+    REQUIRE( vec3_equal(&Rv_j_3, &Rv) );
+
+    // the quarter turns are octahedral rotations, that the classifier finds back
+    Octahedral_Rotation rotation;
+    REQUIRE( quat_to_octahedral_rotation(&q, &rotation) );
+    constexpr Octahedral_Rotation rotation_j_3 = kiss3d::octahedral_quarter_turns<kiss3d::Axis::J, 3>();
+    for (size_t c = 0; c < 3; c++){
+        REQUIRE( rotation.source[c] == rotation_j_3.source[c] );
+        REQUIRE( rotation.negate[c] == rotation_j_3.negate[c] );
+    }
+}
@@ -0,0 +1,170 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+#include "../src/kiss_clang_3d_bvh.h"
+
+#include <cmath>
+#include <vector>
+
+// a bumpy terrain of 2 * size * size triangles over [0, size]^2, plus some floating
+// triangles above it
+static std::vector<Vec3> test_mesh(size_t size){
+    std::vector<Vec3> vertices;
+    auto height = [](size_t x, size_t y){
+        return 0.3 * std::sin(0.7 * static_cast<F_TYPE>(x)) * std::cos(0.5 * static_cast<F_TYPE>(y));
+    };
+    for (size_t x = 0; x < size; x++){
+        for (size_t y = 0; y < size; y++){
+            Vec3 const p_00 {static_cast<F_TYPE>(x), static_cast<F_TYPE>(y), height(x, y)};
+            Vec3 const p_10 {static_cast<F_TYPE>(x + 1), static_cast<F_TYPE>(y), height(x + 1, y)};
+            Vec3 const p_01 {static_cast<F_TYPE>(x), static_cast<F_TYPE>(y + 1), height(x, y + 1)};
+            Vec3 const p_11 {static_cast<F_TYPE>(x + 1), static_cast<F_TYPE>(y + 1), height(x + 1, y + 1)};
+            vertices.insert(vertices.end(), {p_00, p_10, p_11, p_00, p_11, p_01});
+        }
+    }
+    for (size_t n = 0; n < 20; n++){
+        F_TYPE x = static_cast<F_TYPE>((7 * n) % size);
+        F_TYPE y = static_cast<F_TYPE>((11 * n) % size);
+        vertices.push_back(Vec3 {x, y, 2.0});
+        vertices.push_back(Vec3 {x + 1.5, y, 2.5});
+        vertices.push_back(Vec3 {x, y + 1.5, 3.0});
+    }
+    return vertices;
+}
+
+static Ray_Hit brute_force(std::vector<Vec3> const & vertices, Vec3 const * origin, Vec3 const * direction, F_TYPE max_distance){
+    Ray_Hit best {max_distance, 0.0, 0.0, BVH_NO_HIT};
+    Ray_Hit crrt;
+    for (size_t n = 0; n < vertices.size() / 3; n++){
+        if (ray_triangle_intersect(origin, direction, &vertices[3 * n], &vertices[3 * n + 1], &vertices[3 * n + 2], best.distance, &crrt)){
+            best = crrt;
+            best.triangle = n;
+        }
+    }
+    return best;
+}
+
+TEST_CASE("ray_triangle_intersect"){
+    Vec3 const v_0 {0.0, 0.0, 0.0};
+    Vec3 const v_1 {1.0, 0.0, 0.0};
+    Vec3 const v_2 {0.0, 1.0, 0.0};
+    Vec3 const origin {0.25, 0.5, 2.0};
+    Vec3 const down {0.0, 0.0, -2.0};
+    Vec3 const up {0.0, 0.0, 1.0};
+    Vec3 const sideways {1.0, 0.0, 0.0};
+
+    Ray_Hit hit;
+    REQUIRE( ray_triangle_intersect(&origin, &down, &v_0, &v_1, &v_2, 10.0, &hit) );
+    REQUIRE( hit.distance == Approx(1.0) );
+    REQUIRE( hit.u == Approx(0.25) );
+    REQUIRE( hit.v == Approx(0.5) );
+
+    // 2 sided, but not behind the origin, nor further than max_distance
+    Vec3 const below {0.25, 0.5, -2.0};
+    REQUIRE( ray_triangle_intersect(&below, &up, &v_0, &v_1, &v_2, 10.0, &hit) );
+    REQUIRE( !ray_triangle_intersect(&origin, &up, &v_0, &v_1, &v_2, 10.0, &hit) );
+    REQUIRE( !ray_triangle_intersect(&origin, &down, &v_0, &v_1, &v_2, 0.5, &hit) );
+    // parallel, and outside
+    REQUIRE( !ray_triangle_intersect(&origin, &sideways, &v_0, &v_1, &v_2, 10.0, &hit) );
+    Vec3 const outside {0.75, 0.75, 2.0};
+    REQUIRE( !ray_triangle_intersect(&outside, &down, &v_0, &v_1, &v_2, 10.0, &hit) );
+}
+
+TEST_CASE("bvh_build and bvh_intersect, against brute force"){
+    std::vector<Vec3> const vertices = test_mesh(16);
+    size_t const nbr_triangles = vertices.size() / 3;
+    std::vector<size_t> triangle_indexes(nbr_triangles);
+    std::vector<BVH_Node> nodes(BVH_MAX_NODES(nbr_triangles));
+
+    BVH bvh;
+    REQUIRE( !bvh_build(&bvh, vertices.data(), nbr_triangles, triangle_indexes.data(), nodes.data(), nbr_triangles) );
+    REQUIRE( bvh_build(&bvh, vertices.data(), nbr_triangles, triangle_indexes.data(), nodes.data(), nodes.size()) );
+    REQUIRE( bvh.nbr_nodes > 1 );
+    REQUIRE( bvh.nbr_nodes < 2 * nbr_triangles );
+
+    // rays in all the directions, from above, from below, and from the side
+    size_t nbr_mismatches {0};
+    size_t nbr_hits {0};
+    for (size_t n = 0; n < 500; n++){
+        F_TYPE x = static_cast<F_TYPE>(n) / 500.0;
+        Vec3 const origin {16.0 * x, 16.0 * (1.0 - x), n % 3 == 0 ? 5.0 : (n % 3 == 1 ? -1.0 : 0.5)};
+        Vec3 const direction {std::cos(37.0 * x), std::sin(37.0 * x), n % 3 == 1 ? 0.8 : -0.6};
+
+        Ray_Hit hit;
+        Ray_Hit const expected = brute_force(vertices, &origin, &direction, 100.0);
+        bool is_hit = bvh_intersect(&bvh, &origin, &direction, 100.0, &hit);
+        if (is_hit != (expected.triangle != BVH_NO_HIT)){
+            nbr_mismatches++;
+        }
+        if (is_hit){
+            nbr_hits++;
+            if (F_TYPE_ABS(hit.distance - expected.distance) > 1.0e-4){
+                nbr_mismatches++;
+            }
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+    REQUIRE( nbr_hits > 100 );
+
+    // empty mesh
+    BVH empty_bvh;
+    REQUIRE( bvh_build(&empty_bvh, vertices.data(), 0, triangle_indexes.data(), nodes.data(), nodes.size()) );
+    Vec3 const origin {1.0, 1.0, 5.0};
+    Vec3 const direction {0.0, 0.0, -1.0};
+    Ray_Hit hit;
+    REQUIRE( !bvh_intersect(&empty_bvh, &origin, &direction, 100.0, &hit) );
+}
+
+TEST_CASE("bvh_intersect_batch and bvh_intersect_from_frame"){
+    std::vector<Vec3> const vertices = test_mesh(12);
+    size_t const nbr_triangles = vertices.size() / 3;
+    std::vector<size_t> triangle_indexes(nbr_triangles);
+    std::vector<BVH_Node> nodes(BVH_MAX_NODES(nbr_triangles));
+    BVH bvh;
+    REQUIRE( bvh_build(&bvh, vertices.data(), nbr_triangles, triangle_indexes.data(), nodes.data(), nodes.size()) );
+
+    // a scan pattern in the sensor frame, looking along i
+    size_t const count {203};
+    std::vector<Vec3> directions(count);
+    for (size_t n = 0; n < count; n++){
+        F_TYPE x = static_cast<F_TYPE>(n) / static_cast<F_TYPE>(count);
+        directions[n] = Vec3 {1.0, std::sin(3.0 * x) - 0.5, std::cos(5.0 * x) - 0.5};
+    }
+    Vec3_View directions_view;
+    vec3_view_of_array(&directions_view, directions.data(), count);
+
+    // the sensor above the terrain, pitched down
+    Vec3 const frame_origin {6.0, 6.0, 3.0};
+    Vec3 const pitch_axis {0.0, 1.0, 0.0};
+    Quat frame_rotation;
+    rotation_to_quat(&frame_rotation, &pitch_axis, 0.9);
+
+    std::vector<Ray_Hit> hits_from_frame(count);
+    size_t nbr_hits = bvh_intersect_from_frame(&bvh, &frame_origin, &frame_rotation, &directions_view, 100.0, hits_from_frame.data());
+    REQUIRE( nbr_hits > 50 );
+
+    // same as rotating the directions first, and as single rays
+    std::vector<Vec3> origins(count, frame_origin);
+    std::vector<Vec3> rotated(count);
+    for (size_t n = 0; n < count; n++){
+        rotate_by_quat_R(&directions[n], &frame_rotation, &rotated[n]);
+    }
+    Vec3_View origins_view;
+    Vec3_View rotated_view;
+    vec3_view_of_array(&origins_view, origins.data(), count);
+    vec3_view_of_array(&rotated_view, rotated.data(), count);
+    std::vector<Ray_Hit> hits(count);
+    REQUIRE( bvh_intersect_batch(&bvh, &origins_view, &rotated_view, 100.0, hits.data()) == nbr_hits );
+
+    size_t nbr_mismatches {0};
+    for (size_t n = 0; n < count; n++){
+        Ray_Hit single_hit;
+        bvh_intersect(&bvh, &origins[n], &rotated[n], 100.0, &single_hit);
+        if (hits[n].triangle != hits_from_frame[n].triangle || single_hit.triangle != hits[n].triangle){
+            nbr_mismatches++;
+        }
+        if (hits[n].triangle != BVH_NO_HIT && hits[n].distance != single_hit.distance){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+}
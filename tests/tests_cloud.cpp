@@ -0,0 +1,162 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+
+#include <cmath>
+#include <vector>
+
+// deterministic pseudo random cloud, spread around center
+static std::vector<Vec3> test_cloud(size_t count, Vec3 const & center){
+    std::vector<Vec3> points(count);
+    for (size_t n = 0; n < count; n++){
+        F_TYPE x = static_cast<F_TYPE>(n);
+        points[n] = Vec3 {center.i + std::sin(1.3 * x), center.j + 0.5 * std::cos(0.7 * x), center.k + 0.2 * std::sin(2.9 * x) + 0.1 * std::sin(1.3 * x)};
+    }
+    return points;
+}
+
+TEST_CASE("cloud_transform_reduce_batch, against separate passes"){
+    Vec3 const center {1.0, -2.0, 0.5};
+    std::vector<Vec3> points = test_cloud(1000, center);
+    std::vector<Vec3> transformed(points.size());
+
+    Vec3 const axis {0.3, -1.0, 2.0};
+    Quat q;
+    rotation_to_quat(&q, &axis, 1.1);
+    Vec3 const translation {5.0, 6.0, -7.0};
+
+    Vec3_View points_view;
+    Vec3_View transformed_view;
+    vec3_view_of_array(&points_view, points.data(), points.size());
+    vec3_view_of_array(&transformed_view, transformed.data(), transformed.size());
+
+    Cloud_Stats stats;
+    cloud_stats_clear(&stats);
+    cloud_transform_reduce_batch(&points_view, &q, &translation, &transformed_view, &stats);
+    REQUIRE( stats.count == points.size() );
+
+    // reference: transform, then box, mean and covariance in separate passes, in double
+    std::vector<Vec3> expected(points.size());
+    double mean[3] {0.0, 0.0, 0.0};
+    Vec3 box_min {1.0e9, 1.0e9, 1.0e9};
+    Vec3 box_max {-1.0e9, -1.0e9, -1.0e9};
+    for (size_t n = 0; n < points.size(); n++){
+        rotate_by_quat_R(&points[n], &q, &expected[n]);
+        vec3_add(&expected[n], &translation);
+        mean[0] += F_TYPE_TO_DOUBLE(expected[n].i) / static_cast<double>(points.size());
+        mean[1] += F_TYPE_TO_DOUBLE(expected[n].j) / static_cast<double>(points.size());
+        mean[2] += F_TYPE_TO_DOUBLE(expected[n].k) / static_cast<double>(points.size());
+        box_min = Vec3 {std::min(box_min.i, expected[n].i), std::min(box_min.j, expected[n].j), std::min(box_min.k, expected[n].k)};
+        box_max = Vec3 {std::max(box_max.i, expected[n].i), std::max(box_max.j, expected[n].j), std::max(box_max.k, expected[n].k)};
+    }
+    double covariance_expected[6] {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    for (size_t n = 0; n < points.size(); n++){
+        double d[3] {F_TYPE_TO_DOUBLE(expected[n].i) - mean[0], F_TYPE_TO_DOUBLE(expected[n].j) - mean[1], F_TYPE_TO_DOUBLE(expected[n].k) - mean[2]};
+        size_t position {0};
+        for (size_t row = 0; row < 3; row++){
+            for (size_t col = row; col < 3; col++){
+                covariance_expected[position++] += d[row] * d[col] / static_cast<double>(points.size());
+            }
+        }
+    }
+
+    double const tolerance = 1.0e-4;
+    size_t nbr_mismatches {0};
+    for (size_t n = 0; n < points.size(); n++){
+        if (!vec3_equal(&transformed[n], &expected[n])){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+    REQUIRE( vec3_equal(&stats.box_min, &box_min) );
+    REQUIRE( vec3_equal(&stats.box_max, &box_max) );
+    REQUIRE( F_TYPE_TO_DOUBLE(stats.mean.i) == Approx(mean[0]).margin(tolerance) );
+    REQUIRE( F_TYPE_TO_DOUBLE(stats.mean.j) == Approx(mean[1]).margin(tolerance) );
+    REQUIRE( F_TYPE_TO_DOUBLE(stats.mean.k) == Approx(mean[2]).margin(tolerance) );
+
+    F_TYPE covariance[6];
+    REQUIRE( cloud_stats_covariance(&stats, covariance) );
+    for (size_t n = 0; n < 6; n++){
+        if (std::fabs(F_TYPE_TO_DOUBLE(covariance[n]) - covariance_expected[n]) > tolerance){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+}
+
+TEST_CASE("cloud_transform_reduce_batch, merged slices and null arguments"){
+    Vec3 const center {0.0, 0.0, 0.0};
+    std::vector<Vec3> points = test_cloud(1500, center);
+    Vec3_View points_view;
+    vec3_view_of_array(&points_view, points.data(), points.size());
+
+    // stats only: no transform, no output
+    Cloud_Stats stats_whole;
+    cloud_stats_clear(&stats_whole);
+    cloud_transform_reduce_batch(&points_view, NULL, NULL, NULL, &stats_whole);
+    REQUIRE( stats_whole.count == points.size() );
+
+    // as if processed by 3 threads, merged at the end
+    Cloud_Stats stats_merged;
+    cloud_stats_clear(&stats_merged);
+    size_t const slice_size {600};
+    for (size_t first = 0; first < points.size(); first += slice_size){
+        Vec3_View slice;
+        vec3_view_slice(&points_view, first, slice_size, &slice);
+        Cloud_Stats stats_slice;
+        cloud_stats_clear(&stats_slice);
+        cloud_transform_reduce_batch(&slice, NULL, NULL, NULL, &stats_slice);
+        cloud_stats_merge(&stats_merged, &stats_slice);
+    }
+
+    REQUIRE( stats_merged.count == stats_whole.count );
+    REQUIRE( vec3_equal(&stats_merged.box_min, &stats_whole.box_min) );
+    REQUIRE( vec3_equal(&stats_merged.box_max, &stats_whole.box_max) );
+    REQUIRE( vec3_equal(&stats_merged.mean, &stats_whole.mean, 1.0e-4) );
+    size_t nbr_mismatches {0};
+    for (size_t n = 0; n < 6; n++){
+        if (F_TYPE_ABS(stats_merged.comoments[n] - stats_whole.comoments[n]) > 1.0e-2){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+
+    // empty
+    Cloud_Stats stats_empty;
+    cloud_stats_clear(&stats_empty);
+    F_TYPE covariance[6];
+    REQUIRE( !cloud_stats_covariance(&stats_empty, covariance) );
+    cloud_stats_merge(&stats_merged, &stats_empty);
+    REQUIRE( stats_merged.count == stats_whole.count );
+}
+
+TEST_CASE("cloud_transform_reduce_batch, far from the origin"){
+    // a small spread far away: the naive sums of squares would cancel in float
+    Vec3 const center {1000.0, -3000.0, 500.0};
+    std::vector<Vec3> points = test_cloud(10000, center);
+    Vec3_View points_view;
+    vec3_view_of_array(&points_view, points.data(), points.size());
+
+    Cloud_Stats stats_far;
+    cloud_stats_clear(&stats_far);
+    cloud_transform_reduce_batch(&points_view, NULL, NULL, NULL, &stats_far);
+
+    Vec3 const origin {0.0, 0.0, 0.0};
+    std::vector<Vec3> points_near = test_cloud(10000, origin);
+    vec3_view_of_array(&points_view, points_near.data(), points_near.size());
+    Cloud_Stats stats_near;
+    cloud_stats_clear(&stats_near);
+    cloud_transform_reduce_batch(&points_view, NULL, NULL, NULL, &stats_near);
+
+    F_TYPE covariance_far[6];
+    F_TYPE covariance_near[6];
+    cloud_stats_covariance(&stats_far, covariance_far);
+    cloud_stats_covariance(&stats_near, covariance_near);
+    size_t nbr_mismatches {0};
+    for (size_t n = 0; n < 6; n++){
+        // the points themselves are rounded to about 1.0e-4 in float around 3000
+        if (F_TYPE_ABS(covariance_far[n] - covariance_near[n]) > 1.0e-3){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+}
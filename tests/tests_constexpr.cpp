@@ -0,0 +1,102 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+#include "../src/kiss_clang_3d_constexpr.h"
+
+#include <cmath>
+
+// evaluated at compile time; the comparisons are to integers, as the double literals
+// are float in the float test build
+static_assert(kiss3d::cx::sqrt(4.0) == 2, "cx::sqrt of a perfect square");
+static_assert(kiss3d::cx::sqrt(0.0) == 0, "cx::sqrt of 0");
+static_assert(kiss3d::cx::cos(0.0) == 1, "cx::cos of 0");
+static_assert(kiss3d::cx::sin(0.0) == 0, "cx::sin of 0");
+
+// a table of fixed rotations, as for sensors mounting
+constexpr Vec3 axis_i {1.0, 0.0, 0.0};
+constexpr Vec3 axis_k {0.0, 0.0, 1.0};
+constexpr Vec3 axis_ijk {1.0, 2.0, 3.0};
+
+constexpr Quat mountings[] {
+    kiss3d::cx::from_axis_angle(axis_k, F_TYPE_PI / 2.0),
+    kiss3d::cx::from_axis_angle(axis_i, F_TYPE_PI),
+    kiss3d::cx::from_axis_angle(axis_ijk, 0.943),
+    kiss3d::cx::from_axis_angle(axis_ijk, -7.5),
+    kiss3d::cx::prod(kiss3d::cx::from_axis_angle(axis_k, F_TYPE_PI / 2.0), kiss3d::cx::from_axis_angle(axis_i, F_TYPE_PI)),
+};
+
+static_assert(mountings[1].r < 1.0e-6 && mountings[1].r > -1.0e-6, "rotation of pi has no real part");
+
+TEST_CASE("cx::sqrt, cx::sin, cx::cos"){
+    size_t nbr_mismatches {0};
+    double const tolerance {1.0e-6};
+
+    for (int n = -2000; n <= 2000; n++){
+        double x = static_cast<double>(n) / 100;
+
+        if (std::abs(kiss3d::cx::sin(x) - std::sin(x)) > tolerance){
+            nbr_mismatches++;
+        }
+        if (std::abs(kiss3d::cx::cos(x) - std::cos(x)) > tolerance){
+            nbr_mismatches++;
+        }
+        if (n >= 0 && std::abs(kiss3d::cx::sqrt(x) - std::sqrt(x)) > tolerance){
+            nbr_mismatches++;
+        }
+    }
+
+    REQUIRE( nbr_mismatches == 0 );
+
+    REQUIRE( kiss3d::cx::sqrt(-1.0) == Approx(0.0) );
+    REQUIRE( kiss3d::cx::sqrt(1.0e-12) == Approx(1.0e-6) );
+    REQUIRE( kiss3d::cx::sqrt(1.0e12) == Approx(1.0e6) );
+}
+
+TEST_CASE("cx::from_axis_angle against rotation_to_quat"){
+    Quat q_runtime;
+
+    rotation_to_quat(&q_runtime, &axis_k, F_TYPE_PI / 2.0);
+    REQUIRE( quat_equal(&mountings[0], &q_runtime) );
+
+    rotation_to_quat(&q_runtime, &axis_i, F_TYPE_PI);
+    REQUIRE( quat_equal(&mountings[1], &q_runtime) );
+
+    rotation_to_quat(&q_runtime, &axis_ijk, 0.943);
+    REQUIRE( quat_equal(&mountings[2], &q_runtime) );
+
+    rotation_to_quat(&q_runtime, &axis_ijk, -7.5);
+    REQUIRE( quat_equal(&mountings[3], &q_runtime) );
+
+    // null axis
+    constexpr Vec3 axis_null {0.0, 0.0, 0.0};
+    constexpr Quat q_identity = kiss3d::cx::from_axis_angle(axis_null, 0.0);
+    Quat const identity {1.0, 0.0, 0.0, 0.0};
+    REQUIRE( quat_equal(&q_identity, &identity) );
+}
+
+TEST_CASE("cx::prod, cx::conj, cx::rotate against the runtime functions"){
+    Quat q_k;
+    Quat q_i;
+    Quat q_runtime;
+    rotation_to_quat(&q_k, &axis_k, F_TYPE_PI / 2.0);
+    rotation_to_quat(&q_i, &axis_i, F_TYPE_PI);
+    quat_prod(&q_k, &q_i, &q_runtime);
+    REQUIRE( quat_equal(&mountings[4], &q_runtime) );
+
+    constexpr Quat q_conj = kiss3d::cx::conj(mountings[2]);
+    quat_copy(&mountings[2], &q_runtime);
+    quat_conj(&q_runtime);
+    REQUIRE( quat_equal(&q_conj, &q_runtime) );
+
+    constexpr Vec3 v {0.3, -1.0, 2.0};
+    constexpr Vec3 Rv = kiss3d::cx::rotate(mountings[2], v);
+    Vec3 Rv_runtime;
+    rotate_by_quat_R(&v, &mountings[2], &Rv_runtime);
+    REQUIRE( vec3_equal(&Rv, &Rv_runtime) );
+
+    constexpr Vec3 v_unit = kiss3d::cx::normalize(axis_ijk);
+    Vec3 v_unit_runtime;
+    vec3_copy(&axis_ijk, &v_unit_runtime);
+    vec3_normalize(&v_unit_runtime);
+    REQUIRE( vec3_equal(&v_unit, &v_unit_runtime) );
+    REQUIRE( kiss3d::cx::norm(axis_ijk) == Approx(vec3_norm(&axis_ijk)) );
+}
@@ -0,0 +1,154 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+#include "../src/kiss_clang_3d_euler.h"
+
+#include <vector>
+
+using kiss3d::Axis;
+
+// q and -q are the same rotation
+static bool same_rotation(Quat const * q_1, Quat const * q_2){
+    F_TYPE scalar = q_1->r * q_2->r + q_1->i * q_2->i + q_1->j * q_2->j + q_1->k * q_2->k;
+    return F_TYPE_ABS(F_TYPE_ABS(scalar) - 1.0) < 1.0e-5;
+}
+
+static Vec3 unit_axis(Axis axis){
+    return Vec3 {
+        axis == Axis::I ? F_TYPE_1 : F_TYPE_0,
+        axis == Axis::J ? F_TYPE_1 : F_TYPE_0,
+        axis == Axis::K ? F_TYPE_1 : F_TYPE_0
+    };
+}
+
+// number of failed checks for one sequence, over a grid of angles and the gimbal locks
+template <Axis first, Axis second, Axis third>
+static size_t nbr_failures_of_sequence(){
+    bool const proper_euler = (first == third);
+    Vec3 const axis_first = unit_axis(first);
+    Vec3 const axis_second = unit_axis(second);
+    Vec3 const axis_third = unit_axis(third);
+
+    std::vector<Vec3> angles_list;
+    for (int n_1 = -3; n_1 <= 3; n_1++){
+        for (int n_2 = -3; n_2 <= 3; n_2++){
+            for (int n_3 = -3; n_3 <= 3; n_3++){
+                F_TYPE second_angle = proper_euler ? 0.5 * static_cast<F_TYPE>(n_2 + 3) + 0.1 : 0.5 * static_cast<F_TYPE>(n_2);
+                angles_list.push_back(Vec3 {0.9 * static_cast<F_TYPE>(n_1), second_angle, 0.8 * static_cast<F_TYPE>(n_3)});
+            }
+        }
+    }
+    // gimbal locks
+    F_TYPE const lock_low = proper_euler ? F_TYPE_0 : -F_TYPE_PI / 2.0;
+    F_TYPE const lock_high = proper_euler ? F_TYPE_PI : F_TYPE_PI / 2.0;
+    angles_list.push_back(Vec3 {0.3, lock_low, 0.5});
+    angles_list.push_back(Vec3 {0.3, lock_high, 0.5});
+    angles_list.push_back(Vec3 {-1.0, lock_high, 2.5});
+
+    size_t nbr_failures {0};
+    size_t nbr_gimbal_locks {0};
+
+    for (Vec3 const & angles : angles_list){
+        // same as the product of the 3 rotations
+        Quat q_first;
+        Quat q_second;
+        Quat q_third;
+        Quat q_first_second;
+        Quat q_expected;
+        rotation_to_quat(&q_first, &axis_first, angles.i);
+        rotation_to_quat(&q_second, &axis_second, angles.j);
+        rotation_to_quat(&q_third, &axis_third, angles.k);
+        quat_prod(&q_first, &q_second, &q_first_second);
+        quat_prod(&q_first_second, &q_third, &q_expected);
+
+        Quat const q = kiss3d::euler_to_quat<first, second, third>(angles);
+        if (!quat_equal(&q, &q_expected)){
+            nbr_failures++;
+        }
+
+        // back to angles: the same rotation, and angles in their ranges
+        bool gimbal_lock;
+        Vec3 const angles_back = kiss3d::quat_to_euler<first, second, third>(q, &gimbal_lock);
+        Quat const q_back = kiss3d::euler_to_quat<first, second, third>(angles_back);
+        if (!same_rotation(&q_back, &q)){
+            nbr_failures++;
+        }
+        if (angles_back.j < lock_low - 1.0e-5 || angles_back.j > lock_high + 1.0e-5){
+            nbr_failures++;
+        }
+        if (gimbal_lock){
+            nbr_gimbal_locks++;
+            if (angles_back.i != 0){
+                nbr_failures++;
+            }
+        }
+    }
+
+    if (nbr_gimbal_locks != 3){
+        nbr_failures++;
+    }
+
+    return nbr_failures;
+}
+
+TEST_CASE("euler_to_quat and quat_to_euler, all the sequences"){
+    // Tait-Bryan
+    REQUIRE( nbr_failures_of_sequence<Axis::I, Axis::J, Axis::K>() == 0 );
+    REQUIRE( nbr_failures_of_sequence<Axis::I, Axis::K, Axis::J>() == 0 );
+    REQUIRE( nbr_failures_of_sequence<Axis::J, Axis::I, Axis::K>() == 0 );
+    REQUIRE( nbr_failures_of_sequence<Axis::J, Axis::K, Axis::I>() == 0 );
+    REQUIRE( nbr_failures_of_sequence<Axis::K, Axis::I, Axis::J>() == 0 );
+    REQUIRE( nbr_failures_of_sequence<Axis::K, Axis::J, Axis::I>() == 0 );
+
+    // proper Euler
+    REQUIRE( nbr_failures_of_sequence<Axis::I, Axis::J, Axis::I>() == 0 );
+    REQUIRE( nbr_failures_of_sequence<Axis::I, Axis::K, Axis::I>() == 0 );
+    REQUIRE( nbr_failures_of_sequence<Axis::J, Axis::I, Axis::J>() == 0 );
+    REQUIRE( nbr_failures_of_sequence<Axis::J, Axis::K, Axis::J>() == 0 );
+    REQUIRE( nbr_failures_of_sequence<Axis::K, Axis::I, Axis::K>() == 0 );
+    REQUIRE( nbr_failures_of_sequence<Axis::K, Axis::J, Axis::K>() == 0 );
+}
+
+TEST_CASE("quat_to_euler, yaw pitch roll"){
+    // yaw of pi / 2, pitch of 0.1, roll of -0.2; back to exactly the same angles
+    Vec3 const yaw_pitch_roll {F_TYPE_PI / 2.0, 0.1, -0.2};
+    Quat const q = kiss3d::euler_to_quat<Axis::K, Axis::J, Axis::I>(yaw_pitch_roll);
+    Vec3 const angles_back = kiss3d::quat_to_euler<Axis::K, Axis::J, Axis::I>(q);
+    REQUIRE( vec3_equal(&angles_back, &yaw_pitch_roll, 1.0e-5) );
+}
+
+TEST_CASE("euler_to_quat_batch and quat_to_euler_batch"){
+    // roll, pitch, yaw stored as float triplets
+    float angles[4][3] {
+        {0.1f, 0.2f, 0.3f},
+        {-1.0f, 0.5f, 2.0f},
+        {0.0f, 1.5707963267948966f, 0.4f},
+        {3.0f, -0.3f, -2.5f}
+    };
+    Vec3_View angles_view;
+    vec3_view_setter(&angles_view, angles, 3 * sizeof(float), 4, 0, sizeof(float), 2 * sizeof(float), 'F');
+
+    Quat quats[4];
+    Quat_View q_view;
+    quat_view_of_array(&q_view, quats, 4);
+
+    kiss3d::euler_to_quat_batch<Axis::I, Axis::J, Axis::K>(&angles_view, &q_view);
+
+    Vec3 crrt;
+    for (size_t n = 0; n < 4; n++){
+        vec3_view_get(&angles_view, n, &crrt);
+        Quat const q_expected = kiss3d::euler_to_quat<Axis::I, Axis::J, Axis::K>(crrt);
+        REQUIRE( quat_equal(&quats[n], &q_expected) );
+    }
+
+    Vec3 angles_back[4];
+    Vec3_View angles_back_view;
+    vec3_view_of_array(&angles_back_view, angles_back, 4);
+
+    // element 2 is at the gimbal lock (pitch of pi / 2); float storage, so a larger tolerance
+    REQUIRE( kiss3d::quat_to_euler_batch<Axis::I, Axis::J, Axis::K>(&q_view, &angles_back_view, 1.0e-3) == 1 );
+
+    for (size_t n = 0; n < 4; n++){
+        Quat const q_back = kiss3d::euler_to_quat<Axis::I, Axis::J, Axis::K>(angles_back[n]);
+        REQUIRE( same_rotation(&q_back, &quats[n]) );
+    }
+}
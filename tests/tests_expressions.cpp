@@ -0,0 +1,207 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+#include "../src/kiss_clang_3d_expressions.h"
+
+#include <vector>
+
+// a quaternion array that counts how many times its elements are evaluated
+struct counted_quat_array : kiss3d::quat_expr<counted_quat_array> {
+    Quat const * data;
+    size_t * nbr_evaluations;
+
+    counted_quat_array(Quat const * data_in, size_t * nbr_evaluations_in) : data(data_in), nbr_evaluations(nbr_evaluations_in) {}
+
+    Quat at(size_t n) const {
+        (*nbr_evaluations)++;
+        return data[n];
+    }
+};
+
+TEST_CASE("kiss3d vec3 expressions"){
+    kiss3d::vec3 const a {1.0, 2.0, 3.0};
+    kiss3d::vec3 const b {0.0, 1.0, 0.0};
+    kiss3d::vec3 const c {0.0, 0.0, 1.0};
+    kiss3d::vec3 const d {0.5, 0.5, 0.5};
+    F_TYPE const s {2.0};
+
+    // a * s + cross(b, c) - d, by hand with the C API
+    Vec3 expected;
+    Vec3 cross_b_c;
+    vec3_copy(&a.data, &expected);
+    vec3_scale(&expected, s);
+    vec3_cross(&b.data, &c.data, &cross_b_c);
+    vec3_add(&expected, &cross_b_c);
+    vec3_sub(&expected, &d.data);
+
+    kiss3d::vec3 result = a * s + kiss3d::cross(b, c) - d;
+    REQUIRE( vec3_equal(&result.data, &expected) );
+
+    // other operators
+    kiss3d::vec3 negated = -a / 2.0;
+    Vec3 const negated_res {-0.5, -1.0, -1.5};
+    REQUIRE( vec3_equal(&negated.data, &negated_res) );
+
+    REQUIRE( kiss3d::dot(a, a).value(0) == Approx(14.0) );
+
+    kiss3d::vec3 projected = kiss3d::dot(a, b) * b;
+    Vec3 const projected_res {0.0, 2.0, 0.0};
+    REQUIRE( vec3_equal(&projected.data, &projected_res) );
+
+    // the expression can use the vector it is assigned to
+    result = kiss3d::cross(result, b);
+    Vec3 cross_res;
+    vec3_cross(&expected, &b.data, &cross_res);
+    REQUIRE( vec3_equal(&result.data, &cross_res) );
+}
+
+TEST_CASE("kiss3d quat expressions"){
+    kiss3d::quat const q_i {0.0, 1.0, 0.0, 0.0};
+    kiss3d::quat const q_j {0.0, 0.0, 1.0, 0.0};
+    kiss3d::quat const q_a {1.0, 2.0, 3.0, 4.0};
+
+    kiss3d::quat result = q_i * q_j;
+    Quat const q_k {0.0, 0.0, 0.0, 1.0};
+    REQUIRE( quat_equal(&result.data, &q_k) );
+
+    // (q_a + q_i) * conj(q_a) * 0.5, by hand with the C API
+    Quat expected;
+    Quat q_sum;
+    Quat q_conj;
+    quat_copy(&q_a.data, &q_sum);
+    quat_add(&q_sum, &q_i.data);
+    quat_copy(&q_a.data, &q_conj);
+    quat_conj(&q_conj);
+    quat_prod(&q_sum, &q_conj, &expected);
+    quat_setter(&expected, 0.5 * expected.r, 0.5 * expected.i, 0.5 * expected.j, 0.5 * expected.k);
+
+    result = (q_a + q_i) * kiss3d::conj(q_a) * 0.5;
+    REQUIRE( quat_equal(&result.data, &expected) );
+
+    result = q_a - q_a;
+    Quat const q_zero {0.0, 0.0, 0.0, 0.0};
+    REQUIRE( quat_equal(&result.data, &q_zero) );
+}
+
+TEST_CASE("kiss3d rotate"){
+    Vec3 const axis {1.0, 2.0, 3.0};
+    kiss3d::quat q;
+    rotation_to_quat(&q.data, &axis, 0.943);
+
+    kiss3d::vec3 const v {0.3, -1.0, 2.0};
+    kiss3d::vec3 Rv = kiss3d::rotate(q, v);
+
+    Vec3 expected;
+    rotate_by_quat_R(&v.data, &q.data, &expected);
+    REQUIRE( vec3_equal(&Rv.data, &expected) );
+}
+
+TEST_CASE("kiss3d array expressions"){
+    size_t const count {100};
+    std::vector<Vec3> a_data(count);
+    std::vector<Vec3> b_data(count);
+    std::vector<Vec3> out_data(count);
+    std::vector<Quat> q_data(count);
+
+    Vec3 const axis {0.0, 0.0, 1.0};
+    for (size_t n = 0; n < count; n++){
+        F_TYPE x = static_cast<F_TYPE>(n);
+        vec3_setter(&a_data[n], x, 1.0, -x);
+        vec3_setter(&b_data[n], 1.0, x, 2.0);
+        rotation_to_quat(&q_data[n], &axis, 0.01 * x);
+    }
+
+    kiss3d::vec3_array a(a_data.data(), count);
+    kiss3d::vec3_array b(b_data.data(), count);
+    kiss3d::vec3_array out(out_data.data(), count);
+    kiss3d::quat_array q(q_data.data(), count);
+    kiss3d::vec3 const d {0.5, 0.5, 0.5};
+    F_TYPE const s {3.0};
+
+    // one loop, compared with the C API element by element
+    out = a * s + kiss3d::cross(a, b) - d;
+
+    size_t nbr_mismatches {0};
+    for (size_t n = 0; n < count; n++){
+        Vec3 expected;
+        Vec3 cross_a_b;
+        vec3_copy(&a_data[n], &expected);
+        vec3_scale(&expected, s);
+        vec3_cross(&a_data[n], &b_data[n], &cross_a_b);
+        vec3_add(&expected, &cross_a_b);
+        vec3_sub(&expected, &d.data);
+        if (!vec3_equal(&out_data[n], &expected, 1.0e-3)){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+
+    // element wise rotations, in place
+    out = kiss3d::rotate(q, b);
+    out = kiss3d::dot(out, out) * out;
+
+    for (size_t n = 0; n < count; n++){
+        Vec3 expected;
+        rotate_by_quat_R(&b_data[n], &q_data[n], &expected);
+        vec3_scale(&expected, vec3_norm_square(&expected));
+        if (!vec3_equal(&out_data[n], &expected, 1.0e-2)){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+
+    // assigning an array to an array copies the elements
+    out = a;
+    REQUIRE( out.data == out_data.data() );
+    REQUIRE( vec3_equal(&out_data[10], &a_data[10]) );
+
+    // quaternion arrays
+    std::vector<Quat> q_out_data(count);
+    kiss3d::quat_array q_out(q_out_data.data(), count);
+    q_out = q * kiss3d::conj(q);
+
+    Quat const identity {1.0, 0.0, 0.0, 0.0};
+    for (size_t n = 0; n < count; n++){
+        if (!quat_equal(&q_out_data[n], &identity)){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+}
+
+TEST_CASE("kiss3d nested expressions evaluate each node once per element"){
+    size_t const count {50};
+    std::vector<Quat> qa_data(count);
+    std::vector<Vec3> v_data(count);
+    std::vector<Vec3> out_data(count);
+
+    Vec3 const axis {1.0, 2.0, 3.0};
+    for (size_t n = 0; n < count; n++){
+        F_TYPE x = static_cast<F_TYPE>(n);
+        rotation_to_quat(&qa_data[n], &axis, 0.03 * x);
+        vec3_setter(&v_data[n], 1.0, -x, 0.5);
+    }
+
+    size_t nbr_evaluations {0};
+    counted_quat_array qa(qa_data.data(), &nbr_evaluations);
+    kiss3d::quat const qb {0.0, 1.0, 0.0, 0.0};
+    kiss3d::quat const qc {0.0, 0.0, 0.0, 1.0};
+    kiss3d::vec3_array v(v_data.data(), count);
+    kiss3d::vec3_array out(out_data.data(), count);
+
+    out = kiss3d::rotate(qa * qb * qc, v);
+    REQUIRE( nbr_evaluations == count );
+
+    size_t nbr_mismatches {0};
+    for (size_t n = 0; n < count; n++){
+        Quat q_ab;
+        Quat q_abc;
+        Vec3 expected;
+        quat_prod(&qa_data[n], &qb.data, &q_ab);
+        quat_prod(&q_ab, &qc.data, &q_abc);
+        rotate_by_quat_R(&v_data[n], &q_abc, &expected);
+        if (!vec3_equal(&out_data[n], &expected, 1.0e-3)){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+}
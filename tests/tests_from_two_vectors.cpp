@@ -0,0 +1,133 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+
+#include <cmath>
+#include <vector>
+
+// the quaternion must be a unit quaternion, and bring the direction of v_from on the one of v_to
+static bool aligns(Quat const * q, Vec3 const * v_from, Vec3 const * v_to){
+    Vec3 Rv;
+    rotate_by_quat_R(v_from, q, &Rv);
+    return quat_is_unitary(q) && vec3_colinear(&Rv, v_to, 1.0e-4) && vec3_scalar(&Rv, v_to) > 0;
+}
+
+TEST_CASE("quat_from_two_vectors"){
+    Quat q;
+
+    // same as rotation_to_quat with the angle between the vectors, around their cross product
+    Vec3 const v_i {1.0, 0.0, 0.0};
+    Vec3 const v_j {0.0, 2.0, 0.0};
+    Vec3 const axis_k {0.0, 0.0, 1.0};
+    Quat q_expected;
+    REQUIRE( quat_from_two_vectors(&v_i, &v_j, &q) );
+    rotation_to_quat(&q_expected, &axis_k, F_TYPE_PI / 2.0);
+    REQUIRE( quat_equal(&q, &q_expected) );
+
+    Vec3 const v_from {1.0, 2.0, 3.0};
+    Vec3 const v_to {-0.5, 0.3, 0.1};
+    REQUIRE( quat_from_two_vectors(&v_from, &v_to, &q) );
+    REQUIRE( aligns(&q, &v_from, &v_to) );
+    Vec3 axis;
+    vec3_cross(&v_from, &v_to, &axis);
+    rotation_to_quat(&q_expected, &axis, vec3_angle(&v_from, &v_to));
+    REQUIRE( quat_equal(&q, &q_expected) );
+
+    // colinear vectors, same direction: the identity
+    Vec3 const v_from_scaled {2.0, 4.0, 6.0};
+    Quat const identity {1.0, 0.0, 0.0, 0.0};
+    REQUIRE( vec3_colinear(&v_from, &v_from_scaled) );
+    REQUIRE( quat_from_two_vectors(&v_from, &v_from_scaled, &q) );
+    REQUIRE( quat_equal(&q, &identity) );
+
+    // colinear vectors, opposite directions: a rotation of pi around an orthogonal axis
+    Vec3 const opposites[4] {
+        {-1.0, -2.0, -3.0},
+        {-1.0, 0.0, 0.0},
+        {0.0, 0.0, -5.0},
+        {0.0, -1.0, 1.0e-3}
+    };
+    Vec3 const opposites_from[4] {
+        {1.0, 2.0, 3.0},
+        {1.0, 0.0, 0.0},
+        {0.0, 0.0, 1.0},
+        {0.0, 1.0, -1.0e-3}
+    };
+    for (size_t n = 0; n < 4; n++){
+        REQUIRE( vec3_colinear(&opposites_from[n], &opposites[n]) );
+        REQUIRE( quat_from_two_vectors(&opposites_from[n], &opposites[n], &q) );
+        REQUIRE( q.r == Approx(0.0).margin(1.0e-6) );
+        REQUIRE( aligns(&q, &opposites_from[n], &opposites[n]) );
+    }
+
+    // opposite vectors along generic directions, where the sum of the norms product and
+    // the scalar product does not cancel exactly
+    size_t const nbr_directions {2000};
+    F_TYPE const opposite_scale {-0.3};
+    size_t nbr_opposite_mismatches {0};
+    for (size_t n = 0; n < nbr_directions; n++){
+        double const x {static_cast<double>(n)};
+        double const a {0.7};
+        double const b {1.3};
+        double const c {2.9};
+        double const radius {4.0};
+        Vec3 const v_dir {
+            F_TYPE_FROM_DOUBLE(radius * std::sin(a * x)),
+            F_TYPE_FROM_DOUBLE(radius * std::cos(b * x)),
+            F_TYPE_FROM_DOUBLE(std::sin(c * x))
+        };
+        Vec3 v_opposite;
+        vec3_copy(&v_dir, &v_opposite);
+        vec3_scale(&v_opposite, opposite_scale);
+
+        if (!quat_from_two_vectors(&v_dir, &v_opposite, &q) || !aligns(&q, &v_dir, &v_opposite)){
+            nbr_opposite_mismatches++;
+        }
+    }
+    REQUIRE( nbr_opposite_mismatches == 0 );
+
+    // almost opposite
+    Vec3 const v_almost {-1.0, 1.0e-7, 0.0};
+    REQUIRE( quat_from_two_vectors(&v_i, &v_almost, &q) );
+    REQUIRE( aligns(&q, &v_i, &v_almost) );
+
+    // null vectors
+    Vec3 const v_null {0.0, 0.0, 0.0};
+    REQUIRE( !quat_from_two_vectors(&v_null, &v_i, &q) );
+    REQUIRE( !quat_from_two_vectors(&v_i, &v_null, &q) );
+}
+
+TEST_CASE("quat_from_two_vectors_batch"){
+    size_t const count {100};
+    std::vector<Vec3> vectors_from(count);
+    std::vector<Vec3> vectors_to(count);
+    std::vector<Quat> quats(count);
+
+    for (size_t n = 0; n < count; n++){
+        F_TYPE x = static_cast<F_TYPE>(n) / static_cast<F_TYPE>(count);
+        vec3_setter(&vectors_from[n], 1.0 - x, x, 0.5);
+        vec3_setter(&vectors_to[n], -x, 2.0 * x - 1.0, 0.3);
+    }
+    // a null vector, and opposite vectors
+    vec3_setter(&vectors_from[10], 0.0, 0.0, 0.0);
+    vec3_setter(&vectors_to[20], -vectors_from[20].i, -vectors_from[20].j, -vectors_from[20].k);
+
+    Vec3_View from_view;
+    Vec3_View to_view;
+    Quat_View q_view;
+    vec3_view_of_array(&from_view, vectors_from.data(), count);
+    vec3_view_of_array(&to_view, vectors_to.data(), count);
+    quat_view_of_array(&q_view, quats.data(), count);
+
+    REQUIRE( quat_from_two_vectors_batch(&from_view, &to_view, &q_view) == count - 1 );
+
+    size_t nbr_mismatches {0};
+    for (size_t n = 0; n < count; n++){
+        if (n != 10 && !aligns(&quats[n], &vectors_from[n], &vectors_to[n])){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+
+    Quat const identity {1.0, 0.0, 0.0, 0.0};
+    REQUIRE( quat_equal(&quats[10], &identity) );
+}
@@ -0,0 +1,182 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+TEST_CASE("float_to_half and half_to_float"){
+    REQUIRE( float_to_half(0.0f) == 0x0000 );
+    REQUIRE( float_to_half(-0.0f) == 0x8000 );
+    REQUIRE( float_to_half(1.0f) == 0x3C00 );
+    REQUIRE( float_to_half(-2.0f) == 0xC000 );
+    REQUIRE( float_to_half(0.5f) == 0x3800 );
+    REQUIRE( float_to_half(65504.0f) == 0x7BFF );
+
+    // overflow to infinity, infinities and NaNs
+    REQUIRE( float_to_half(65520.0f) == 0x7C00 );
+    REQUIRE( float_to_half(std::numeric_limits<float>::infinity()) == 0x7C00 );
+    REQUIRE( float_to_half(-std::numeric_limits<float>::infinity()) == 0xFC00 );
+    REQUIRE( std::isnan(half_to_float(float_to_half(std::numeric_limits<float>::quiet_NaN()))) );
+
+    // subnormals: smallest half subnormal is 2^-24
+    REQUIRE( float_to_half(5.9604644775390625e-8f) == 0x0001 );
+    REQUIRE( half_to_float(0x0001) == 5.9604644775390625e-8f );
+    REQUIRE( float_to_half(1.0e-10f) == 0x0000 );
+
+    // round to nearest even: 1 + 2^-11 is halfway between 1 and 1 + 2^-10
+    REQUIRE( float_to_half(1.00048828125f) == 0x3C00 );
+    REQUIRE( float_to_half(1.00146484375f) == 0x3C02 );
+
+    // all the non NaN half values survive a round trip through float
+    size_t nbr_mismatches {0};
+    for (uint32_t bits = 0; bits <= 0xFFFF; bits++){
+        uint16_t half = static_cast<uint16_t>(bits);
+        if ((half & 0x7C00) == 0x7C00 && (half & 0x03FF) != 0){
+            continue;
+        }
+        if (float_to_half(half_to_float(half)) != half){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+}
+
+TEST_CASE("float_to_bf16 and bf16_to_float"){
+    REQUIRE( float_to_bf16(0.0f) == 0x0000 );
+    REQUIRE( float_to_bf16(1.0f) == 0x3F80 );
+    REQUIRE( float_to_bf16(-2.0f) == 0xC000 );
+    REQUIRE( bf16_to_float(0x3F80) == 1.0f );
+
+    // round to nearest even
+    REQUIRE( float_to_bf16(1.00390625f) == 0x3F80 );
+    REQUIRE( float_to_bf16(1.01171875f) == 0x3F82 );
+    REQUIRE( float_to_bf16(1.0078125f) == 0x3F81 );
+
+    REQUIRE( std::isnan(bf16_to_float(float_to_bf16(std::numeric_limits<float>::quiet_NaN()))) );
+    REQUIRE( float_to_bf16(std::numeric_limits<float>::infinity()) == 0x7F80 );
+}
+
+TEST_CASE("half and bf16 array conversions"){
+    // more than 8 values, so that the F16C path (if any) and the remainder are both used
+    std::vector<float> values_in {
+        0.0f, 1.0f, -1.0f, 0.5f, 0.1f, 0.2f, 0.3f, 1000.0f, 1.0e-6f, -3.5f, 2.0e4f, 0.7071067811865476f, 7.0f
+    };
+    std::vector<uint16_t> packed(values_in.size());
+    std::vector<float> values_out(values_in.size());
+
+    float_array_to_half(values_in.data(), packed.data(), values_in.size());
+    for (size_t n = 0; n < values_in.size(); n++){
+        REQUIRE( packed[n] == float_to_half(values_in[n]) );
+    }
+
+    half_array_to_float(packed.data(), values_out.data(), packed.size());
+    for (size_t n = 0; n < values_in.size(); n++){
+        REQUIRE( values_out[n] == half_to_float(packed[n]) );
+    }
+
+    float_array_to_bf16(values_in.data(), packed.data(), values_in.size());
+    for (size_t n = 0; n < values_in.size(); n++){
+        REQUIRE( packed[n] == float_to_bf16(values_in[n]) );
+    }
+
+    bf16_array_to_float(packed.data(), values_out.data(), packed.size());
+    for (size_t n = 0; n < values_in.size(); n++){
+        REQUIRE( values_out[n] == bf16_to_float(packed[n]) );
+    }
+}
+
+TEST_CASE("vec3_copy_batch and rotate_by_quat_R_batch on packed vectors"){
+    Vec3 normals[3] {
+        {1.0, 0.0, 0.0},
+        {0.0, 1.0, 0.0},
+        {0.2672612419124244, 0.5345224838248488, 0.8017837257372732}
+    };
+    Vec3_Half normals_half[3];
+    Vec3_BF16 normals_bf16[3];
+
+    Vec3_View view;
+    Vec3_View view_half;
+    Vec3_View view_bf16;
+    vec3_view_of_array(&view, normals, 3);
+    vec3_view_of_half_array(&view_half, normals_half, 3);
+    vec3_view_of_bf16_array(&view_bf16, normals_bf16, 3);
+
+    vec3_copy_batch(&view, &view_half);
+    vec3_copy_batch(&view, &view_bf16);
+
+    REQUIRE( normals_half[0].i == 0x3C00 );
+    REQUIRE( normals_bf16[1].j == 0x3F80 );
+
+    // rotate in place, in packed storage, and compare with the rotation in F_TYPE
+    F_TYPE sqrt_2_o_2 {0.7071067811865476};
+    Quat const quat_rot_k {sqrt_2_o_2, 0.0, 0.0, sqrt_2_o_2};
+
+    rotate_by_quat_R_batch(&view_half, &quat_rot_k, &view_half);
+    rotate_by_quat_R_batch(&view_bf16, &quat_rot_k, &view_bf16);
+
+    Vec3 expected;
+    Vec3 v_res;
+    for (size_t n = 0; n < 3; n++){
+        rotate_by_quat_R(&normals[n], &quat_rot_k, &expected);
+
+        // half: 11 bits of mantissa
+        vec3_view_get(&view_half, n, &v_res);
+        REQUIRE( vec3_equal(&v_res, &expected, 1.0e-3) );
+
+        // bfloat16: 8 bits of mantissa
+        vec3_view_get(&view_bf16, n, &v_res);
+        REQUIRE( vec3_equal(&v_res, &expected, 1.0e-2) );
+    }
+}
+
+TEST_CASE("rotate_by_quat_R_batch on packed half vectors rounds once, in blocks"){
+    // more vectors than a block of the conversions, and a rotation that is not octahedral
+    size_t const nbr_vectors {1000};
+    std::vector<Vec3_Half> vectors_half(nbr_vectors);
+    std::vector<Vec3_Half> rotated_half(nbr_vectors);
+
+    for (size_t n = 0; n < nbr_vectors; n++){
+        float const x {KISS_CAST(float, n)};
+        vectors_half[n].i = float_to_half(std::sin(0.37f * x));
+        vectors_half[n].j = float_to_half(std::cos(0.71f * x));
+        vectors_half[n].k = float_to_half(0.5f * std::sin(1.3f * x));
+    }
+
+    Vec3_View view_in;
+    Vec3_View view_out;
+    vec3_view_of_half_array(&view_in, vectors_half.data(), nbr_vectors);
+    vec3_view_of_half_array(&view_out, rotated_half.data(), nbr_vectors);
+
+    Quat q;
+    Vec3 const axis {1.0, 2.0, 3.0};
+    F_TYPE angle {0.5};
+    rotation_to_quat(&q, &axis, angle);
+    Quat_f const q_float {F_TYPE_TO_FLOAT(q.r), F_TYPE_TO_FLOAT(q.i), F_TYPE_TO_FLOAT(q.j), F_TYPE_TO_FLOAT(q.k)};
+
+    rotate_by_quat_R_batch(&view_in, &q, &view_out);
+
+    // each component is the float rotation of the half inputs, rounded once to half
+    size_t nbr_mismatches {0};
+    for (size_t n = 0; n < nbr_vectors; n++){
+        Vec3_f const crrt_in {
+            half_to_float(vectors_half[n].i),
+            half_to_float(vectors_half[n].j),
+            half_to_float(vectors_half[n].k)
+        };
+        Vec3_f expected;
+        rotate_by_quat_R_f(&crrt_in, &q_float, &expected);
+
+        if (rotated_half[n].i != float_to_half(expected.i) ||
+            rotated_half[n].j != float_to_half(expected.j) ||
+            rotated_half[n].k != float_to_half(expected.k)){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+
+    // in place gives the same result
+    rotate_by_quat_R_batch(&view_in, &q, &view_in);
+    REQUIRE( std::memcmp(vectors_half.data(), rotated_half.data(), nbr_vectors * sizeof(Vec3_Half)) == 0 );
+}
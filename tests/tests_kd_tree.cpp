@@ -0,0 +1,165 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+#include "../src/kiss_clang_3d_kd_tree.h"
+
+#include <algorithm>
+#include <vector>
+
+// deterministic pseudo random coordinates in [-1, 1)
+static F_TYPE next_coordinate(uint32_t * state){
+    *state = *state * 1664525u + 1013904223u;
+    return static_cast<F_TYPE>(*state >> 8) / static_cast<F_TYPE>(1u << 23) - 1.0;
+}
+
+static std::vector<Vec3> random_points(size_t count, uint32_t seed, bool planar){
+    std::vector<Vec3> points(count);
+    for (Vec3 & point : points){
+        point.i = next_coordinate(&seed);
+        point.j = next_coordinate(&seed);
+        point.k = planar ? 0.0 : next_coordinate(&seed);
+    }
+    return points;
+}
+
+static std::vector<F_TYPE> brute_force_dist_squares(std::vector<Vec3> const & points, Vec3 const * query){
+    std::vector<F_TYPE> dist_squares;
+    for (Vec3 const & point : points){
+        Vec3 diff {point.i - query->i, point.j - query->j, point.k - query->k};
+        dist_squares.push_back(vec3_norm_square(&diff));
+    }
+    std::sort(dist_squares.begin(), dist_squares.end());
+    return dist_squares;
+}
+
+TEST_CASE("kd_tree_build"){
+    std::vector<Vec3> points = random_points(1000, 1, false);
+    std::vector<Vec3> const points_before = points;
+    std::vector<size_t> original_indexes(points.size());
+
+    KD_Tree tree;
+    REQUIRE( kd_tree_build(&tree, points.data(), points.size(), original_indexes.data()) );
+    REQUIRE( tree.count == 1000 );
+    REQUIRE( !kd_tree_build(&tree, NULL, 10) );
+
+    // only a permutation of the points
+    size_t nbr_mismatches {0};
+    for (size_t n = 0; n < points.size(); n++){
+        if (!vec3_equal(&points[n], &points_before[original_indexes[n]], 0.0)){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+}
+
+TEST_CASE("kd_tree_nearest and kd_tree_radius, against brute force"){
+    for (bool planar : {false, true}){
+        std::vector<Vec3> points = random_points(2000, 2, planar);
+        // some duplicates
+        for (size_t n = 0; n < 100; n++){
+            points.push_back(points[n]);
+        }
+        std::vector<Vec3> const points_before = points;
+
+        KD_Tree tree;
+        REQUIRE( kd_tree_build(&tree, points.data(), points.size()) );
+
+        std::vector<Vec3> queries = random_points(200, 3, false);
+        size_t const k {7};
+        F_TYPE const radius {0.15};
+        size_t nbr_mismatches {0};
+
+        for (Vec3 const & query : queries){
+            std::vector<F_TYPE> const expected = brute_force_dist_squares(points_before, &query);
+
+            size_t indexes[k];
+            F_TYPE dist_squares[k];
+            if (kd_tree_nearest(&tree, &query, k, indexes, dist_squares) != k){
+                nbr_mismatches++;
+            }
+            for (size_t n = 0; n < k; n++){
+                Vec3 diff {points[indexes[n]].i - query.i, points[indexes[n]].j - query.j, points[indexes[n]].k - query.k};
+                if (dist_squares[n] != expected[n] || vec3_norm_square(&diff) != dist_squares[n]){
+                    nbr_mismatches++;
+                }
+            }
+
+            size_t expected_within = static_cast<size_t>(std::upper_bound(expected.begin(), expected.end(), radius * radius) - expected.begin());
+            std::vector<size_t> within(points.size());
+            if (kd_tree_radius(&tree, &query, radius, within.data(), within.size()) != expected_within){
+                nbr_mismatches++;
+            }
+        }
+        REQUIRE( nbr_mismatches == 0 );
+    }
+}
+
+TEST_CASE("kd_tree_nearest, less points than k, and truncated radius output"){
+    std::vector<Vec3> points = random_points(3, 4, false);
+    KD_Tree tree;
+    REQUIRE( kd_tree_build(&tree, points.data(), points.size()) );
+
+    Vec3 const query {0.0, 0.0, 0.0};
+    size_t indexes[5];
+    F_TYPE dist_squares[5];
+    REQUIRE( kd_tree_nearest(&tree, &query, 5, indexes, dist_squares) == 3 );
+    REQUIRE( indexes[3] == KD_TREE_NOT_FOUND );
+    REQUIRE( indexes[4] == KD_TREE_NOT_FOUND );
+    REQUIRE( dist_squares[0] <= dist_squares[1] );
+    REQUIRE( dist_squares[1] <= dist_squares[2] );
+
+    // all the points are within 2 of the origin
+    size_t within[2];
+    REQUIRE( kd_tree_radius(&tree, &query, 2.0, within, 2) == 3 );
+
+    KD_Tree empty_tree;
+    REQUIRE( kd_tree_build(&empty_tree, points.data(), 0) );
+    REQUIRE( kd_tree_nearest(&empty_tree, &query, 5, indexes, dist_squares) == 0 );
+    REQUIRE( kd_tree_radius(&empty_tree, &query, 2.0, within, 2) == 0 );
+}
+
+TEST_CASE("kd_tree_nearest_batch and kd_tree_radius_batch"){
+    std::vector<Vec3> points = random_points(500, 5, false);
+    KD_Tree tree;
+    REQUIRE( kd_tree_build(&tree, points.data(), points.size()) );
+
+    std::vector<Vec3> queries = random_points(50, 6, false);
+    Vec3_View queries_view;
+    vec3_view_of_array(&queries_view, queries.data(), queries.size());
+
+    size_t const k {3};
+    std::vector<size_t> indexes(queries.size() * k);
+    std::vector<F_TYPE> dist_squares(queries.size() * k);
+    REQUIRE( kd_tree_nearest_batch(&tree, &queries_view, k, indexes.data(), dist_squares.data()) == queries.size() );
+
+    F_TYPE const radius {0.3};
+    std::vector<size_t> counts(queries.size());
+    std::vector<size_t> within(points.size() * queries.size());
+    size_t total = kd_tree_radius_batch(&tree, &queries_view, radius, counts.data(), within.data(), within.size());
+
+    size_t nbr_mismatches {0};
+    size_t sum_counts {0};
+    for (size_t n = 0; n < queries.size(); n++){
+        size_t single_indexes[k];
+        F_TYPE single_dist_squares[k];
+        kd_tree_nearest(&tree, &queries[n], k, single_indexes, single_dist_squares);
+        for (size_t m = 0; m < k; m++){
+            if (indexes[n * k + m] != single_indexes[m] || dist_squares[n * k + m] != single_dist_squares[m]){
+                nbr_mismatches++;
+            }
+        }
+
+        if (counts[n] != kd_tree_radius(&tree, &queries[n], radius, NULL, 0)){
+            nbr_mismatches++;
+        }
+        for (size_t m = sum_counts; m < sum_counts + counts[n]; m++){
+            Vec3 diff {points[within[m]].i - queries[n].i, points[within[m]].j - queries[n].j, points[within[m]].k - queries[n].k};
+            if (vec3_norm_square(&diff) > radius * radius){
+                nbr_mismatches++;
+            }
+        }
+        sum_counts += counts[n];
+    }
+    REQUIRE( nbr_mismatches == 0 );
+    REQUIRE( total == sum_counts );
+    REQUIRE( total > 0 );
+}
@@ -0,0 +1,128 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+#include "../src/kiss_clang_3d_mixed.h"
+
+#include <vector>
+
+TEST_CASE("mixed conversions"){
+    Vec3 const v {1.0, 2.0, 3.0};
+    Vec3_Mixed v_mixed;
+    Vec3 v_back;
+
+    vec3_to_mixed_vec3(&v, &v_mixed);
+    mixed_vec3_to_vec3(&v_mixed, &v_back);
+    REQUIRE( vec3_equal(&v, &v_back) );
+
+    Quat const q {1.0, 2.0, 3.0, 4.0};
+    Quat_Mixed q_mixed;
+    Quat q_back;
+
+    quat_to_mixed_quat(&q, &q_mixed);
+    mixed_quat_to_quat(&q_mixed, &q_back);
+    REQUIRE( quat_equal(&q, &q_back) );
+}
+
+TEST_CASE("mixed_quat_prod_chain"){
+    Quat_Mixed q_result;
+    Quat const identity {1.0, 0.0, 0.0, 0.0};
+    Quat q_result_as_quat;
+
+    // empty chain
+    mixed_quat_prod_chain(nullptr, 0, &q_result);
+    mixed_quat_to_quat(&q_result, &q_result_as_quat);
+    REQUIRE( quat_equal(&q_result_as_quat, &identity) );
+
+    // a long chain of small rotations around k: 10000 rotations of pi / 20000,
+    // i.e. a rotation of pi / 2 in total
+    size_t const nbr_rotations {10000};
+    Vec3 const axis_k {0.0, 0.0, 1.0};
+    Quat small_rotation;
+    rotation_to_quat(&small_rotation, &axis_k, F_TYPE_PI / 20000.0);
+
+    Quat_Mixed small_rotation_mixed;
+    quat_to_mixed_quat(&small_rotation, &small_rotation_mixed);
+    std::vector<Quat_Mixed> chain(nbr_rotations, small_rotation_mixed);
+
+    mixed_quat_prod_chain(chain.data(), chain.size(), &q_result);
+    mixed_quat_to_quat(&q_result, &q_result_as_quat);
+
+    F_TYPE sqrt_2_o_2 {0.7071067811865476};
+    Quat const rot_k_90 {sqrt_2_o_2, 0.0, 0.0, sqrt_2_o_2};
+    REQUIRE( quat_equal(&q_result_as_quat, &rot_k_90, 1.0e-4) );
+}
+
+TEST_CASE("mixed_vec3_mean"){
+    Vec3_Mixed v_result;
+    REQUIRE( !mixed_vec3_mean(nullptr, 0, &v_result) );
+    REQUIRE( !mixed_vec3_mean_compensated(nullptr, 0, &v_result) );
+
+    // many values that are not exactly representable; a naive float sum drifts
+    // by far more than the tolerance used here
+    std::vector<Vec3_Mixed> values(1000000, Vec3_Mixed {0.1f, 0.2f, 0.3f});
+    values.push_back(Vec3_Mixed {0.1f, 0.2f, 0.3f});
+
+    Vec3 const v_expected {0.1, 0.2, 0.3};
+    Vec3 v_result_as_vec3;
+
+    REQUIRE( mixed_vec3_mean(values.data(), values.size(), &v_result) );
+    mixed_vec3_to_vec3(&v_result, &v_result_as_vec3);
+    REQUIRE( vec3_equal(&v_result_as_vec3, &v_expected, 1.0e-6) );
+
+    REQUIRE( mixed_vec3_mean_compensated(values.data(), values.size(), &v_result) );
+    mixed_vec3_to_vec3(&v_result, &v_result_as_vec3);
+    REQUIRE( vec3_equal(&v_result_as_vec3, &v_expected, 1.0e-6) );
+}
+
+TEST_CASE("mixed_quat_average"){
+    Quat_Mixed q_result;
+    REQUIRE( !mixed_quat_average(nullptr, 0, &q_result) );
+    REQUIRE( !mixed_quat_average_compensated(nullptr, 0, &q_result) );
+
+    // two rotations around k, symmetric around the rotation of pi / 4; the second one
+    // is given with the opposite sign, which is the same rotation
+    Vec3 const axis_k {0.0, 0.0, 1.0};
+    Quat q_1;
+    Quat q_2;
+    rotation_to_quat(&q_1, &axis_k, F_TYPE_PI / 4.0 - 0.1);
+    rotation_to_quat(&q_2, &axis_k, F_TYPE_PI / 4.0 + 0.1);
+    quat_setter(&q_2, -q_2.r, -q_2.i, -q_2.j, -q_2.k);
+
+    Quat_Mixed q_array[2];
+    quat_to_mixed_quat(&q_1, &q_array[0]);
+    quat_to_mixed_quat(&q_2, &q_array[1]);
+
+    Quat q_expected;
+    rotation_to_quat(&q_expected, &axis_k, F_TYPE_PI / 4.0);
+    Quat q_result_as_quat;
+
+    REQUIRE( mixed_quat_average(q_array, 2, &q_result) );
+    mixed_quat_to_quat(&q_result, &q_result_as_quat);
+    REQUIRE( quat_equal(&q_result_as_quat, &q_expected, 1.0e-6) );
+
+    REQUIRE( mixed_quat_average_compensated(q_array, 2, &q_result) );
+    mixed_quat_to_quat(&q_result, &q_result_as_quat);
+    REQUIRE( quat_equal(&q_result_as_quat, &q_expected, 1.0e-6) );
+}
+
+TEST_CASE("mixed_quat_integrate"){
+    // constant rotation rate of pi / 2 rad/s around k, over 1 s in 1000 steps
+    std::vector<Vec3_Mixed> angular_velocities(1000, Vec3_Mixed {0.0f, 0.0f, 1.5707963267948966f});
+    Quat_Mixed q {1.0f, 0.0f, 0.0f, 0.0f};
+
+    mixed_quat_integrate(&q, angular_velocities.data(), angular_velocities.size(), 0.001f);
+
+    Quat q_as_quat;
+    mixed_quat_to_quat(&q, &q_as_quat);
+
+    F_TYPE sqrt_2_o_2 {0.7071067811865476};
+    Quat const rot_k_90 {sqrt_2_o_2, 0.0, 0.0, sqrt_2_o_2};
+    REQUIRE( quat_equal(&q_as_quat, &rot_k_90, 1.0e-5) );
+
+    // no rotation at all
+    Vec3_Mixed const no_rotation {0.0f, 0.0f, 0.0f};
+    Quat_Mixed q_identity {1.0f, 0.0f, 0.0f, 0.0f};
+    mixed_quat_integrate(&q_identity, &no_rotation, 1, 0.001f);
+    mixed_quat_to_quat(&q_identity, &q_as_quat);
+    Quat const identity {1.0, 0.0, 0.0, 0.0};
+    REQUIRE( quat_equal(&q_as_quat, &identity) );
+}
@@ -0,0 +1,130 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+
+#include <vector>
+
+// a set of directions well spread over the sphere (Fibonacci sphere), plus the axes
+static std::vector<Vec3> test_directions(size_t nbr_directions){
+    std::vector<Vec3> directions;
+    F_TYPE golden_angle {2.399963229728653};
+
+    for (size_t n = 0; n < nbr_directions; n++){
+        F_TYPE k = 1.0 - 2.0 * (static_cast<F_TYPE>(n) + 0.5) / static_cast<F_TYPE>(nbr_directions);
+        F_TYPE radius = F_TYPE_SQRT(1.0 - k * k);
+        F_TYPE phi = golden_angle * static_cast<F_TYPE>(n);
+        directions.push_back(Vec3 {radius * F_TYPE_COS(phi), radius * F_TYPE_SIN(phi), k});
+    }
+
+    directions.push_back(Vec3 {1.0, 0.0, 0.0});
+    directions.push_back(Vec3 {-1.0, 0.0, 0.0});
+    directions.push_back(Vec3 {0.0, 1.0, 0.0});
+    directions.push_back(Vec3 {0.0, -1.0, 0.0});
+    directions.push_back(Vec3 {0.0, 0.0, 1.0});
+    directions.push_back(Vec3 {0.0, 0.0, -1.0});
+
+    return directions;
+}
+
+TEST_CASE("vec3_angle"){
+    Vec3 const axis_i {1.0, 0.0, 0.0};
+    Vec3 const axis_j {0.0, 2.0, 0.0};
+    Vec3 const axis_mi {-3.0, 0.0, 0.0};
+    Vec3 const diagonal {1.0, 1.0, 0.0};
+
+    REQUIRE( vec3_angle(&axis_i, &axis_i) == Approx(0.0) );
+    REQUIRE( vec3_angle(&axis_i, &axis_j) == Approx(F_TYPE_PI / 2.0) );
+    REQUIRE( vec3_angle(&axis_i, &axis_mi) == Approx(F_TYPE_PI) );
+    REQUIRE( vec3_angle(&axis_i, &diagonal) == Approx(F_TYPE_PI / 4.0) );
+}
+
+TEST_CASE("vec3_oct_encode and vec3_oct_decode"){
+    REQUIRE( vec3_oct_code_size(8) == 2 );
+    REQUIRE( vec3_oct_code_size(12) == 3 );
+    REQUIRE( vec3_oct_code_size(16) == 4 );
+
+    // the axes, and the diagonal of the upper half, are exactly representable
+    Vec3 const axis_k {0.0, 0.0, 1.0};
+    Vec3 const axis_mk {0.0, 0.0, -1.0};
+    Vec3 const axis_i {1.0, 0.0, 0.0};
+    Vec3 v_res;
+
+    vec3_oct_decode(vec3_oct_encode(&axis_k, 8), 8, &v_res);
+    REQUIRE( vec3_equal(&v_res, &axis_k, 1.0e-2) );
+    vec3_oct_decode(vec3_oct_encode(&axis_mk, 8), 8, &v_res);
+    REQUIRE( vec3_equal(&v_res, &axis_mk, 1.0e-2) );
+    vec3_oct_decode(vec3_oct_encode(&axis_i, 16), 16, &v_res);
+    REQUIRE( vec3_equal(&v_res, &axis_i, 1.0e-4) );
+
+    // a non normalized input gives the same code as the normalized one
+    Vec3 v {1.0, 2.0, 3.0};
+    uint32_t code = vec3_oct_encode(&v, 12);
+    vec3_normalize(&v);
+    REQUIRE( vec3_oct_encode(&v, 12) == code );
+
+    // the decoded vectors are unit vectors, close to the encoded ones; the bounds are
+    // the usual ones for octahedral encoding, around 1 degree for 16 bits codes
+    unsigned const bits_per_component[3] {8, 12, 16};
+    F_TYPE const max_errors[3] {2.5e-2, 1.5e-3, 1.0e-4};
+
+    for (size_t n = 0; n < 3; n++){
+        F_TYPE max_norm_error {0.0};
+        F_TYPE max_angular_error {0.0};
+
+        for (Vec3 const & direction : test_directions(1000)){
+            vec3_oct_decode(vec3_oct_encode(&direction, bits_per_component[n]), bits_per_component[n], &v_res);
+
+            F_TYPE crrt_norm_error = F_TYPE_ABS(vec3_norm(&v_res) - 1.0);
+            F_TYPE crrt_angular_error = vec3_angle(&v_res, &direction);
+            max_norm_error = crrt_norm_error > max_norm_error ? crrt_norm_error : max_norm_error;
+            max_angular_error = crrt_angular_error > max_angular_error ? crrt_angular_error : max_angular_error;
+        }
+
+        REQUIRE( max_norm_error < 1.0e-5 );
+        REQUIRE( max_angular_error < max_errors[n] );
+    }
+}
+
+TEST_CASE("vec3_oct_encode_batch and vec3_oct_decode_batch"){
+    std::vector<Vec3> directions = test_directions(1000);
+    Vec3_View view_in;
+    vec3_view_of_array(&view_in, directions.data(), directions.size());
+
+    // 24 bits codes, decoded into a float buffer
+    std::vector<unsigned char> codes(directions.size() * vec3_oct_code_size(12));
+    F_TYPE max_angular_error {-1.0};
+    vec3_oct_encode_batch(&view_in, 12, codes.data(), &max_angular_error);
+
+    REQUIRE( max_angular_error > 0.0 );
+    REQUIRE( max_angular_error < 1.0e-3 );
+
+    std::vector<float> decoded(3 * directions.size());
+    Vec3_View view_out;
+    vec3_view_setter(&view_out, decoded.data(), 3 * sizeof(float), directions.size(), 0, sizeof(float), 2 * sizeof(float), 'F');
+    vec3_oct_decode_batch(codes.data(), 12, &view_out);
+
+    F_TYPE max_angular_error_decoded {0.0};
+    Vec3 v_res;
+    size_t nbr_mismatches {0};
+    for (size_t n = 0; n < directions.size(); n++){
+        vec3_view_get(&view_out, n, &v_res);
+
+        // the batch decoding gives the same result as the single decoding
+        uint32_t code = vec3_oct_encode(&directions[n], 12);
+        Vec3 v_single;
+        vec3_oct_decode(code, 12, &v_single);
+        if (!vec3_equal(&v_res, &v_single, 1.0e-6)){
+            nbr_mismatches++;
+        }
+
+        F_TYPE crrt_error = vec3_angle(&v_res, &directions[n]);
+        max_angular_error_decoded = crrt_error > max_angular_error_decoded ? crrt_error : max_angular_error_decoded;
+    }
+
+    REQUIRE( nbr_mismatches == 0 );
+
+    // the reported error is the one actually obtained, up to the float storage
+    REQUIRE( max_angular_error_decoded == Approx(max_angular_error).margin(1.0e-5) );
+
+    // the error is only computed on request
+    vec3_oct_encode_batch(&view_in, 8, codes.data(), nullptr);
+}
@@ -0,0 +1,77 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+
+// both the float (_f) and the double (_d) versions of the library are available in
+// every build, whatever the F_TYPE_SWITCH; the unsuffixed names alias one of them.
+
+TEST_CASE("Precisions types"){
+    REQUIRE( sizeof(Vec3_f) == 3 * sizeof(float) );
+    REQUIRE( sizeof(Vec3_d) == 3 * sizeof(double) );
+    REQUIRE( sizeof(Quat_f) == 4 * sizeof(float) );
+    REQUIRE( sizeof(Quat_d) == 4 * sizeof(double) );
+
+    REQUIRE( sizeof(F_TYPE_f) == sizeof(float) );
+    REQUIRE( sizeof(F_TYPE_d) == sizeof(double) );
+}
+
+TEST_CASE("Precisions default alias"){
+    Vec3 v {1.0, 2.0, 3.0};
+
+#if (F_TYPE_SWITCH == 'F')
+    REQUIRE( sizeof(Vec3) == sizeof(Vec3_f) );
+    REQUIRE( sizeof(F_TYPE) == sizeof(float) );
+    REQUIRE( F_TYPE_TAG == 'F' );
+    Vec3_f * v_as_suffixed = &v;
+    REQUIRE( vec3_norm_square_f(v_as_suffixed) == Approx(14.0) );
+#else
+    REQUIRE( sizeof(Vec3) == sizeof(Vec3_d) );
+    REQUIRE( sizeof(F_TYPE) == sizeof(double) );
+    REQUIRE( F_TYPE_TAG == 'D' );
+    Vec3_d * v_as_suffixed = &v;
+    REQUIRE( vec3_norm_square_d(v_as_suffixed) == Approx(14.0) );
+#endif
+}
+
+TEST_CASE("Precisions used together"){
+    // float for the bulk vector work
+    Vec3_f const axis_k_f {0.0f, 0.0f, 1.0f};
+    Vec3_f const v_f {1.0f, 0.0f, 0.0f};
+    Vec3_f const v_f_res {0.0f, 1.0f, 0.0f};
+    Quat_f q_f;
+    Vec3_f Rv_f;
+
+    REQUIRE( rotation_to_quat_f(&q_f, &axis_k_f, F_TYPE_PI_f / 2.0f) );
+    rotate_by_quat_R_f(&v_f, &q_f, &Rv_f);
+    REQUIRE( vec3_equal_f(&Rv_f, &v_f_res) );
+
+    // double for the long composition chain
+    Vec3_d const axis_k_d {0.0, 0.0, 1.0};
+    Quat_d q_step_d;
+    Quat_d q_acc_d {1.0, 0.0, 0.0, 0.0};
+    Quat_d q_tmp_d;
+
+    REQUIRE( rotation_to_quat_d(&q_step_d, &axis_k_d, F_TYPE_PI_d / 10000.0) );
+    for (int n = 0; n < 10000; n++){
+        quat_prod_d(&q_acc_d, &q_step_d, &q_tmp_d);
+        quat_copy_d(&q_tmp_d, &q_acc_d);
+    }
+
+    // the tolerance accounts for the float test build, where the literals (including
+    // F_TYPE_PI_d) are float constants (-fsingle-precision-constant)
+    Quat_d const rot_k_180 {0.0, 0.0, 0.0, 1.0};
+    REQUIRE( quat_equal_d(&q_acc_d, &rot_k_180, 1.0e-6) );
+    REQUIRE( quat_is_unitary_d(&q_acc_d, 1.0e-9) );
+}
+
+TEST_CASE("Precisions views"){
+    // the views can be used from both precisions
+    Vec3_f array_f[2] {{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}};
+    Vec3_View view_f;
+    vec3_view_of_array_f(&view_f, array_f, 2);
+    REQUIRE( view_f.component_type == 'F' );
+
+    Vec3_d v_d;
+    Vec3_d const v_d_res {4.0, 5.0, 6.0};
+    vec3_view_get_d(&view_f, 1, &v_d);
+    REQUIRE( vec3_equal_d(&v_d, &v_d_res) );
+}
@@ -0,0 +1,236 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+#include "../src/kiss_clang_3d_quat_spline.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// rotations turning around a slowly changing axis, with some sign flips
+static std::vector<Quat> wavy_rotations(size_t count){
+    std::vector<Quat> rotations(count);
+    for (size_t n = 0; n < count; n++){
+        F_TYPE x = static_cast<F_TYPE>(n);
+        Vec3 const axis {F_TYPE_COS(0.3 * x), F_TYPE_SIN(0.3 * x), 1.0};
+        rotation_to_quat(&rotations[n], &axis, 0.4 * x);
+        if (n % 3 == 1){
+            quat_setter(&rotations[n], -rotations[n].r, -rotations[n].i, -rotations[n].j, -rotations[n].k);
+        }
+    }
+    return rotations;
+}
+
+TEST_CASE("squad_spline_init and squad_spline_eval"){
+    size_t const nbr_keys {8};
+    std::vector<Quat> const keys = wavy_rotations(nbr_keys);
+    F_TYPE const times[nbr_keys] = {0.0, 0.5, 1.5, 2.0, 3.0, 3.2, 4.0, 5.0};
+    Squad_Segment segments[nbr_keys - 1];
+    Squad_Spline spline;
+
+    REQUIRE( squad_spline_init(&spline, keys.data(), times, nbr_keys, segments) );
+    REQUIRE( !squad_spline_init(&spline, keys.data(), times, 1, segments) );
+    F_TYPE const times_not_increasing[3] = {0.0, 1.0, 1.0};
+    REQUIRE( !squad_spline_init(&spline, keys.data(), times_not_increasing, 3, segments) );
+    REQUIRE( squad_spline_init(&spline, keys.data(), times, nbr_keys, segments) );
+
+    // through the keys, and clamped out of the range
+    Quat q;
+    size_t nbr_mismatches {0};
+    for (size_t n = 0; n < nbr_keys; n++){
+        squad_spline_eval(&spline, times[n], &q);
+        if (quat_angle(&q, &keys[n]) > 1.0e-3){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+    squad_spline_eval(&spline, -1.0, &q);
+    REQUIRE( quat_angle(&q, &keys[0]) < 1.0e-3 );
+    squad_spline_eval(&spline, 7.0, &q);
+    REQUIRE( quat_angle(&q, &keys[nbr_keys - 1]) < 1.0e-3 );
+    squad_spline_eval(&spline, std::numeric_limits<F_TYPE>::quiet_NaN(), &q);
+    REQUIRE( quat_angle(&q, &keys[0]) < 1.0e-3 );
+
+    // continuous and smooth: no jump, even across the keys, and the steps across a key
+    // are about equal on both sides
+    F_TYPE const step {0.001};
+    Quat q_before;
+    Quat q_after;
+    for (size_t n = 1; n + 1 < nbr_keys; n++){
+        squad_spline_eval(&spline, times[n] - step, &q_before);
+        squad_spline_eval(&spline, times[n], &q);
+        squad_spline_eval(&spline, times[n] + step, &q_after);
+        F_TYPE angle_before = quat_angle(&q_before, &q);
+        F_TYPE angle_after = quat_angle(&q, &q_after);
+        if (angle_before > 0.01 || angle_after > 0.01){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+
+    // 2 keys: slerp
+    Squad_Spline spline_2;
+    REQUIRE( squad_spline_init(&spline_2, keys.data() + 3, times, 2, segments) );
+    squad_spline_eval(&spline_2, 0.25, &q);
+    Vec3 delta;
+    quat_boxminus(&keys[4], &keys[3], &delta);
+    vec3_scale(&delta, 0.5);
+    Quat q_expected;
+    quat_boxplus(&keys[3], &delta, &q_expected);
+    REQUIRE( quat_angle(&q, &q_expected) == Approx(0.0).margin(1.0e-3) );
+}
+
+TEST_CASE("squad_spline_eval_batch"){
+    size_t const nbr_keys {20};
+    std::vector<Quat> const keys = wavy_rotations(nbr_keys);
+    std::vector<F_TYPE> times(nbr_keys);
+    for (size_t n = 0; n < nbr_keys; n++){
+        times[n] = static_cast<F_TYPE>(n * n) * 0.1;
+    }
+    std::vector<Squad_Segment> segments(nbr_keys - 1);
+    Squad_Spline spline;
+    REQUIRE( squad_spline_init(&spline, keys.data(), times.data(), nbr_keys, segments.data()) );
+
+    // sorted queries, then a few out of order
+    size_t const count {1000};
+    std::vector<F_TYPE> queries(count);
+    for (size_t n = 0; n < count; n++){
+        queries[n] = static_cast<F_TYPE>(n) * 0.04 - 1.0;
+    }
+    queries[500] = 3.0;
+    queries[501] = 0.1;
+    queries[700] = std::numeric_limits<F_TYPE>::quiet_NaN();
+
+    std::vector<Quat> results(count);
+    Quat_View view;
+    quat_view_of_array(&view, results.data(), count);
+    size_t nbr_out_of_range = squad_spline_eval_batch(&spline, queries.data(), &view);
+
+    size_t nbr_expected_out_of_range {0};
+    size_t nbr_mismatches {0};
+    for (size_t n = 0; n < count; n++){
+        if (std::isnan(queries[n]) || queries[n] < times[0] || queries[n] > times[nbr_keys - 1]){
+            nbr_expected_out_of_range++;
+        }
+        Quat q;
+        squad_spline_eval(&spline, queries[n], &q);
+        if (!quat_equal(&q, &results[n], 0.0)){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+    REQUIRE( nbr_out_of_range == nbr_expected_out_of_range );
+    REQUIRE( nbr_out_of_range > 0 );
+}
+
+TEST_CASE("quat_bspline_eval, with the angular velocity and acceleration"){
+    size_t const nbr_control_points {10};
+    std::vector<Quat> const control_points = wavy_rotations(nbr_control_points);
+    Vec3 deltas[nbr_control_points - 1];
+    Quat_BSpline spline;
+    F_TYPE const dt {0.5};
+
+    REQUIRE( !quat_bspline_init(&spline, control_points.data(), 3, 1.0, dt, deltas) );
+    REQUIRE( !quat_bspline_init(&spline, control_points.data(), nbr_control_points, 1.0, 0.0, deltas) );
+    REQUIRE( quat_bspline_init(&spline, control_points.data(), nbr_control_points, 1.0, dt, deltas) );
+
+    // the angular velocity and acceleration against finite differences of the
+    // rotation and of the velocity, in the body frame, also across the segments
+    double const step_double = F_TYPE_TAG == 'D' ? 1.0e-5 : 1.0e-2;
+    F_TYPE const step = F_TYPE_FROM_DOUBLE(step_double);
+    double const tolerance = F_TYPE_TAG == 'D' ? 1.0e-4 : 2.0e-2;
+    size_t nbr_mismatches {0};
+    for (F_TYPE t : {1.1, 1.5, 2.0, 2.26, 3.7, 4.4}){
+        Quat q;
+        Quat q_before;
+        Quat q_after;
+        Vec3 velocity;
+        Vec3 acceleration;
+        Vec3 velocity_before;
+        Vec3 velocity_after;
+        quat_bspline_eval(&spline, t, &q, &velocity, &acceleration);
+        quat_bspline_eval(&spline, t - step, &q_before, &velocity_before);
+        quat_bspline_eval(&spline, t + step, &q_after, &velocity_after);
+
+        Vec3 velocity_fd;
+        quat_boxminus(&q_after, &q_before, &velocity_fd);
+        vec3_scale(&velocity_fd, 1.0 / (2.0 * step));
+        Vec3 acceleration_fd {
+            (velocity_after.i - velocity_before.i) / (2.0 * step),
+            (velocity_after.j - velocity_before.j) / (2.0 * step),
+            (velocity_after.k - velocity_before.k) / (2.0 * step)
+        };
+
+        if (!vec3_equal(&velocity, &velocity_fd, F_TYPE_FROM_DOUBLE(tolerance)) || !vec3_equal(&acceleration, &acceleration_fd, F_TYPE_FROM_DOUBLE(tolerance) * 10.0)){
+            nbr_mismatches++;
+        }
+        if (vec3_norm(&velocity) < 0.1){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+
+    // clamped out of the range, which is [1, 1 + 7 * 0.5]
+    Quat q;
+    Quat q_end;
+    quat_bspline_eval(&spline, 4.5, &q_end);
+    quat_bspline_eval(&spline, 10.0, &q);
+    REQUIRE( quat_equal(&q, &q_end, 0.0) );
+
+    // a NaN time is out of the range too, at the start
+    Quat q_start;
+    quat_bspline_eval(&spline, 1.0, &q_start);
+    quat_bspline_eval(&spline, std::numeric_limits<F_TYPE>::quiet_NaN(), &q);
+    REQUIRE( quat_equal(&q, &q_start, 0.0) );
+
+    // control points of the same rotation: the spline is that rotation, at rest
+    std::vector<Quat> const constant(4, control_points[2]);
+    Vec3 deltas_constant[3];
+    REQUIRE( quat_bspline_init(&spline, constant.data(), 4, 0.0, 1.0, deltas_constant) );
+    Vec3 velocity;
+    Vec3 acceleration;
+    Vec3 const zero {0.0, 0.0, 0.0};
+    quat_bspline_eval(&spline, 0.3, &q, &velocity, &acceleration);
+    REQUIRE( quat_angle(&q, &control_points[2]) == Approx(0.0).margin(1.0e-3) );
+    REQUIRE( vec3_equal(&velocity, &zero) );
+    REQUIRE( vec3_equal(&acceleration, &zero) );
+}
+
+TEST_CASE("quat_bspline_eval_batch"){
+    size_t const nbr_control_points {30};
+    std::vector<Quat> const control_points = wavy_rotations(nbr_control_points);
+    std::vector<Vec3> deltas(nbr_control_points - 1);
+    Quat_BSpline spline;
+    REQUIRE( quat_bspline_init(&spline, control_points.data(), nbr_control_points, 0.0, 0.1, deltas.data()) );
+
+    size_t const count {500};
+    std::vector<F_TYPE> times(count);
+    for (size_t n = 0; n < count; n++){
+        times[n] = static_cast<F_TYPE>(n) * 0.006 - 0.1;
+    }
+    std::vector<Quat> rotations(count);
+    std::vector<Vec3> velocities(count);
+    std::vector<Vec3> accelerations(count);
+    Quat_View q_view;
+    Vec3_View velocities_view;
+    Vec3_View accelerations_view;
+    quat_view_of_array(&q_view, rotations.data(), count);
+    vec3_view_of_array(&velocities_view, velocities.data(), count);
+    vec3_view_of_array(&accelerations_view, accelerations.data(), count);
+
+    // range [0, 2.7]: the first 17 times are before it, the last 33 after it, and a NaN
+    times[250] = std::numeric_limits<F_TYPE>::quiet_NaN();
+    REQUIRE( quat_bspline_eval_batch(&spline, times.data(), &q_view, &velocities_view, &accelerations_view) == 51 );
+    REQUIRE( quat_bspline_eval_batch(&spline, times.data(), &q_view) == 51 );
+
+    size_t nbr_mismatches {0};
+    for (size_t n = 0; n < count; n++){
+        Quat q;
+        Vec3 velocity;
+        Vec3 acceleration;
+        quat_bspline_eval(&spline, times[n], &q, &velocity, &acceleration);
+        if (!quat_equal(&q, &rotations[n], 0.0) || !vec3_equal(&velocity, &velocities[n], 0.0) || !vec3_equal(&acceleration, &accelerations[n], 0.0)){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+}
@@ -0,0 +1,89 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+#include "../src/kiss_clang_3d_rotation_cache.h"
+
+#include <vector>
+
+static bool bit_equal(Quat const * q_1, Quat const * q_2){
+    return q_1->r == q_2->r && q_1->i == q_2->i && q_1->j == q_2->j && q_1->k == q_2->k;
+}
+
+TEST_CASE("rotation_cache_init"){
+    Rotation_Cache cache;
+    Rotation_Cache_Entry entries[16];
+
+    REQUIRE( rotation_cache_init(&cache, entries, 16) );
+    REQUIRE( cache.nbr_hits == 0 );
+    REQUIRE( cache.nbr_misses == 0 );
+    REQUIRE( !rotation_cache_init(&cache, entries, 12) );
+    REQUIRE( !rotation_cache_init(&cache, entries, 0) );
+}
+
+TEST_CASE("rotation_to_quat_cached"){
+    Rotation_Cache cache;
+    std::vector<Rotation_Cache_Entry> entries(256);
+    REQUIRE( rotation_cache_init(&cache, entries.data(), entries.size()) );
+
+    // 50 different inputs, repeated 20 times: the same results as rotation_to_quat
+    size_t const nbr_inputs {50};
+    size_t nbr_mismatches {0};
+    for (size_t repetition = 0; repetition < 20; repetition++){
+        for (size_t n = 0; n < nbr_inputs; n++){
+            F_TYPE x = static_cast<F_TYPE>(n) / static_cast<F_TYPE>(nbr_inputs);
+            Vec3 const axis {1.0 - x, x, 0.5};
+            Quat q;
+            Quat q_expected;
+            bool valid = rotation_to_quat_cached(&cache, &q, &axis, 6.0 * x - 3.0);
+            rotation_to_quat(&q_expected, &axis, 6.0 * x - 3.0);
+            if (!valid || !bit_equal(&q, &q_expected)){
+                nbr_mismatches++;
+            }
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+    REQUIRE( cache.nbr_misses == nbr_inputs );
+    REQUIRE( cache.nbr_hits == 19 * nbr_inputs );
+
+    // bit exact keys: -0.0 is not 0.0
+    Vec3 const axis_k {0.0, 0.0, 1.0};
+    Vec3 const axis_k_minus_zero {-0.0, 0.0, 1.0};
+    Quat q;
+    rotation_to_quat_cached(&cache, &q, &axis_k, 0.5);
+    rotation_to_quat_cached(&cache, &q, &axis_k_minus_zero, 0.5);
+    REQUIRE( cache.nbr_misses == nbr_inputs + 2 );
+
+    // null axis: bypasses the cache, with the same return values
+    Vec3 const axis_null {0.0, 0.0, 0.0};
+    REQUIRE( rotation_to_quat_cached(&cache, &q, &axis_null, 0.0) );
+    REQUIRE( !rotation_to_quat_cached(&cache, &q, &axis_null, 0.5) );
+    REQUIRE( cache.nbr_misses == nbr_inputs + 2 );
+
+    rotation_cache_clear(&cache);
+    REQUIRE( cache.nbr_hits == 0 );
+    rotation_to_quat_cached(&cache, &q, &axis_k, 0.5);
+    REQUIRE( cache.nbr_misses == 1 );
+}
+
+TEST_CASE("rotation_to_quat_cached, evictions"){
+    // many more inputs than entries: the cache stays bounded, and still correct
+    Rotation_Cache cache;
+    Rotation_Cache_Entry entries[8];
+    REQUIRE( rotation_cache_init(&cache, entries, 8) );
+
+    size_t nbr_mismatches {0};
+    for (size_t repetition = 0; repetition < 3; repetition++){
+        for (size_t n = 0; n < 100; n++){
+            Vec3 const axis {1.0, 2.0, static_cast<F_TYPE>(n)};
+            Quat q;
+            Quat q_expected;
+            rotation_to_quat_cached(&cache, &q, &axis, 0.25);
+            rotation_to_quat(&q_expected, &axis, 0.25);
+            if (!bit_equal(&q, &q_expected)){
+                nbr_mismatches++;
+            }
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+    REQUIRE( cache.nbr_hits + cache.nbr_misses == 300 );
+    REQUIRE( cache.nbr_misses > 200 );
+}
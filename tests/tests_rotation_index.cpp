@@ -0,0 +1,206 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+#include "../src/kiss_clang_3d_rotation_index.h"
+
+#include <algorithm>
+#include <vector>
+
+// deterministic pseudo random coordinates in [-1, 1)
+static F_TYPE next_coordinate(uint32_t * state){
+    *state = *state * 1664525u + 1013904223u;
+    return static_cast<F_TYPE>(*state >> 8) / static_cast<F_TYPE>(1u << 23) - 1.0;
+}
+
+// unit quaternions of any sign; with near_pi, close to r = 0, where q and -q are far
+// apart in 4D but are the same rotation
+static std::vector<Quat> random_rotations(size_t count, uint32_t seed, bool near_pi){
+    std::vector<Quat> rotations(count);
+    for (Quat & q : rotations){
+        quat_setter(&q, near_pi ? 0.01 * next_coordinate(&seed) : next_coordinate(&seed), next_coordinate(&seed), next_coordinate(&seed), next_coordinate(&seed));
+        F_TYPE norm = quat_norm(&q);
+        quat_setter(&q, q.r / norm, q.i / norm, q.j / norm, q.k / norm);
+    }
+    return rotations;
+}
+
+static std::vector<F_TYPE> brute_force_angles(std::vector<Quat> const & rotations, Quat const * q){
+    std::vector<F_TYPE> angles;
+    for (Quat const & rotation : rotations){
+        angles.push_back(quat_angle(&rotation, q));
+    }
+    std::sort(angles.begin(), angles.end());
+    return angles;
+}
+
+TEST_CASE("quat_scalar and quat_angle"){
+    Vec3 const axis {1.0, 2.0, 3.0};
+    Quat q_1;
+    Quat q_2;
+
+    rotation_to_quat(&q_1, &axis, 0.3);
+    rotation_to_quat(&q_2, &axis, 0.8);
+    REQUIRE( quat_scalar(&q_1, &q_2) == Approx(F_TYPE_COS(0.25)) );
+    REQUIRE( quat_angle(&q_1, &q_2) == Approx(0.5) );
+    REQUIRE( quat_angle(&q_2, &q_1) == Approx(0.5) );
+
+    // -q_2 is the same rotation
+    quat_setter(&q_2, -q_2.r, -q_2.i, -q_2.j, -q_2.k);
+    REQUIRE( quat_scalar(&q_1, &q_2) == Approx(-F_TYPE_COS(0.25)) );
+    REQUIRE( quat_angle(&q_1, &q_2) == Approx(0.5) );
+
+    // the largest angle is pi, and a full turn is the identity
+    rotation_to_quat(&q_2, &axis, 0.3 + F_TYPE_PI);
+    REQUIRE( quat_angle(&q_1, &q_2) == Approx(F_TYPE_PI) );
+    rotation_to_quat(&q_2, &axis, 0.3 + 2.0 * F_TYPE_PI);
+    REQUIRE( quat_angle(&q_1, &q_2) == Approx(0.0).margin(1.0e-5) );
+
+    // small angles, where acos of the scalar would lose the precision
+    rotation_to_quat(&q_2, &axis, 0.3 + 1.0e-3);
+    REQUIRE( quat_angle(&q_1, &q_2) == Approx(1.0e-3).epsilon(1.0e-2) );
+    REQUIRE( quat_angle(&q_1, &q_1) == 0.0 );
+}
+
+TEST_CASE("quat_abs_scalar_batch and quat_nearest_batch, against brute force"){
+    std::vector<Quat> refs = random_rotations(300, 1, false);
+    Quat_View refs_view;
+    quat_view_of_array(&refs_view, refs.data(), refs.size());
+
+    std::vector<Quat> const queries = random_rotations(50, 2, false);
+    std::vector<F_TYPE> abs_scalars(refs.size());
+    size_t const k {5};
+    double const tolerance {1.0e-4};
+    size_t nbr_mismatches {0};
+
+    for (Quat const & query : queries){
+        quat_abs_scalar_batch(&query, &refs_view, abs_scalars.data());
+        for (size_t n = 0; n < refs.size(); n++){
+            if (abs_scalars[n] != F_TYPE_ABS(quat_scalar(&query, &refs[n]))){
+                nbr_mismatches++;
+            }
+        }
+
+        std::vector<F_TYPE> const expected = brute_force_angles(refs, &query);
+        size_t indexes[k];
+        F_TYPE angles[k];
+        if (quat_nearest_batch(&query, &refs_view, k, indexes, angles) != k){
+            nbr_mismatches++;
+        }
+        for (size_t n = 0; n < k; n++){
+            if (F_TYPE_TO_DOUBLE(F_TYPE_ABS(angles[n] - expected[n])) > tolerance || angles[n] != quat_angle(&query, &refs[indexes[n]])){
+                nbr_mismatches++;
+            }
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+
+    // less references than k
+    Quat_View small_view;
+    quat_view_of_array(&small_view, refs.data(), 3);
+    size_t indexes[k];
+    F_TYPE angles[k];
+    REQUIRE( quat_nearest_batch(&queries[0], &small_view, k, indexes, angles) == 3 );
+    REQUIRE( angles[0] <= angles[1] );
+    REQUIRE( angles[1] <= angles[2] );
+    REQUIRE( quat_nearest_batch(&queries[0], &refs_view, 0, indexes, angles) == 0 );
+}
+
+TEST_CASE("rotation_index_build"){
+    std::vector<Quat> rotations = random_rotations(1000, 3, false);
+    std::vector<Quat> const rotations_before = rotations;
+    std::vector<size_t> original_indexes(rotations.size());
+
+    Rotation_Index index;
+    REQUIRE( rotation_index_build(&index, rotations.data(), rotations.size(), original_indexes.data()) );
+    REQUIRE( index.count == 1000 );
+    REQUIRE( !rotation_index_build(&index, NULL, 10) );
+
+    // a permutation of the canonicalized rotations
+    size_t nbr_mismatches {0};
+    for (size_t n = 0; n < rotations.size(); n++){
+        Quat expected;
+        quat_copy(&rotations_before[original_indexes[n]], &expected);
+        quat_canonicalize(&expected);
+        if (!quat_equal(&rotations[n], &expected, 0.0) || rotations[n].r < 0.0){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+}
+
+TEST_CASE("rotation_index_nearest, against brute force"){
+    for (bool near_pi : {false, true}){
+        std::vector<Quat> rotations = random_rotations(2000, 4, near_pi);
+        std::vector<Quat> const rotations_before = rotations;
+
+        Rotation_Index index;
+        REQUIRE( rotation_index_build(&index, rotations.data(), rotations.size()) );
+
+        // queries of both signs, so that the nearest rotations are often stored as -q
+        std::vector<Quat> queries = random_rotations(200, 5, near_pi);
+        size_t const k {7};
+        double const tolerance {1.0e-4};
+        size_t nbr_mismatches {0};
+
+        for (Quat const & query : queries){
+            std::vector<F_TYPE> const expected = brute_force_angles(rotations_before, &query);
+
+            size_t indexes[k];
+            F_TYPE angles[k];
+            if (rotation_index_nearest(&index, &query, k, indexes, angles) != k){
+                nbr_mismatches++;
+            }
+            for (size_t n = 0; n < k; n++){
+                if (F_TYPE_TO_DOUBLE(F_TYPE_ABS(angles[n] - expected[n])) > tolerance || angles[n] != quat_angle(&rotations[indexes[n]], &query)){
+                    nbr_mismatches++;
+                }
+            }
+        }
+        REQUIRE( nbr_mismatches == 0 );
+    }
+}
+
+TEST_CASE("rotation_index_nearest, less rotations than k, and batch"){
+    std::vector<Quat> rotations = random_rotations(3, 6, false);
+    Rotation_Index index;
+    REQUIRE( rotation_index_build(&index, rotations.data(), rotations.size()) );
+
+    // the query is one of the rotations, with the other sign
+    Quat query;
+    quat_setter(&query, -rotations[1].r, -rotations[1].i, -rotations[1].j, -rotations[1].k);
+    size_t indexes[5];
+    F_TYPE angles[5];
+    REQUIRE( rotation_index_nearest(&index, &query, 5, indexes, angles) == 3 );
+    REQUIRE( indexes[0] == 1 );
+    REQUIRE( angles[0] == Approx(0.0).margin(1.0e-5) );
+    REQUIRE( angles[1] <= angles[2] );
+    REQUIRE( indexes[3] == ROTATION_INDEX_NOT_FOUND );
+    REQUIRE( indexes[4] == ROTATION_INDEX_NOT_FOUND );
+
+    Rotation_Index empty_index;
+    REQUIRE( rotation_index_build(&empty_index, rotations.data(), 0) );
+    REQUIRE( rotation_index_nearest(&empty_index, &query, 5, indexes, angles) == 0 );
+
+    std::vector<Quat> refs = random_rotations(500, 7, false);
+    REQUIRE( rotation_index_build(&index, refs.data(), refs.size()) );
+    std::vector<Quat> queries = random_rotations(50, 8, false);
+    Quat_View queries_view;
+    quat_view_of_array(&queries_view, queries.data(), queries.size());
+
+    size_t const k {3};
+    std::vector<size_t> batch_indexes(queries.size() * k);
+    std::vector<F_TYPE> batch_angles(queries.size() * k);
+    REQUIRE( rotation_index_nearest_batch(&index, &queries_view, k, batch_indexes.data(), batch_angles.data()) == queries.size() );
+
+    size_t nbr_mismatches {0};
+    for (size_t n = 0; n < queries.size(); n++){
+        size_t single_indexes[k];
+        F_TYPE single_angles[k];
+        rotation_index_nearest(&index, &queries[n], k, single_indexes, single_angles);
+        for (size_t m = 0; m < k; m++){
+            if (batch_indexes[n * k + m] != single_indexes[m] || batch_angles[n * k + m] != single_angles[m]){
+                nbr_mismatches++;
+            }
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+}
@@ -0,0 +1,159 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+#include "../src/kiss_clang_3d_rotation_kmeans.h"
+#include "../src/kiss_clang_3d_so3_sampling.h"
+
+#include <vector>
+
+// rotations within about max_angle of center, with random signs
+static std::vector<Quat> noisy_rotations(Quat const * center, size_t count, F_TYPE max_angle, SO3_Rng * rng){
+    std::vector<Quat> rotations(count);
+    for (Quat & q : rotations){
+        Vec3 const axis {so3_rng_uniform(rng) - 0.5, so3_rng_uniform(rng) - 0.5, so3_rng_uniform(rng) - 0.5};
+        Quat noise;
+        rotation_to_quat(&noise, &axis, max_angle * so3_rng_uniform(rng));
+        quat_prod(center, &noise, &q);
+        if (so3_rng_uniform(rng) < 0.5){
+            quat_setter(&q, -q.r, -q.i, -q.j, -q.k);
+        }
+    }
+    return rotations;
+}
+
+TEST_CASE("quat_mean_markley and the mean accumulators"){
+    Vec3 const axis {1.0, 2.0, 3.0};
+    Quat center;
+    rotation_to_quat(&center, &axis, 2.5);
+
+    // symmetric noise around center, with both signs: the mean is center
+    Vec3 const axis_noise {0.0, 1.0, 0.0};
+    Quat noise;
+    std::vector<Quat> rotations;
+    for (F_TYPE angle : {-0.2, 0.2, -0.1, 0.1}){
+        Quat q;
+        rotation_to_quat(&noise, &axis_noise, angle);
+        quat_prod(&center, &noise, &q);
+        rotations.push_back(q);
+        quat_setter(&q, -q.r, -q.i, -q.j, -q.k);
+        rotations.push_back(q);
+    }
+
+    Quat_View view;
+    quat_view_of_array(&view, rotations.data(), rotations.size());
+    Quat mean;
+    REQUIRE( quat_mean_markley(&view, &mean) );
+    REQUIRE( quat_angle(&mean, &center) == Approx(0.0).margin(1.0e-5) );
+    REQUIRE( quat_is_unitary(&mean) );
+    REQUIRE( mean.r >= 0.0 );
+
+    // merging the accumulators of 2 slices is the same as 1 accumulator
+    SO3_Rng rng;
+    so3_rng_seed(&rng, 3);
+    std::vector<Quat> cluster = noisy_rotations(&center, 1000, 0.5, &rng);
+    quat_view_of_array(&view, cluster.data(), cluster.size());
+    Quat_View slice_1;
+    Quat_View slice_2;
+    quat_view_slice(&view, 0, 300, &slice_1);
+    quat_view_slice(&view, 300, 700, &slice_2);
+
+    Quat_Mean_Acc acc_1;
+    Quat_Mean_Acc acc_2;
+    quat_mean_acc_clear(&acc_1);
+    quat_mean_acc_clear(&acc_2);
+    Quat crrt;
+    for (size_t n = 0; n < slice_1.count; n++){
+        quat_view_get(&slice_1, n, &crrt);
+        quat_mean_acc_add(&acc_1, &crrt);
+    }
+    for (size_t n = 0; n < slice_2.count; n++){
+        quat_view_get(&slice_2, n, &crrt);
+        quat_mean_acc_add(&acc_2, &crrt);
+    }
+    quat_mean_acc_merge(&acc_1, &acc_2);
+    REQUIRE( acc_1.count == 1000 );
+
+    Quat mean_merged;
+    REQUIRE( quat_mean_acc_result(&acc_1, &mean_merged) );
+    REQUIRE( quat_mean_markley(&view, &mean) );
+    REQUIRE( quat_angle(&mean, &mean_merged) == Approx(0.0).margin(1.0e-5) );
+    // the noise is not symmetric for this few rotations, but centered
+    REQUIRE( quat_angle(&mean, &center) < 0.05 );
+
+    Quat_Mean_Acc acc_empty;
+    quat_mean_acc_clear(&acc_empty);
+    REQUIRE( !quat_mean_acc_result(&acc_empty, &mean) );
+}
+
+TEST_CASE("rotation_kmeans_init, rotation_kmeans"){
+    SO3_Rng rng;
+    so3_rng_seed(&rng, 4);
+
+    size_t const k {4};
+    size_t const cluster_size {500};
+    Quat centers[k];
+    std::vector<Quat> rotations;
+    for (size_t m = 0; m < k; m++){
+        Vec3 const axis {1.0, 0.0, 0.0};
+        rotation_to_quat(&centers[m], &axis, 0.8 * static_cast<F_TYPE>(m) - 1.2);
+        std::vector<Quat> const cluster = noisy_rotations(&centers[m], cluster_size, 0.15, &rng);
+        rotations.insert(rotations.end(), cluster.begin(), cluster.end());
+    }
+
+    Quat_View view;
+    quat_view_of_array(&view, rotations.data(), rotations.size());
+
+    Quat centroids[k];
+    std::vector<F_TYPE> scratch(rotations.size());
+    REQUIRE( rotation_kmeans_init(&view, k, centroids, scratch.data()) == k );
+
+    std::vector<size_t> assignments(rotations.size());
+    Quat_Mean_Acc accs[k];
+    size_t nbr_iterations = rotation_kmeans(&view, k, centroids, assignments.data(), accs);
+    REQUIRE( nbr_iterations > 1 );
+    REQUIRE( nbr_iterations < 100 );
+
+    // each cluster is found: the rotations of a center all share the same centroid,
+    // near the center
+    size_t nbr_mismatches {0};
+    for (size_t m = 0; m < k; m++){
+        size_t cluster = assignments[m * cluster_size];
+        if (accs[cluster].count != cluster_size || quat_angle(&centroids[cluster], &centers[m]) > 0.02){
+            nbr_mismatches++;
+        }
+        for (size_t n = m * cluster_size; n < (m + 1) * cluster_size; n++){
+            if (assignments[n] != cluster){
+                nbr_mismatches++;
+            }
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+
+    // converged: one more assignment changes nothing
+    for (size_t m = 0; m < k; m++){
+        quat_mean_acc_clear(&accs[m]);
+    }
+    REQUIRE( rotation_kmeans_assign(&view, centroids, k, assignments.data(), accs) == 0 );
+
+    // less rotations than k
+    Quat_View small_view;
+    quat_view_of_array(&small_view, rotations.data(), 2);
+    for (size_t m = 0; m < k; m++){
+        quat_setter(&centroids[m], 0.0, 0.0, 0.0, 0.0);
+    }
+    REQUIRE( rotation_kmeans_init(&small_view, k, centroids, scratch.data()) == 2 );
+    REQUIRE( quat_equal(&centroids[2], &rotations[0], 0.0) );
+    REQUIRE( quat_equal(&centroids[3], &rotations[0], 0.0) );
+
+    // all the k centroids are used, the extra clusters stay empty
+    REQUIRE( rotation_kmeans(&small_view, k, centroids, assignments.data(), accs) == 2 );
+    REQUIRE( assignments[0] == 0 );
+    REQUIRE( assignments[1] == 1 );
+    REQUIRE( accs[2].count == 0 );
+    REQUIRE( accs[3].count == 0 );
+
+    Quat_View empty_view;
+    quat_view_of_array(&empty_view, rotations.data(), 0);
+    Quat const identity {1.0, 0.0, 0.0, 0.0};
+    REQUIRE( rotation_kmeans_init(&empty_view, k, centroids, scratch.data()) == 0 );
+    REQUIRE( quat_equal(&centroids[3], &identity, 0.0) );
+}
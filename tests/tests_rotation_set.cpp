@@ -0,0 +1,166 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+#include "../src/kiss_clang_3d_rotation_set.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+TEST_CASE("quat_canonicalize"){
+    Quat q {-0.5, 0.5, -0.5, 0.5};
+    quat_canonicalize(&q);
+    REQUIRE( q.r == Approx(0.5) );
+    REQUIRE( q.i == Approx(-0.5) );
+
+    // r is 0: the first non zero component decides
+    Quat q_2 {0.0, 0.0, -0.6, 0.8};
+    quat_canonicalize(&q_2);
+    REQUIRE( q_2.j == Approx(0.6) );
+    REQUIRE( q_2.k == Approx(-0.8) );
+
+    Quat q_3 {0.5, -0.5, -0.5, -0.5};
+    Quat q_3_copy;
+    quat_copy(&q_3, &q_3_copy);
+    quat_canonicalize(&q_3);
+    REQUIRE( quat_equal(&q_3, &q_3_copy) );
+}
+
+TEST_CASE("rotation_set_init"){
+    Rotation_Set set;
+    Quat rotations[8];
+    size_t slots[16];
+
+    REQUIRE( rotation_set_init(&set, rotations, 8, slots, 16) );
+    REQUIRE( set.count == 0 );
+    // not a power of 2, too small, invalid tolerance
+    REQUIRE( !rotation_set_init(&set, rotations, 8, slots, 12) );
+    REQUIRE( !rotation_set_init(&set, rotations, 8, slots, 8) );
+    REQUIRE( !rotation_set_init(&set, rotations, 8, slots, 16, 0.0) );
+}
+
+TEST_CASE("rotation_set_insert and rotation_set_find"){
+    Rotation_Set set;
+    Quat rotations[4];
+    size_t slots[8];
+    REQUIRE( rotation_set_init(&set, rotations, 4, slots, 8) );
+
+    Vec3 const axis {1.0, 2.0, 3.0};
+    Quat q;
+    rotation_to_quat(&q, &axis, 0.7);
+    Quat q_minus {-q.r, -q.i, -q.j, -q.k};
+
+    bool inserted;
+    REQUIRE( rotation_set_find(&set, &q) == ROTATION_SET_NOT_FOUND );
+    REQUIRE( rotation_set_insert(&set, &q_minus, &inserted) == 0 );
+    REQUIRE( inserted );
+    // stored with its canonical sign
+    REQUIRE( quat_equal(&set.rotations[0], &q) );
+
+    // q and -q are the same rotation
+    REQUIRE( rotation_set_find(&set, &q) == 0 );
+    REQUIRE( rotation_set_insert(&set, &q, &inserted) == 0 );
+    REQUIRE( !inserted );
+
+    // within the tolerance on every component (DEFAULT_TOL, as quat_equal), whatever
+    // the cells the components fall in
+    F_TYPE const tolerance = DEFAULT_TOL;
+    size_t nbr_mismatches {0};
+    for (unsigned signs = 0; signs < 16; signs++){
+        Quat q_near {
+            q.r + ((signs & 1u) ? 0.9 : -0.9) * tolerance,
+            q.i + ((signs & 2u) ? 0.9 : -0.9) * tolerance,
+            q.j + ((signs & 4u) ? 0.9 : -0.9) * tolerance,
+            q.k + ((signs & 8u) ? 0.9 : -0.9) * tolerance
+        };
+        if (rotation_set_find(&set, &q_near) != 0){
+            nbr_mismatches++;
+        }
+        Quat q_far {q.r + 2.0 * tolerance, q_near.i, q_near.j, q_near.k};
+        if (rotation_set_find(&set, &q_far) != ROTATION_SET_NOT_FOUND){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+
+    // another rotation, until full
+    Quat q_other;
+    for (size_t n = 1; n < 4; n++){
+        rotation_to_quat(&q_other, &axis, 0.7 + 0.1 * static_cast<F_TYPE>(n));
+        REQUIRE( rotation_set_insert(&set, &q_other) == n );
+    }
+    rotation_to_quat(&q_other, &axis, 1.5);
+    REQUIRE( rotation_set_insert(&set, &q_other, &inserted) == ROTATION_SET_NOT_FOUND );
+    REQUIRE( !inserted );
+    REQUIRE( set.count == 4 );
+
+    rotation_set_clear(&set);
+    REQUIRE( set.count == 0 );
+    REQUIRE( rotation_set_find(&set, &q) == ROTATION_SET_NOT_FOUND );
+
+    // non finite components, and components far out of the range of the cells, are
+    // rejected instead of overflowing the cell coordinates
+    F_TYPE const nan = std::numeric_limits<F_TYPE>::quiet_NaN();
+    F_TYPE const inf = std::numeric_limits<F_TYPE>::infinity();
+    F_TYPE const huge = std::numeric_limits<F_TYPE>::max();
+    Quat const rejected[3] {
+        {nan, 0.0, 0.0, 0.0},
+        {0.5, inf, 0.0, 0.0},
+        {0.5, 0.0, 0.0, huge}
+    };
+    for (Quat const & q_rejected : rejected){
+        REQUIRE( rotation_set_find(&set, &q_rejected) == ROTATION_SET_NOT_FOUND );
+        REQUIRE( rotation_set_insert(&set, &q_rejected, &inserted) == ROTATION_SET_NOT_FOUND );
+        REQUIRE( !inserted );
+    }
+    REQUIRE( set.count == 0 );
+}
+
+TEST_CASE("rotation_set_find, rotations of pi"){
+    // r is around 0, so q and -q close to it may have different canonical signs
+    Rotation_Set set;
+    Quat rotations[4];
+    size_t slots[8];
+    REQUIRE( rotation_set_init(&set, rotations, 4, slots, 8) );
+
+    F_TYPE const tolerance = DEFAULT_TOL;
+    Quat const q {0.3 * tolerance, 0.6, 0.0, 0.8};
+    Quat const q_close {-0.3 * tolerance, -0.6, 0.0, -0.8 + 0.5 * tolerance};
+    Quat const q_close_2 {-0.3 * tolerance, 0.6, 0.0, 0.8};
+
+    REQUIRE( rotation_set_insert(&set, &q) == 0 );
+    REQUIRE( rotation_set_find(&set, &q_close) == 0 );
+    REQUIRE( rotation_set_find(&set, &q_close_2) == 0 );
+}
+
+TEST_CASE("rotations_dedup"){
+    // 500 distinct rotations, each 4 times: as is, as -q, and slightly perturbed
+    size_t const nbr_distinct {500};
+    F_TYPE const tolerance = DEFAULT_TOL;
+    std::vector<Quat> quats;
+    for (size_t n = 0; n < nbr_distinct; n++){
+        F_TYPE x = static_cast<F_TYPE>(n) / static_cast<F_TYPE>(nbr_distinct);
+        Vec3 const axis {std::cos(17.0 * x), std::sin(11.0 * x), x - 0.5};
+        Quat q;
+        rotation_to_quat(&q, &axis, 6.0 * x - 3.0);
+        quats.push_back(q);
+        quats.push_back(Quat {-q.r, -q.i, -q.j, -q.k});
+        quats.push_back(Quat {q.r + 0.5 * tolerance, q.i - 0.5 * tolerance, q.j, q.k});
+        quats.push_back(Quat {-q.r, -q.i, -q.j + 0.5 * tolerance, -q.k + 0.5 * tolerance});
+    }
+
+    std::vector<Quat> rotations(nbr_distinct);
+    std::vector<size_t> slots(2048);
+    std::vector<size_t> unique_indexes(quats.size());
+    Rotation_Set set;
+    REQUIRE( rotation_set_init(&set, rotations.data(), rotations.size(), slots.data(), slots.size()) );
+
+    REQUIRE( rotations_dedup(quats.data(), quats.size(), &set, unique_indexes.data()) == nbr_distinct );
+
+    size_t nbr_mismatches {0};
+    for (size_t n = 0; n < quats.size(); n++){
+        if (unique_indexes[n] != n / 4){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+}
@@ -0,0 +1,170 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+#include "../src/kiss_clang_3d_sample_ring.h"
+
+#include <thread>
+#include <vector>
+
+TEST_CASE("vec3_ring_init, push and pop"){
+    Vec3 samples[4];
+    Vec3_Ring ring;
+
+    REQUIRE( !vec3_ring_init(&ring, samples, 3) );
+    REQUIRE( !vec3_ring_init(&ring, NULL, 4) );
+    REQUIRE( vec3_ring_init(&ring, samples, 4) );
+    REQUIRE( sizeof(SPSC_Indexes) >= 3 * KISS_CACHE_LINE );
+
+    Vec3 v;
+    REQUIRE( !vec3_ring_pop(&ring, &v) );
+
+    // fill, and go around the end of the memory a few times
+    size_t nbr_mismatches {0};
+    F_TYPE next_in {0.0};
+    F_TYPE next_out {0.0};
+    for (size_t round = 0; round < 5; round++){
+        while (true){
+            Vec3 const v_in {next_in, -next_in, 2.0 * next_in};
+            if (!vec3_ring_push(&ring, &v_in)){
+                break;
+            }
+            next_in += 1.0;
+        }
+        if (vec3_ring_size(&ring) != 4){
+            nbr_mismatches++;
+        }
+        for (size_t n = 0; n < 3; n++){
+            Vec3 const v_expected {next_out, -next_out, 2.0 * next_out};
+            if (!vec3_ring_pop(&ring, &v) || !vec3_equal(&v, &v_expected, 0.0)){
+                nbr_mismatches++;
+            }
+            next_out += 1.0;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+    REQUIRE( vec3_ring_size(&ring) == 1 );
+}
+
+TEST_CASE("vec3_ring_push_batch and vec3_ring_pop_batch"){
+    std::vector<Vec3> samples(8);
+    Vec3_Ring ring;
+    REQUIRE( vec3_ring_init(&ring, samples.data(), samples.size()) );
+
+    std::vector<Vec3> v_in(10);
+    for (size_t n = 0; n < v_in.size(); n++){
+        vec3_setter(&v_in[n], static_cast<F_TYPE>(n), 0.0, 1.0);
+    }
+    Vec3_View in_view;
+    vec3_view_of_array(&in_view, v_in.data(), v_in.size());
+
+    // only room for 8
+    REQUIRE( vec3_ring_push_batch(&ring, &in_view) == 8 );
+    REQUIRE( vec3_ring_push_batch(&ring, &in_view) == 0 );
+
+    std::vector<Vec3> v_out(5);
+    Vec3_View out_view;
+    vec3_view_of_array(&out_view, v_out.data(), v_out.size());
+    REQUIRE( vec3_ring_pop_batch(&ring, &out_view) == 5 );
+    REQUIRE( vec3_equal(&v_out[4], &v_in[4], 0.0) );
+
+    // wraps around the end of the memory
+    REQUIRE( vec3_ring_push_batch(&ring, &in_view) == 5 );
+    REQUIRE( vec3_ring_pop_batch(&ring, &out_view) == 5 );
+    REQUIRE( vec3_equal(&v_out[0], &v_in[5], 0.0) );
+    REQUIRE( vec3_equal(&v_out[2], &v_in[7], 0.0) );
+    REQUIRE( vec3_equal(&v_out[3], &v_in[0], 0.0) );
+    REQUIRE( vec3_ring_pop_batch(&ring, &out_view) == 3 );
+    REQUIRE( vec3_equal(&v_out[2], &v_in[4], 0.0) );
+    REQUIRE( vec3_ring_pop_batch(&ring, &out_view) == 0 );
+}
+
+TEST_CASE("quat_ring, between 2 threads"){
+    std::vector<Quat> samples(64);
+    Quat_Ring ring;
+    REQUIRE( quat_ring_init(&ring, samples.data(), samples.size()) );
+
+    size_t const count {200000};
+
+    // the producer pushes single samples and batches, the consumer pops batches; all
+    // the samples must come out once, in order
+    std::thread producer([&ring, count](){
+        Quat batch[7];
+        size_t next {0};
+        while (next < count){
+            if (next % 3 == 0){
+                Quat const q {static_cast<F_TYPE>(next), 1.0, 2.0, 3.0};
+                if (quat_ring_push(&ring, &q)){
+                    next++;
+                }
+                continue;
+            }
+            size_t batch_size = count - next < 7 ? count - next : 7;
+            for (size_t n = 0; n < batch_size; n++){
+                quat_setter(&batch[n], static_cast<F_TYPE>(next + n), 1.0, 2.0, 3.0);
+            }
+            Quat_View batch_view;
+            quat_view_of_array(&batch_view, batch, batch_size);
+            next += quat_ring_push_batch(&ring, &batch_view);
+        }
+    });
+
+    size_t nbr_mismatches {0};
+    size_t next {0};
+    Quat batch[5];
+    Quat_View batch_view;
+    quat_view_of_array(&batch_view, batch, 5);
+    while (next < count){
+        size_t popped = quat_ring_pop_batch(&ring, &batch_view);
+        for (size_t n = 0; n < popped; n++){
+            // F_TYPE holds the indexes exactly up to 2^24 in float
+            if (batch[n].r != static_cast<F_TYPE>(next) || batch[n].k != 3.0){
+                nbr_mismatches++;
+            }
+            next++;
+        }
+    }
+    producer.join();
+
+    REQUIRE( nbr_mismatches == 0 );
+    REQUIRE( quat_ring_size(&ring) == 0 );
+}
+
+TEST_CASE("quat_seqlock"){
+    Quat_Seqlock lock;
+    Quat const q_init {1.0, 0.0, 0.0, 0.0};
+    Quat q;
+    quat_seqlock_init(&lock, &q_init);
+    REQUIRE( quat_seqlock_read(&lock, &q) == 0 );
+    REQUIRE( quat_equal(&q, &q_init, 0.0) );
+
+    Quat const q_1 {0.0, 1.0, 0.0, 0.0};
+    quat_seqlock_write(&lock, &q_1);
+    REQUIRE( quat_seqlock_read(&lock, &q) == 1 );
+    REQUIRE( quat_equal(&q, &q_1, 0.0) );
+
+    // a writer thread publishes values with all their components equal: a reader
+    // must never see a mix of 2 values, nor versions going back
+    size_t const nbr_writes {200000};
+    std::thread writer([&lock, nbr_writes](){
+        for (size_t n = 2; n <= nbr_writes; n++){
+            F_TYPE x = static_cast<F_TYPE>(n);
+            Quat const q_n {x, x, x, x};
+            quat_seqlock_write(&lock, &q_n);
+        }
+    });
+
+    size_t nbr_mismatches {0};
+    uint64_t version {1};
+    while (version < nbr_writes){
+        uint64_t version_read = quat_seqlock_read(&lock, &q);
+        if (version_read < version){
+            nbr_mismatches++;
+        }
+        version = version_read;
+        if (version >= 2 && (q.r != q.i || q.r != q.j || q.r != q.k || q.r != static_cast<F_TYPE>(version))){
+            nbr_mismatches++;
+        }
+    }
+    writer.join();
+
+    REQUIRE( nbr_mismatches == 0 );
+}
@@ -0,0 +1,170 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+#include "../src/kiss_clang_3d_so3_sampling.h"
+
+#include <vector>
+
+// for rotations uniform over SO(3), the second moments of the quaternion components
+// are the identity / 4: each component squared averages 1 / 4, the products 0
+static double max_moment_error(std::vector<Quat> const & rotations){
+    double moments[4][4] = {};
+    for (Quat const & q : rotations){
+        double const components[4] = {F_TYPE_TO_DOUBLE(q.r), F_TYPE_TO_DOUBLE(q.i), F_TYPE_TO_DOUBLE(q.j), F_TYPE_TO_DOUBLE(q.k)};
+        for (size_t a = 0; a < 4; a++){
+            for (size_t b = 0; b < 4; b++){
+                moments[a][b] += components[a] * components[b];
+            }
+        }
+    }
+
+    double const quarter {0.25};
+    double max_error {0.0};
+    for (size_t a = 0; a < 4; a++){
+        for (size_t b = 0; b < 4; b++){
+            double error = moments[a][b] / static_cast<double>(rotations.size());
+            if (a == b){
+                error -= quarter;
+            }
+            max_error = error > max_error ? error : (-error > max_error ? -error : max_error);
+        }
+    }
+    return max_error;
+}
+
+// largest angle from random rotations to their nearest rotation of the set
+static F_TYPE covering_angle(std::vector<Quat> & rotations){
+    Quat_View view;
+    quat_view_of_array(&view, rotations.data(), rotations.size());
+
+    SO3_Rng rng;
+    so3_rng_seed(&rng, 123);
+    F_TYPE max_angle {0.0};
+    for (size_t n = 0; n < 500; n++){
+        Quat query;
+        so3_random(&rng, &query);
+        size_t index;
+        F_TYPE angle;
+        quat_nearest_batch(&query, &view, 1, &index, &angle);
+        max_angle = angle > max_angle ? angle : max_angle;
+    }
+    return max_angle;
+}
+
+TEST_CASE("so3_rng_seed and so3_rng_uniform"){
+    SO3_Rng rng_1;
+    SO3_Rng rng_2;
+    so3_rng_seed(&rng_1, 42);
+    so3_rng_seed(&rng_2, 42);
+
+    size_t nbr_mismatches {0};
+    double sum {0.0};
+    for (size_t n = 0; n < 10000; n++){
+        F_TYPE u = so3_rng_uniform(&rng_1);
+        if (u != so3_rng_uniform(&rng_2) || u < 0.0 || u > 1.0){
+            nbr_mismatches++;
+        }
+        sum += F_TYPE_TO_DOUBLE(u);
+    }
+    REQUIRE( nbr_mismatches == 0 );
+    double const nbr_draws {10000.0};
+    REQUIRE( sum / nbr_draws == Approx(0.5).margin(0.01) );
+
+    so3_rng_seed(&rng_2, 43);
+    REQUIRE( so3_rng_uniform(&rng_1) != so3_rng_uniform(&rng_2) );
+}
+
+TEST_CASE("so3_random and so3_random_batch"){
+    size_t const count {20000};
+    std::vector<Quat> rotations(count);
+    Quat_View view;
+    quat_view_of_array(&view, rotations.data(), count);
+
+    SO3_Rng rng;
+    so3_rng_seed(&rng, 1);
+    so3_random_batch(&rng, &view);
+
+    size_t nbr_not_unit {0};
+    for (Quat const & q : rotations){
+        if (!quat_is_unitary(&q, 1.0e-5)){
+            nbr_not_unit++;
+        }
+    }
+    REQUIRE( nbr_not_unit == 0 );
+    double const moment_tolerance {0.01};
+    REQUIRE( max_moment_error(rotations) < moment_tolerance );
+
+    // the batch is the sequence of single draws
+    so3_rng_seed(&rng, 1);
+    Quat q;
+    so3_random(&rng, &q);
+    REQUIRE( quat_equal(&q, &rotations[0], 0.0) );
+    so3_random(&rng, &q);
+    REQUIRE( quat_equal(&q, &rotations[1], 0.0) );
+}
+
+TEST_CASE("so3_fibonacci_grid"){
+    size_t const count {2000};
+    std::vector<Quat> rotations(count);
+    Quat_View view;
+    quat_view_of_array(&view, rotations.data(), count);
+    so3_fibonacci_grid(&view);
+
+    size_t nbr_not_unit {0};
+    for (Quat const & q : rotations){
+        if (!quat_is_unitary(&q, 1.0e-5)){
+            nbr_not_unit++;
+        }
+    }
+    REQUIRE( nbr_not_unit == 0 );
+    // much more even than random rotations of the same count
+    double const moment_tolerance {0.001};
+    REQUIRE( max_moment_error(rotations) < moment_tolerance );
+
+    // the grid is deterministic, and covers SO(3): the mean spacing of 2000 rotations
+    // is about 0.25 rad
+    std::vector<Quat> rotations_again(count);
+    Quat_View view_again;
+    quat_view_of_array(&view_again, rotations_again.data(), count);
+    so3_fibonacci_grid(&view_again);
+    REQUIRE( quat_equal(&rotations[1234], &rotations_again[1234], 0.0) );
+    REQUIRE( covering_angle(rotations) < 0.45 );
+}
+
+TEST_CASE("so3_hopf_grid"){
+    size_t const nbr_sphere {200};
+    size_t const nbr_circle {25};
+    std::vector<Quat> rotations(nbr_sphere * nbr_circle);
+    Quat_View view;
+    quat_view_of_array(&view, rotations.data(), rotations.size());
+    REQUIRE( so3_hopf_grid(nbr_sphere, nbr_circle, &view) == nbr_sphere * nbr_circle );
+
+    size_t nbr_not_unit {0};
+    for (Quat const & q : rotations){
+        if (!quat_is_unitary(&q, 1.0e-5)){
+            nbr_not_unit++;
+        }
+    }
+    REQUIRE( nbr_not_unit == 0 );
+    double const moment_tolerance {0.002};
+    REQUIRE( max_moment_error(rotations) < moment_tolerance );
+    REQUIRE( covering_angle(rotations) < 0.4 );
+
+    // the rotations around a direction: the rotation of the direction k stays on it
+    Vec3 const k {0.0, 0.0, 1.0};
+    Vec3 direction;
+    Vec3 rotated;
+    rotate_by_quat_R(&k, &rotations[3 * nbr_circle], &direction);
+    size_t nbr_mismatches {0};
+    for (size_t n = 1; n < nbr_circle; n++){
+        rotate_by_quat_R(&k, &rotations[3 * nbr_circle + n], &rotated);
+        if (!vec3_equal(&rotated, &direction, 1.0e-5)){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+
+    // too small output
+    Quat_View small_view;
+    quat_view_of_array(&small_view, rotations.data(), 30);
+    REQUIRE( so3_hopf_grid(nbr_sphere, nbr_circle, &small_view) == 30 );
+}
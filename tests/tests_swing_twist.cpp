@@ -0,0 +1,165 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+
+#include <cmath>
+#include <vector>
+
+// q and -q are the same rotation
+static bool same_rotation(Quat const * q_1, Quat const * q_2){
+    F_TYPE scalar = q_1->r * q_2->r + q_1->i * q_2->i + q_1->j * q_2->j + q_1->k * q_2->k;
+    return F_TYPE_ABS(F_TYPE_ABS(scalar) - 1.0) < 1.0e-5;
+}
+
+static Quat swing_twist_product(Vec3 const * swing_axis, F_TYPE swing_angle, Vec3 const * twist_axis, F_TYPE twist_angle){
+    Quat swing;
+    Quat twist;
+    Quat q;
+    rotation_to_quat(&swing, swing_axis, swing_angle);
+    rotation_to_quat(&twist, twist_axis, twist_angle);
+    quat_prod(&swing, &twist, &q);
+    return q;
+}
+
+TEST_CASE("quat_swing_twist"){
+    Vec3 const axis_i {1.0, 0.0, 0.0};
+    Vec3 const axis_ij {1.0, 1.0, 0.0};
+    Vec3 const axis_k {0.0, 0.0, 1.0};
+    Vec3 const axis_2k {0.0, 0.0, 2.0};
+
+    Quat swing_expected;
+    Quat twist_expected;
+    rotation_to_quat(&swing_expected, &axis_ij, 0.3);
+    rotation_to_quat(&twist_expected, &axis_k, 0.5);
+    Quat q;
+    quat_prod(&swing_expected, &twist_expected, &q);
+
+    Quat swing;
+    Quat twist;
+    REQUIRE( quat_swing_twist(&q, &axis_k, &swing, &twist) );
+    REQUIRE( quat_equal(&swing, &swing_expected) );
+    REQUIRE( quat_equal(&twist, &twist_expected) );
+
+    // the axis does not need to be normalized
+    REQUIRE( quat_swing_twist(&q, &axis_2k, &swing, &twist) );
+    REQUIRE( quat_equal(&swing, &swing_expected) );
+    REQUIRE( quat_equal(&twist, &twist_expected) );
+
+    // q = swing * twist, also for -q
+    Quat q_minus {-q.r, -q.i, -q.j, -q.k};
+    Quat q_back;
+    REQUIRE( quat_swing_twist(&q_minus, &axis_k, &swing, &twist) );
+    REQUIRE( twist.r >= 0.0 );
+    quat_prod(&swing, &twist, &q_back);
+    REQUIRE( quat_equal(&q_back, &q_minus) );
+
+    // a rotation of pi orthogonal to the axis: all swing
+    Quat const identity {1.0, 0.0, 0.0, 0.0};
+    rotation_to_quat(&q, &axis_i, F_TYPE_PI);
+    REQUIRE( quat_swing_twist(&q, &axis_k, &swing, &twist) );
+    REQUIRE( quat_equal(&twist, &identity) );
+    REQUIRE( quat_equal(&swing, &q) );
+
+    Vec3 const axis_null {0.0, 0.0, 0.0};
+    REQUIRE( !quat_swing_twist(&q, &axis_null, &swing, &twist) );
+}
+
+TEST_CASE("quat_clamp_to_limits"){
+    Vec3 const axis_i {1.0, 0.0, 0.0};
+    Vec3 const axis_k {0.0, 0.0, 1.0};
+    Vec3 const axis_null {0.0, 0.0, 0.0};
+
+    Joint_Limits limits;
+    REQUIRE( !joint_limits_setter(&limits, &axis_null, 0.5, -0.2, 0.4) );
+    REQUIRE( !joint_limits_setter(&limits, &axis_k, 0.5, 0.4, -0.2) );
+    REQUIRE( !joint_limits_setter(&limits, &axis_k, 4.0, -0.2, 0.4) );
+    REQUIRE( joint_limits_setter(&limits, &axis_k, 0.5, -0.2, 0.4) );
+
+    Quat q;
+    Quat q_out;
+    Quat q_expected;
+
+    // within the limits: untouched
+    q = swing_twist_product(&axis_i, 0.3, &axis_k, 0.1);
+    REQUIRE( !quat_clamp_to_limits(&q, &limits, &q_out) );
+    REQUIRE( quat_equal(&q_out, &q) );
+
+    // swing out of the cone
+    q = swing_twist_product(&axis_i, 0.8, &axis_k, 0.3);
+    q_expected = swing_twist_product(&axis_i, 0.5, &axis_k, 0.3);
+    REQUIRE( quat_clamp_to_limits(&q, &limits, &q_out) );
+    REQUIRE( same_rotation(&q_out, &q_expected) );
+
+    // twist out of its range, on both sides
+    q = swing_twist_product(&axis_i, 0.3, &axis_k, -1.0);
+    q_expected = swing_twist_product(&axis_i, 0.3, &axis_k, -0.2);
+    REQUIRE( quat_clamp_to_limits(&q, &limits, &q_out) );
+    REQUIRE( same_rotation(&q_out, &q_expected) );
+
+    q = swing_twist_product(&axis_i, 0.3, &axis_k, 3.0);
+    q_expected = swing_twist_product(&axis_i, 0.3, &axis_k, 0.4);
+    REQUIRE( quat_clamp_to_limits(&q, &limits, &q_out) );
+    REQUIRE( same_rotation(&q_out, &q_expected) );
+
+    // both
+    q = swing_twist_product(&axis_i, -2.0, &axis_k, -3.0);
+    q_expected = swing_twist_product(&axis_i, -0.5, &axis_k, -0.2);
+    REQUIRE( quat_clamp_to_limits(&q, &limits, &q_out) );
+    REQUIRE( same_rotation(&q_out, &q_expected) );
+}
+
+TEST_CASE("quat_clamp_to_limits_batch and quat_swing_twist_batch"){
+    Vec3 const twist_axis {0.0, 1.0, 1.0};
+    Joint_Limits limits;
+    REQUIRE( joint_limits_setter(&limits, &twist_axis, 0.7, -0.5, 1.0) );
+
+    size_t const count {1000};
+    std::vector<Quat> quats(count);
+    for (size_t n = 0; n < count; n++){
+        F_TYPE x = static_cast<F_TYPE>(n) / static_cast<F_TYPE>(count);
+        Vec3 const axis {std::cos(12.0 * x), std::sin(7.0 * x), x - 0.5};
+        rotation_to_quat(&quats[n], &axis, 6.0 * x - 3.0);
+    }
+
+    // the batch matches the single function, in place
+    std::vector<Quat> quats_expected(count);
+    size_t nbr_clamped_expected {0};
+    for (size_t n = 0; n < count; n++){
+        if (quat_clamp_to_limits(&quats[n], &limits, &quats_expected[n])){
+            nbr_clamped_expected++;
+        }
+    }
+
+    Quat_View view;
+    quat_view_of_array(&view, quats.data(), count);
+    size_t nbr_clamped = quat_clamp_to_limits_batch(&view, &limits, &view);
+    REQUIRE( nbr_clamped == nbr_clamped_expected );
+    REQUIRE( nbr_clamped > 0 );
+    REQUIRE( nbr_clamped < count );
+
+    // after clamping, all the swings and twists are within the limits
+    std::vector<Quat> swings(count);
+    std::vector<Quat> twists(count);
+    Quat_View swings_view;
+    Quat_View twists_view;
+    quat_view_of_array(&swings_view, swings.data(), count);
+    quat_view_of_array(&twists_view, twists.data(), count);
+    REQUIRE( quat_swing_twist_batch(&view, &twist_axis, &swings_view, &twists_view) );
+
+    size_t nbr_mismatches {0};
+    Vec3 unit_axis;
+    vec3_copy(&twist_axis, &unit_axis);
+    vec3_normalize(&unit_axis);
+    for (size_t n = 0; n < count; n++){
+        if (!quat_equal(&quats[n], &quats_expected[n])){
+            nbr_mismatches++;
+        }
+
+        F_TYPE swing_angle = 2.0 * std::acos(std::min(F_TYPE_ABS(swings[n].r), F_TYPE_1));
+        F_TYPE twist_sin_half = twists[n].i * unit_axis.i + twists[n].j * unit_axis.j + twists[n].k * unit_axis.k;
+        F_TYPE twist_angle = 2.0 * std::atan2(twist_sin_half, twists[n].r);
+        if (swing_angle > 0.7 + 1.0e-3 || twist_angle < -0.5 - 1.0e-3 || twist_angle > 1.0 + 1.0e-3){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+}
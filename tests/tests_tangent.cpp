@@ -0,0 +1,262 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+
+#include <vector>
+
+TEST_CASE("quat_exp"){
+    Quat q_res;
+    Quat q_expected;
+
+    // null vector: the identity
+    Vec3 const v_null {0.0, 0.0, 0.0};
+    Quat const identity {1.0, 0.0, 0.0, 0.0};
+    quat_exp(&v_null, &q_res);
+    REQUIRE( quat_equal(&q_res, &identity) );
+
+    // same as rotation_to_quat, with the norm of the vector as the angle
+    Vec3 const rotation_vectors[4] {
+        {0.0, 0.0, F_TYPE_PI / 2.0},
+        {0.3, -0.2, 0.943},
+        {-2.0, 1.0, 1.5},
+        {1.0e-3, 2.0e-3, -1.0e-3}
+    };
+    for (size_t n = 0; n < 4; n++){
+        quat_exp(&rotation_vectors[n], &q_res);
+        rotation_to_quat(&q_expected, &rotation_vectors[n], vec3_norm(&rotation_vectors[n]));
+        REQUIRE( quat_equal(&q_res, &q_expected) );
+        REQUIRE( quat_is_unitary(&q_res) );
+    }
+
+    // tiny vectors, in the Taylor expansion
+    Vec3 const v_tiny {1.0e-9, 0.0, 0.0};
+    quat_exp(&v_tiny, &q_res);
+    REQUIRE( q_res.r == Approx(1.0) );
+    REQUIRE( q_res.i == Approx(0.5e-9) );
+}
+
+TEST_CASE("quat_log"){
+    Vec3 v_res;
+    Quat q;
+
+    Quat const identity {1.0, 0.0, 0.0, 0.0};
+    Vec3 const v_null {0.0, 0.0, 0.0};
+    quat_log(&identity, &v_res);
+    REQUIRE( vec3_equal(&v_res, &v_null) );
+
+    // round trip with quat_exp, including close to 0 and close to pi
+    Vec3 const rotation_vectors[5] {
+        {0.0, 0.0, F_TYPE_PI / 2.0},
+        {0.3, -0.2, 0.943},
+        {-2.0, 1.0, 1.5},
+        {1.0e-3, 2.0e-3, -1.0e-3},
+        {1.0e-6, 0.0, 0.0}
+    };
+    for (size_t n = 0; n < 5; n++){
+        quat_exp(&rotation_vectors[n], &q);
+        quat_log(&q, &v_res);
+        REQUIRE( vec3_equal(&v_res, &rotation_vectors[n], 1.0e-5) );
+
+        // q and -q are the same rotation
+        quat_setter(&q, -q.r, -q.i, -q.j, -q.k);
+        quat_log(&q, &v_res);
+        REQUIRE( vec3_equal(&v_res, &rotation_vectors[n], 1.0e-5) );
+    }
+
+    // a rotation of 3 pi / 2 around k is a rotation of - pi / 2
+    Vec3 const axis_k {0.0, 0.0, 1.0};
+    rotation_to_quat(&q, &axis_k, 3.0 * F_TYPE_PI / 2.0);
+    quat_log(&q, &v_res);
+    Vec3 const v_expected {0.0, 0.0, -F_TYPE_PI / 2.0};
+    REQUIRE( vec3_equal(&v_res, &v_expected, 1.0e-5) );
+
+    // a rotation of pi
+    rotation_to_quat(&q, &axis_k, F_TYPE_PI);
+    quat_log(&q, &v_res);
+    REQUIRE( F_TYPE_ABS(v_res.k) == Approx(F_TYPE_PI) );
+}
+
+TEST_CASE("quat_boxplus and quat_boxminus"){
+    Vec3 const axis {1.0, 2.0, 3.0};
+    Quat q_1;
+    Quat q_2;
+    rotation_to_quat(&q_1, &axis, 0.943);
+    rotation_to_quat(&q_2, &axis, -0.3);
+
+    Vec3 delta;
+    Quat q_res;
+    quat_boxminus(&q_1, &q_2, &delta);
+    quat_boxplus(&q_2, &delta, &q_res);
+    REQUIRE( quat_equal(&q_res, &q_1) );
+
+    // both rotations around the same axis: the difference is along it
+    Vec3 delta_expected;
+    vec3_copy(&axis, &delta_expected);
+    vec3_normalize(&delta_expected);
+    vec3_scale(&delta_expected, 0.943 + 0.3);
+    REQUIRE( vec3_equal(&delta, &delta_expected, 1.0e-5) );
+
+    // a perturbation in the local frame
+    Vec3 const delta_k {0.0, 0.0, 0.1};
+    quat_boxplus(&q_1, &delta_k, &q_res);
+    quat_boxminus(&q_res, &q_1, &delta);
+    REQUIRE( vec3_equal(&delta, &delta_k, 1.0e-5) );
+}
+
+TEST_CASE("quat_exp_batch, quat_log_batch, quat_boxplus_batch, quat_boxminus_batch"){
+    size_t const count {100};
+    std::vector<Vec3> rotation_vectors(count);
+    std::vector<Vec3> rotation_vectors_back(count);
+    std::vector<Quat> quats(count);
+    std::vector<Quat> quats_perturbed(count);
+
+    for (size_t n = 0; n < count; n++){
+        F_TYPE x = static_cast<F_TYPE>(n) / static_cast<F_TYPE>(count);
+        vec3_setter(&rotation_vectors[n], x, 1.0 - 2.0 * x, 0.5 * x);
+    }
+
+    Vec3_View v_view;
+    Vec3_View v_back_view;
+    Quat_View q_view;
+    Quat_View q_perturbed_view;
+    vec3_view_of_array(&v_view, rotation_vectors.data(), count);
+    vec3_view_of_array(&v_back_view, rotation_vectors_back.data(), count);
+    quat_view_of_array(&q_view, quats.data(), count);
+    quat_view_of_array(&q_perturbed_view, quats_perturbed.data(), count);
+
+    quat_exp_batch(&v_view, &q_view);
+    quat_log_batch(&q_view, &v_back_view);
+
+    size_t nbr_mismatches {0};
+    Quat q_expected;
+    for (size_t n = 0; n < count; n++){
+        quat_exp(&rotation_vectors[n], &q_expected);
+        if (!quat_equal(&quats[n], &q_expected) || !vec3_equal(&rotation_vectors_back[n], &rotation_vectors[n], 1.0e-5)){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+
+    // perturb every quaternion by its own rotation vector, and measure it back
+    quat_boxplus_batch(&q_view, &v_view, &q_perturbed_view);
+    quat_boxminus_batch(&q_perturbed_view, &q_view, &v_back_view);
+
+    for (size_t n = 0; n < count; n++){
+        if (!vec3_equal(&rotation_vectors_back[n], &rotation_vectors[n], 1.0e-5)){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+
+    // in place
+    quat_boxplus_batch(&q_view, &v_view, &q_view);
+    for (size_t n = 0; n < count; n++){
+        if (!quat_equal(&quats[n], &quats_perturbed[n])){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+}
+
+TEST_CASE("quat_angular_velocity and its batch versions"){
+    // attitudes integrated from known body angular velocities, every dt
+    size_t const count {200};
+    F_TYPE const dt {0.01};
+    std::vector<Vec3> velocities(count - 1);
+    std::vector<Quat> attitudes(count);
+    std::vector<F_TYPE> times(count);
+    quat_setter(&attitudes[0], 1.0, 0.0, 0.0, 0.0);
+    times[0] = 0.0;
+    for (size_t n = 0; n + 1 < count; n++){
+        F_TYPE x = static_cast<F_TYPE>(n) * dt;
+        vec3_setter(&velocities[n], F_TYPE_SIN(x), 2.0 * F_TYPE_COS(3.0 * x), 0.5);
+        // non uniform times, for the second batch version
+        F_TYPE crrt_dt = n % 2 == 0 ? dt : 2.0 * dt;
+        Vec3 delta {velocities[n].i * crrt_dt, velocities[n].j * crrt_dt, velocities[n].k * crrt_dt};
+        quat_boxplus(&attitudes[n], &delta, &attitudes[n + 1]);
+        times[n + 1] = times[n] + crrt_dt;
+    }
+
+    Vec3 w;
+    quat_angular_velocity(&attitudes[0], &attitudes[1], dt, &w);
+    REQUIRE( vec3_equal(&w, &velocities[0], 1.0e-3) );
+
+    std::vector<Vec3> w_batch(count - 1);
+    Quat_View q_view;
+    Vec3_View w_view;
+    quat_view_of_array(&q_view, attitudes.data(), count);
+    vec3_view_of_array(&w_view, w_batch.data(), count - 1);
+
+    REQUIRE( quat_angular_velocity_times_batch(&q_view, times.data(), &w_view) == count - 1 );
+    size_t nbr_mismatches {0};
+    for (size_t n = 0; n + 1 < count; n++){
+        if (!vec3_equal(&w_batch[n], &velocities[n], 1.0e-3)){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+
+    // the uniform version is the pairwise velocity
+    REQUIRE( quat_angular_velocity_batch(&q_view, dt, &w_view) == count - 1 );
+    for (size_t n = 0; n + 1 < count; n++){
+        quat_angular_velocity(&attitudes[n], &attitudes[n + 1], dt, &w);
+        if (!vec3_equal(&w_batch[n], &w, 0.0)){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+
+    // very small rotations between close samples keep their precision
+    Vec3 const w_small {1.0e-3, -2.0e-3, 0.5e-3};
+    F_TYPE const dt_small {1.0e-3};
+    Vec3 const delta_small {w_small.i * dt_small, w_small.j * dt_small, w_small.k * dt_small};
+    Quat const identity {1.0, 0.0, 0.0, 0.0};
+    Quat q_small;
+    quat_boxplus(&identity, &delta_small, &q_small);
+    quat_angular_velocity(&identity, &q_small, dt_small, &w);
+    REQUIRE( w.i == Approx(w_small.i).epsilon(1.0e-3) );
+    REQUIRE( w.j == Approx(w_small.j).epsilon(1.0e-3) );
+    REQUIRE( w.k == Approx(w_small.k).epsilon(1.0e-3) );
+
+    // same as quat_boxminus / dt, also for differences with a negative real part, and
+    // for rotations far below the range of the series of quat_log
+    std::vector<Quat> flipped(attitudes);
+    for (size_t n = 0; n < count; n += 3){
+        quat_setter(&flipped[n], -flipped[n].r, -flipped[n].i, -flipped[n].j, -flipped[n].k);
+    }
+    for (size_t n = 0; n + 1 < count; n++){
+        Vec3 expected;
+        quat_boxminus(&flipped[n + 1], &flipped[n], &expected);
+        vec3_scale(&expected, 1.0 / dt);
+        quat_angular_velocity(&flipped[n], &flipped[n + 1], dt, &w);
+        if (!vec3_equal(&w, &expected, 1.0e-3)){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+
+    F_TYPE const tiny {1.0e-18};
+    Vec3 const delta_tiny {tiny, -2.0 * tiny, 0.0};
+    Quat q_tiny;
+    quat_boxplus(&identity, &delta_tiny, &q_tiny);
+    quat_angular_velocity(&identity, &q_tiny, 1.0, &w);
+    REQUIRE( w.i / tiny == Approx(1.0).epsilon(1.0e-5) );
+    REQUIRE( w.j / tiny == Approx(-2.0).epsilon(1.0e-5) );
+    REQUIRE( w.k == 0.0 );
+
+    // intervals that are not > 0 give a null velocity
+    quat_angular_velocity(&attitudes[0], &attitudes[1], 0.0, &w);
+    REQUIRE( vec3_norm(&w) == 0.0 );
+    quat_angular_velocity(&attitudes[0], &attitudes[1], -dt, &w);
+    REQUIRE( vec3_norm(&w) == 0.0 );
+
+    // a null interval, a too small output, and a single attitude
+    times[5] = times[4];
+    REQUIRE( quat_angular_velocity_times_batch(&q_view, times.data(), &w_view) == count - 1 );
+    REQUIRE( vec3_norm(&w_batch[4]) == 0.0 );
+    Vec3_View w_small_view;
+    vec3_view_of_array(&w_small_view, w_batch.data(), 10);
+    REQUIRE( quat_angular_velocity_batch(&q_view, dt, &w_small_view) == 10 );
+    Quat_View q_single_view;
+    quat_view_of_array(&q_single_view, attitudes.data(), 1);
+    REQUIRE( quat_angular_velocity_batch(&q_single_view, dt, &w_view) == 0 );
+}
@@ -0,0 +1,171 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+
+#include <vector>
+
+TEST_CASE("va_rot_setter and va_rot_copy"){
+    Vec3 const axis {1.0, 2.0, 3.0};
+    VA_Rot va;
+    VA_Rot va_copy;
+
+    va_rot_setter(&va, &axis, 0.5);
+    REQUIRE( vec3_equal(&va.axis, &axis) );
+    REQUIRE( va.angle_rad == Approx(0.5) );
+
+    va_rot_copy(&va, &va_copy);
+    REQUIRE( vec3_equal(&va_copy.axis, &axis) );
+    REQUIRE( va_copy.angle_rad == Approx(0.5) );
+}
+
+TEST_CASE("va_rot_canonicalize"){
+    Vec3 const axis {0.0, 0.0, 2.0};
+    Vec3 const axis_k {0.0, 0.0, 1.0};
+    Vec3 const axis_mk {0.0, 0.0, -1.0};
+    VA_Rot va;
+
+    // unit axis
+    va_rot_setter(&va, &axis, 0.5);
+    REQUIRE( va_rot_canonicalize(&va) );
+    REQUIRE( vec3_equal(&va.axis, &axis_k) );
+    REQUIRE( va.angle_rad == Approx(0.5) );
+
+    // negative angle: opposite axis
+    va_rot_setter(&va, &axis, -0.5);
+    REQUIRE( va_rot_canonicalize(&va) );
+    REQUIRE( vec3_equal(&va.axis, &axis_mk) );
+    REQUIRE( va.angle_rad == Approx(0.5) );
+
+    // modulo 2 pi: 3 pi / 2 is - pi / 2
+    va_rot_setter(&va, &axis, 3.0 * F_TYPE_PI / 2.0);
+    REQUIRE( va_rot_canonicalize(&va) );
+    REQUIRE( vec3_equal(&va.axis, &axis_mk) );
+    REQUIRE( va.angle_rad == Approx(F_TYPE_PI / 2.0) );
+
+    va_rot_setter(&va, &axis, 0.5 - 4.0 * F_TYPE_PI);
+    REQUIRE( va_rot_canonicalize(&va) );
+    REQUIRE( vec3_equal(&va.axis, &axis_k, 1.0e-5) );
+    REQUIRE( va.angle_rad == Approx(0.5) );
+
+    // pi around -k is pi around k
+    va_rot_setter(&va, &axis_mk, F_TYPE_PI);
+    REQUIRE( va_rot_canonicalize(&va) );
+    REQUIRE( vec3_equal(&va.axis, &axis_k) );
+    REQUIRE( va.angle_rad == Approx(F_TYPE_PI) );
+
+    // null axis: only valid for the identity
+    Vec3 const axis_null {0.0, 0.0, 0.0};
+    va_rot_setter(&va, &axis_null, 0.0);
+    REQUIRE( va_rot_canonicalize(&va) );
+    REQUIRE( va.angle_rad == Approx(0.0) );
+    REQUIRE( vec3_norm(&va.axis) == Approx(1.0) );
+
+    va_rot_setter(&va, &axis_null, 0.5);
+    REQUIRE( !va_rot_canonicalize(&va) );
+}
+
+TEST_CASE("va_rot_equal and va_rot_is_identity"){
+    Vec3 const axis {1.0, 2.0, 3.0};
+    Vec3 const axis_scaled {2.0, 4.0, 6.0};
+    Vec3 const axis_opposite {-1.0, -2.0, -3.0};
+    VA_Rot va_1;
+    VA_Rot va_2;
+
+    va_rot_setter(&va_1, &axis, 0.5);
+    va_rot_setter(&va_2, &axis_scaled, 0.5);
+    REQUIRE( va_rot_equal(&va_1, &va_2) );
+
+    va_rot_setter(&va_2, &axis_opposite, -0.5);
+    REQUIRE( va_rot_equal(&va_1, &va_2) );
+
+    // a full turn more: the opposite quaternion, but the same rotation
+    va_rot_setter(&va_2, &axis, 0.5 + 2.0 * F_TYPE_PI);
+    REQUIRE( va_rot_equal(&va_1, &va_2, 1.0e-5) );
+
+    va_rot_setter(&va_2, &axis, 0.6);
+    REQUIRE( !va_rot_equal(&va_1, &va_2) );
+
+    REQUIRE( !va_rot_is_identity(&va_1) );
+    va_rot_setter(&va_2, &axis, 0.0);
+    REQUIRE( va_rot_is_identity(&va_2) );
+    va_rot_setter(&va_2, &axis, 2.0 * F_TYPE_PI);
+    REQUIRE( va_rot_is_identity(&va_2, 1.0e-5) );
+
+    Vec3 const axis_null {0.0, 0.0, 0.0};
+    va_rot_setter(&va_2, &axis_null, 0.0);
+    REQUIRE( va_rot_is_identity(&va_2) );
+}
+
+TEST_CASE("va_rot_to_quat and va_rot_from_quat"){
+    Vec3 const axis {1.0, 2.0, 3.0};
+    VA_Rot va;
+    VA_Rot va_back;
+    Quat q;
+    Quat q_expected;
+
+    va_rot_setter(&va, &axis, 0.943);
+    REQUIRE( va_rot_to_quat(&va, &q) );
+    rotation_to_quat(&q_expected, &axis, 0.943);
+    REQUIRE( quat_equal(&q, &q_expected) );
+
+    // back, in the canonical form, also from -q
+    REQUIRE( va_rot_from_quat(&q, &va_back) );
+    VA_Rot va_canonical;
+    va_rot_copy(&va, &va_canonical);
+    va_rot_canonicalize(&va_canonical);
+    REQUIRE( vec3_equal(&va_back.axis, &va_canonical.axis) );
+    REQUIRE( va_back.angle_rad == Approx(va_canonical.angle_rad) );
+
+    quat_setter(&q, -q.r, -q.i, -q.j, -q.k);
+    REQUIRE( va_rot_from_quat(&q, &va_back) );
+    REQUIRE( vec3_equal(&va_back.axis, &va_canonical.axis) );
+    REQUIRE( va_back.angle_rad == Approx(va_canonical.angle_rad) );
+
+    // small angles, where acos would lose the precision
+    va_rot_setter(&va, &axis, 1.0e-4);
+    va_rot_to_quat(&va, &q);
+    REQUIRE( va_rot_from_quat(&q, &va_back) );
+    REQUIRE( va_back.angle_rad == Approx(1.0e-4).epsilon(1.0e-3) );
+
+    // identity, and non unit quaternions
+    Quat const identity {1.0, 0.0, 0.0, 0.0};
+    REQUIRE( va_rot_from_quat(&identity, &va_back) );
+    REQUIRE( va_back.angle_rad == Approx(0.0) );
+    REQUIRE( va_rot_is_identity(&va_back) );
+
+    Quat const q_2 {2.0, 0.0, 0.0, 0.0};
+    REQUIRE( !va_rot_from_quat(&q_2, &va_back) );
+}
+
+TEST_CASE("va_rot_to_quat_batch and va_rot_from_quat_batch"){
+    size_t const count {100};
+    std::vector<VA_Rot> va_in(count);
+    std::vector<VA_Rot> va_back(count);
+    std::vector<Quat> quats(count);
+
+    for (size_t n = 0; n < count; n++){
+        F_TYPE x = static_cast<F_TYPE>(n) / static_cast<F_TYPE>(count);
+        Vec3 const axis {1.0 - x, x, 0.5};
+        va_rot_setter(&va_in[n], &axis, 10.0 * x - 5.0);
+    }
+    // an invalid one
+    Vec3 const axis_null {0.0, 0.0, 0.0};
+    va_rot_setter(&va_in[50], &axis_null, 1.0);
+
+    Quat_View q_view;
+    quat_view_of_array(&q_view, quats.data(), count);
+
+    REQUIRE( va_rot_to_quat_batch(va_in.data(), count, &q_view) == count - 1 );
+    REQUIRE( va_rot_from_quat_batch(&q_view, va_back.data(), count) == count );
+
+    size_t nbr_mismatches {0};
+    for (size_t n = 0; n < count; n++){
+        if (n != 50 && !va_rot_equal(&va_in[n], &va_back[n], 1.0e-5)){
+            nbr_mismatches++;
+        }
+        if (va_back[n].angle_rad < 0.0 || va_back[n].angle_rad > F_TYPE_PI){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+    REQUIRE( va_rot_is_identity(&va_back[50]) );
+}
@@ -0,0 +1,276 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+#include "../src/kiss_clang_3d_extra_utils.h"
+
+// an interleaved vertex, as found in typical vertex buffers; the components are always
+// float, whatever the F_TYPE used by the library
+struct Vertex {
+    float position[3];
+    float normal[3];
+    unsigned char color[4];
+};
+
+static void view_of_positions(Vec3_View * view, Vertex * vertices, size_t count){
+    vec3_view_setter(
+        view, vertices, sizeof(Vertex), count,
+        offsetof(Vertex, position), offsetof(Vertex, position) + sizeof(float), offsetof(Vertex, position) + 2 * sizeof(float),
+        'F'
+    );
+}
+
+static void view_of_normals(Vec3_View * view, Vertex * vertices, size_t count){
+    vec3_view_setter(
+        view, vertices, sizeof(Vertex), count,
+        offsetof(Vertex, normal), offsetof(Vertex, normal) + sizeof(float), offsetof(Vertex, normal) + 2 * sizeof(float),
+        'F'
+    );
+}
+
+TEST_CASE("Vec3_View get and set"){
+    Vertex vertices[2] {
+        {{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}, {1, 2, 3, 4}},
+        {{7.0f, 8.0f, 9.0f}, {10.0f, 11.0f, 12.0f}, {5, 6, 7, 8}}
+    };
+
+    Vec3_View positions;
+    view_of_positions(&positions, vertices, 2);
+
+    Vec3 v_res;
+    Vec3 const v_0 {1.0, 2.0, 3.0};
+    Vec3 const v_1 {7.0, 8.0, 9.0};
+
+    vec3_view_get(&positions, 0, &v_res);
+    REQUIRE( vec3_equal(&v_res, &v_0) );
+    vec3_view_get(&positions, 1, &v_res);
+    REQUIRE( vec3_equal(&v_res, &v_1) );
+
+    Vec3 const v_new {-1.0, -2.0, -3.0};
+    vec3_view_set(&positions, 1, &v_new);
+    REQUIRE( vertices[1].position[0] == -1.0f );
+    REQUIRE( vertices[1].position[1] == -2.0f );
+    REQUIRE( vertices[1].position[2] == -3.0f );
+
+    // the neighbours in the interleaved buffer are untouched
+    REQUIRE( vertices[1].normal[0] == 10.0f );
+    REQUIRE( vertices[1].color[0] == 5 );
+    REQUIRE( vertices[0].position[0] == 1.0f );
+}
+
+TEST_CASE("Vec3_View of array"){
+    Vec3 array[3] {
+        {1.0, 2.0, 3.0},
+        {4.0, 5.0, 6.0},
+        {7.0, 8.0, 9.0}
+    };
+
+    Vec3_View view;
+    vec3_view_of_array(&view, array, 3);
+
+    Vec3 v_res;
+    vec3_view_get(&view, 2, &v_res);
+    REQUIRE( vec3_equal(&v_res, &array[2]) );
+}
+
+TEST_CASE("Quat_View get and set"){
+    // quaternions stored as double, in (i, j, k, r) order
+    double buffer[8] {0.0, 0.0, 0.0, 1.0, 1.0, 2.0, 3.0, 4.0};
+
+    Quat_View view;
+    quat_view_setter(&view, buffer, 4 * sizeof(double), 2, 3 * sizeof(double), 0, sizeof(double), 2 * sizeof(double), 'D');
+
+    Quat q_res;
+    Quat const q_0 {1.0, 0.0, 0.0, 0.0};
+    Quat const q_1 {4.0, 1.0, 2.0, 3.0};
+
+    quat_view_get(&view, 0, &q_res);
+    REQUIRE( quat_equal(&q_res, &q_0) );
+    quat_view_get(&view, 1, &q_res);
+    REQUIRE( quat_equal(&q_res, &q_1) );
+
+    Quat const q_new {5.0, 6.0, 7.0, 8.0};
+    quat_view_set(&view, 0, &q_new);
+    REQUIRE( buffer[3] == Approx(5.0) );
+    REQUIRE( buffer[0] == Approx(6.0) );
+    REQUIRE( buffer[1] == Approx(7.0) );
+    REQUIRE( buffer[2] == Approx(8.0) );
+}
+
+TEST_CASE("rotate_by_quat_R_batch"){
+    F_TYPE sqrt_2_o_2 {0.7071067811865476};
+    Quat const quat_rot_k {sqrt_2_o_2, 0.0, 0.0, sqrt_2_o_2};
+
+    Vertex vertices[3] {
+        {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {1, 2, 3, 4}},
+        {{0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1, 2, 3, 4}},
+        {{1.0f, 2.0f, 3.0f}, {1.0f, 0.0f, 0.0f}, {1, 2, 3, 4}}
+    };
+
+    Vec3_View positions;
+    view_of_positions(&positions, vertices, 3);
+
+    // rotate in place, compare with the single vector function
+    Vec3 expected[3];
+    for (size_t n = 0; n < 3; n++){
+        Vec3 crrt;
+        vec3_view_get(&positions, n, &crrt);
+        rotate_by_quat_R(&crrt, &quat_rot_k, &expected[n]);
+    }
+
+    rotate_by_quat_R_batch(&positions, &quat_rot_k, &positions);
+
+    Vec3 v_res;
+    for (size_t n = 0; n < 3; n++){
+        vec3_view_get(&positions, n, &v_res);
+        REQUIRE( vec3_equal(&v_res, &expected[n], 1.0e-5) );
+    }
+
+    // out of place, from the float interleaved buffer into an array of Vec3
+    Vec3 rotated_normals[3];
+    Vec3_View normals;
+    Vec3_View normals_out;
+    view_of_normals(&normals, vertices, 3);
+    vec3_view_of_array(&normals_out, rotated_normals, 3);
+
+    rotate_by_quat_R_batch(&normals, &quat_rot_k, &normals_out);
+
+    Vec3 const axis_i {1.0, 0.0, 0.0};
+    Vec3 const axis_j {0.0, 1.0, 0.0};
+    Vec3 const axis_k {0.0, 0.0, 1.0};
+    Vec3 const axis_mi {-1.0, 0.0, 0.0};
+
+    REQUIRE( vec3_equal(&rotated_normals[0], &axis_mi, 1.0e-5) );
+    REQUIRE( vec3_equal(&rotated_normals[1], &axis_k, 1.0e-5) );
+    REQUIRE( vec3_equal(&rotated_normals[2], &axis_j, 1.0e-5) );
+
+    // the normals themselves are untouched
+    vec3_view_get(&normals, 2, &v_res);
+    REQUIRE( vec3_equal(&v_res, &axis_i) );
+}
+
+TEST_CASE("vec3_normalize_batch"){
+    Vertex vertices[3] {
+        {{0.0f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f}, {1, 2, 3, 4}},
+        {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {1, 2, 3, 4}},
+        {{0.0f, 0.0f, 0.0f}, {1.0f, 2.0f, 3.0f}, {1, 2, 3, 4}}
+    };
+
+    Vec3_View normals;
+    view_of_normals(&normals, vertices, 3);
+
+    size_t nbr_normalized = vec3_normalize_batch(&normals);
+    REQUIRE( nbr_normalized == 2 );
+
+    Vec3 const v0_res {1.0, 0.0, 0.0};
+    Vec3 const v1_res {0.0, 0.0, 0.0};
+    Vec3 const v2_res {0.2672612419124244, 0.5345224838248488, 0.8017837257372732};
+    Vec3 v_res;
+
+    vec3_view_get(&normals, 0, &v_res);
+    REQUIRE( vec3_equal(&v_res, &v0_res) );
+    vec3_view_get(&normals, 1, &v_res);
+    REQUIRE( vec3_equal(&v_res, &v1_res) );
+    vec3_view_get(&normals, 2, &v_res);
+    REQUIRE( vec3_equal(&v_res, &v2_res, 1.0e-5) );
+}
+
+TEST_CASE("vec3_scale_batch and vec3_add_batch"){
+    Vec3 array[2] {
+        {1.0, 2.0, 3.0},
+        {4.0, 5.0, 6.0}
+    };
+
+    Vec3_View view;
+    vec3_view_of_array(&view, array, 2);
+
+    vec3_scale_batch(&view, 2.0);
+
+    Vec3 const translation {1.0, 1.0, 1.0};
+    vec3_add_batch(&view, &translation);
+
+    Vec3 const v0_res {3.0, 5.0, 7.0};
+    Vec3 const v1_res {9.0, 11.0, 13.0};
+
+    REQUIRE( vec3_equal(&array[0], &v0_res) );
+    REQUIRE( vec3_equal(&array[1], &v1_res) );
+}
+
+TEST_CASE("quat_prod_batch"){
+    Quat const q_i {0.0, 1.0, 0.0, 0.0};
+    Quat const q_j {0.0, 0.0, 1.0, 0.0};
+    Quat const q_k {0.0, 0.0, 0.0, 1.0};
+    Quat const q_mr {-1.0, 0.0, 0.0, 0.0};
+
+    // float quaternions, in (r, i, j, k) order
+    float buffer[8] {0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+    Quat_View view_in;
+    quat_view_setter(&view_in, buffer, 4 * sizeof(float), 2, 0, sizeof(float), 2 * sizeof(float), 3 * sizeof(float), 'F');
+
+    Quat results[2];
+    Quat_View view_out;
+    quat_view_of_array(&view_out, results, 2);
+
+    quat_prod_batch(&q_i, &view_in, &view_out);
+
+    // i * i = -1, i * j = k
+    REQUIRE( quat_equal(&results[0], &q_mr) );
+    REQUIRE( quat_equal(&results[1], &q_k) );
+
+    // in place
+    quat_prod_batch(&q_j, &view_out, &view_out);
+    // j * -1 = -j, j * k = i
+    Quat const q_mj {0.0, 0.0, -1.0, 0.0};
+    REQUIRE( quat_equal(&results[0], &q_mj) );
+    REQUIRE( quat_equal(&results[1], &q_i) );
+}
+
+TEST_CASE("vec3_view_slice and quat_view_slice"){
+    // float vectors, interleaved with an extra float
+    float buffer[12] {0.0f, 1.0f, 2.0f, -1.0f, 3.0f, 4.0f, 5.0f, -1.0f, 6.0f, 7.0f, 8.0f, -1.0f};
+    Vec3_View view;
+    vec3_view_setter(&view, buffer, 4 * sizeof(float), 3, 0, sizeof(float), 2 * sizeof(float), 'F');
+
+    Vec3_View slice;
+    vec3_view_slice(&view, 1, 5, &slice);
+    REQUIRE( slice.count == 2 );
+    Vec3 v;
+    vec3_view_get(&slice, 0, &v);
+    Vec3 const v_expected {3.0, 4.0, 5.0};
+    REQUIRE( vec3_equal(&v, &v_expected) );
+
+    vec3_view_slice(&view, 4, 1, &slice);
+    REQUIRE( slice.count == 0 );
+
+    Quat quats[3] {{1.0, 0.0, 0.0, 0.0}, {0.0, 1.0, 0.0, 0.0}, {0.0, 0.0, 1.0, 0.0}};
+    Quat_View q_view;
+    quat_view_of_array(&q_view, quats, 3);
+    Quat_View q_slice;
+    quat_view_slice(&q_view, 2, 1, &q_slice);
+    REQUIRE( q_slice.count == 1 );
+    Quat q;
+    quat_view_get(&q_slice, 0, &q);
+    REQUIRE( quat_equal(&q, &quats[2]) );
+}
+
+TEST_CASE("view setters reject unknown component types"){
+    float buffer[8] {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f};
+
+    Vec3_View view;
+    REQUIRE( vec3_view_setter(&view, buffer, 3 * sizeof(float), 2, 0, sizeof(float), 2 * sizeof(float), 'F') );
+    REQUIRE( view.count == 2 );
+
+    // for example a lower case type, or an int type, is not silently read as float
+    REQUIRE_FALSE( vec3_view_setter(&view, buffer, 3 * sizeof(float), 2, 0, sizeof(float), 2 * sizeof(float), 'f') );
+    REQUIRE( view.count == 0 );
+    REQUIRE( view.component_type == 'F' );
+
+    Quat_View q_view;
+    REQUIRE( quat_view_setter(&q_view, buffer, 4 * sizeof(float), 2, 0, sizeof(float), 2 * sizeof(float), 3 * sizeof(float), 'B') );
+    REQUIRE( q_view.count == 2 );
+    REQUIRE_FALSE( quat_view_setter(&q_view, buffer, 4 * sizeof(float), 2, 0, sizeof(float), 2 * sizeof(float), 3 * sizeof(float), 'I') );
+    REQUIRE( q_view.count == 0 );
+
+    // the batch functions do nothing over the empty views
+    Quat const q_i {0.0, 1.0, 0.0, 0.0};
+    rotate_by_quat_R_batch(&view, &q_i, &view);
+    REQUIRE( buffer[1] == 2.0f );
+}
@@ -0,0 +1,256 @@
+#include "catch.hpp"
+#include "../src/kiss_clang_3d.h"
+#include "../src/kiss_clang_3d_voxel_grid.h"
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <vector>
+
+TEST_CASE("voxel_grid_init and voxel_grid_coords"){
+    Voxel_Grid grid;
+    Voxel voxels[8];
+    size_t slots[16];
+
+    REQUIRE( !voxel_grid_init(&grid, 0.0, voxels, 8, slots, 16) );
+    REQUIRE( !voxel_grid_init(&grid, 0.5, voxels, 8, slots, 12) );
+    REQUIRE( !voxel_grid_init(&grid, 0.5, voxels, 8, slots, 8) );
+    REQUIRE( voxel_grid_init(&grid, 0.5, voxels, 8, slots, 16) );
+
+    Vec3 const point {1.2, -0.2, 0.0};
+    int64_t coords[3];
+    REQUIRE( voxel_grid_coords(&grid, &point, coords) );
+    REQUIRE( coords[0] == 2 );
+    REQUIRE( coords[1] == -1 );
+    REQUIRE( coords[2] == 0 );
+    REQUIRE( voxel_grid_find(&grid, coords) == VOXEL_GRID_NOT_FOUND );
+}
+
+TEST_CASE("voxel_grid_insert, centroids and lists of points"){
+    Voxel_Grid grid;
+    Voxel voxels[4];
+    size_t slots[8];
+    Vec3 points[5];
+    size_t next_points[5];
+    REQUIRE( voxel_grid_init(&grid, 1.0, voxels, 4, slots, 8, points, next_points, 5) );
+
+    Vec3 const p_1 {0.1, 0.2, 0.3};
+    Vec3 const p_2 {0.3, 0.4, 0.5};
+    Vec3 const p_3 {0.5, 0.9, 0.1};
+    Vec3 const p_other {-0.5, 0.5, 0.5};
+
+    REQUIRE( voxel_grid_insert(&grid, &p_1) == 0 );
+    REQUIRE( voxel_grid_insert(&grid, &p_other) == 1 );
+    REQUIRE( voxel_grid_insert(&grid, &p_2) == 0 );
+    REQUIRE( voxel_grid_insert(&grid, &p_3) == 0 );
+    REQUIRE( grid.nbr_voxels == 2 );
+    REQUIRE( voxels[0].count == 3 );
+
+    Vec3 const centroid_expected {0.3, 0.5, 0.3};
+    REQUIRE( vec3_equal(&voxels[0].centroid, &centroid_expected) );
+    REQUIRE( vec3_equal(&voxels[1].centroid, &p_other) );
+
+    // the points of voxel 0, most recent first
+    size_t point_index = voxels[0].first_point;
+    REQUIRE( vec3_equal(&points[point_index], &p_3) );
+    point_index = next_points[point_index];
+    REQUIRE( vec3_equal(&points[point_index], &p_2) );
+    point_index = next_points[point_index];
+    REQUIRE( vec3_equal(&points[point_index], &p_1) );
+    REQUIRE( next_points[point_index] == VOXEL_GRID_NOT_FOUND );
+
+    // full arena of points: still counted in the centroid
+    Vec3 const p_4 {0.5, 0.5, 0.5};
+    voxel_grid_insert(&grid, &p_4);
+    voxel_grid_insert(&grid, &p_4);
+    REQUIRE( grid.nbr_points == 5 );
+    REQUIRE( voxels[0].count == 5 );
+
+    // full grid of voxels: dropped
+    Vec3 const far_1 {10.0, 0.0, 0.0};
+    Vec3 const far_2 {20.0, 0.0, 0.0};
+    Vec3 const far_3 {30.0, 0.0, 0.0};
+    REQUIRE( voxel_grid_insert(&grid, &far_1) == 2 );
+    REQUIRE( voxel_grid_insert(&grid, &far_2) == 3 );
+    REQUIRE( voxel_grid_insert(&grid, &far_3) == VOXEL_GRID_NOT_FOUND );
+    REQUIRE( voxel_grid_insert(&grid, &far_1) == 2 );
+
+    voxel_grid_clear(&grid);
+    REQUIRE( grid.nbr_voxels == 0 );
+    REQUIRE( grid.nbr_points == 0 );
+    REQUIRE( voxel_grid_insert(&grid, &far_3) == 0 );
+}
+
+TEST_CASE("voxel_grid_insert_batch, voxel_grid_downsample and voxel_grid_neighbours"){
+    // points on a helix, binned in voxels of 0.1
+    size_t const count {5000};
+    F_TYPE const voxel_size {0.1};
+    std::vector<Vec3> points(count);
+    for (size_t n = 0; n < count; n++){
+        F_TYPE x = static_cast<F_TYPE>(n) / static_cast<F_TYPE>(count);
+        points[n] = Vec3 {std::cos(20.0 * x), std::sin(20.0 * x), 2.0 * x - 1.0};
+    }
+
+    std::vector<Voxel> voxels(4096);
+    std::vector<size_t> slots(8192);
+    Voxel_Grid grid;
+    REQUIRE( voxel_grid_init(&grid, voxel_size, voxels.data(), voxels.size(), slots.data(), slots.size()) );
+
+    Vec3_View points_view;
+    vec3_view_of_array(&points_view, points.data(), count);
+    REQUIRE( voxel_grid_insert_batch(&grid, &points_view) == count );
+
+    // as many voxels as different coordinates
+    std::set<std::array<int64_t, 3>> all_coords;
+    for (Vec3 const & point : points){
+        std::array<int64_t, 3> coords;
+        voxel_grid_coords(&grid, &point, coords.data());
+        all_coords.insert(coords);
+    }
+    REQUIRE( grid.nbr_voxels == all_coords.size() );
+
+    // the centroids are in their voxels, and the counts add up
+    std::vector<Vec3> centroids(grid.nbr_voxels);
+    Vec3_View centroids_view;
+    vec3_view_of_array(&centroids_view, centroids.data(), centroids.size());
+    REQUIRE( voxel_grid_downsample(&grid, &centroids_view) == grid.nbr_voxels );
+
+    size_t nbr_mismatches {0};
+    size_t sum_counts {0};
+    for (size_t n = 0; n < grid.nbr_voxels; n++){
+        int64_t coords[3];
+        voxel_grid_coords(&grid, &centroids[n], coords);
+        if (voxel_grid_find(&grid, coords) != n){
+            nbr_mismatches++;
+        }
+        sum_counts += voxels[n].count;
+    }
+    REQUIRE( nbr_mismatches == 0 );
+    REQUIRE( sum_counts == count );
+
+    // neighbours of a point: its own voxel, and the existing ones around
+    size_t neighbours[VOXEL_GRID_NBR_NEIGHBOURS];
+    size_t nbr_neighbours = voxel_grid_neighbours(&grid, &points[100], neighbours);
+    REQUIRE( nbr_neighbours >= 2 );
+    REQUIRE( nbr_neighbours <= VOXEL_GRID_NBR_NEIGHBOURS );
+    int64_t own_coords[3];
+    voxel_grid_coords(&grid, &points[100], own_coords);
+    bool own_found {false};
+    for (size_t n = 0; n < nbr_neighbours; n++){
+        Voxel const & voxel = voxels[neighbours[n]];
+        int64_t distance = std::max({std::llabs(voxel.coords[0] - own_coords[0]), std::llabs(voxel.coords[1] - own_coords[1]), std::llabs(voxel.coords[2] - own_coords[2])});
+        if (distance > 1){
+            nbr_mismatches++;
+        }
+        if (distance == 0){
+            own_found = true;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+    REQUIRE( own_found );
+
+    Vec3 const far_away {50.0, 50.0, 50.0};
+    REQUIRE( voxel_grid_neighbours(&grid, &far_away, neighbours) == 0 );
+}
+
+TEST_CASE("voxel_grid_insert_transformed_batch"){
+    std::vector<Vec3> points;
+    for (size_t n = 0; n < 200; n++){
+        F_TYPE x = static_cast<F_TYPE>(n) / 200.0;
+        points.push_back(Vec3 {3.0 * x, std::sin(9.0 * x), 0.5});
+    }
+    Vec3_View points_view;
+    vec3_view_of_array(&points_view, points.data(), points.size());
+
+    Vec3 const axis {1.0, 1.0, 0.0};
+    Quat rotation;
+    rotation_to_quat(&rotation, &axis, 0.8);
+    Vec3 const translation {10.0, -2.0, 1.0};
+
+    std::vector<Voxel> voxels_1(256);
+    std::vector<Voxel> voxels_2(256);
+    std::vector<size_t> slots_1(512);
+    std::vector<size_t> slots_2(512);
+    Voxel_Grid grid_1;
+    Voxel_Grid grid_2;
+    REQUIRE( voxel_grid_init(&grid_1, 0.25, voxels_1.data(), voxels_1.size(), slots_1.data(), slots_1.size()) );
+    REQUIRE( voxel_grid_init(&grid_2, 0.25, voxels_2.data(), voxels_2.size(), slots_2.data(), slots_2.size()) );
+
+    REQUIRE( voxel_grid_insert_transformed_batch(&grid_1, &points_view, &rotation, &translation) == points.size() );
+
+    for (Vec3 const & point : points){
+        Vec3 transformed;
+        rotate_by_quat_R(&point, &rotation, &transformed);
+        vec3_add(&transformed, &translation);
+        voxel_grid_insert(&grid_2, &transformed);
+    }
+
+    REQUIRE( grid_1.nbr_voxels == grid_2.nbr_voxels );
+    size_t nbr_mismatches {0};
+    for (size_t n = 0; n < grid_1.nbr_voxels; n++){
+        if (!vec3_equal(&voxels_1[n].centroid, &voxels_2[n].centroid) || voxels_1[n].count != voxels_2[n].count){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+}
+
+TEST_CASE("voxel_grid, non finite and too large points"){
+    std::vector<Voxel> voxels(16);
+    std::vector<size_t> slots(32);
+    Voxel_Grid grid;
+    REQUIRE( voxel_grid_init(&grid, 0.5, voxels.data(), voxels.size(), slots.data(), slots.size()) );
+
+    // the NaN of a lidar "no return", infinities, and points beyond 2^62 voxels
+    F_TYPE const nan = std::numeric_limits<F_TYPE>::quiet_NaN();
+    F_TYPE const inf = std::numeric_limits<F_TYPE>::infinity();
+    F_TYPE const huge = std::numeric_limits<F_TYPE>::max();
+    std::vector<Vec3> points {
+        Vec3 {1.0, 1.0, 1.0},
+        Vec3 {nan, nan, nan},
+        Vec3 {1.0, nan, 1.0},
+        Vec3 {inf, 0.0, 0.0},
+        Vec3 {0.0, 0.0, -inf},
+        Vec3 {huge, 0.0, 0.0},
+        Vec3 {0.0, 3.0e18, 0.0},
+        Vec3 {1.2, 1.1, 1.0}
+    };
+
+    int64_t coords[3];
+    size_t nbr_mismatches {0};
+    for (size_t n = 1; n + 1 < points.size(); n++){
+        if (voxel_grid_coords(&grid, &points[n], coords) || voxel_grid_insert(&grid, &points[n]) != VOXEL_GRID_NOT_FOUND){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+    REQUIRE( grid.nbr_voxels == 0 );
+
+    Vec3_View points_view;
+    vec3_view_of_array(&points_view, points.data(), points.size());
+    REQUIRE( voxel_grid_insert_batch(&grid, &points_view) == 2 );
+    REQUIRE( grid.nbr_voxels == 1 );
+    REQUIRE( voxels[0].count == 2 );
+
+    Quat const identity {1.0, 0.0, 0.0, 0.0};
+    Vec3 const translation {0.0, 0.0, 0.0};
+    REQUIRE( voxel_grid_insert_transformed_batch(&grid, &points_view, &identity, &translation) == 2 );
+
+    // only finite centroids
+    std::vector<Vec3> centroids(16);
+    Vec3_View centroids_view;
+    vec3_view_of_array(&centroids_view, centroids.data(), centroids.size());
+    REQUIRE( voxel_grid_downsample(&grid, &centroids_view) == 1 );
+    REQUIRE( std::isfinite(centroids[0].i) );
+    REQUIRE( centroids[0].i == Approx(1.1) );
+
+    size_t neighbours[VOXEL_GRID_NBR_NEIGHBOURS];
+    for (size_t n = 1; n + 1 < points.size(); n++){
+        if (voxel_grid_neighbours(&grid, &points[n], neighbours) != 0){
+            nbr_mismatches++;
+        }
+    }
+    REQUIRE( nbr_mismatches == 0 );
+    REQUIRE( voxel_grid_neighbours(&grid, &points[0], neighbours) == 1 );
+}